@@ -319,6 +319,27 @@ main(int argc, char** argv) {
   startEventBase(
       allThreads, orderedEvbs, watchdog, "netlink", std::move(nlOpenrEvb));
 
+  // Create additional netlink sockets for route programming if specified.
+  // NOTE: These sockets don't subscribe to netlink events
+  std::vector<std::unique_ptr<openr::fbnl::NetlinkProtocolSocket>> nlRouteSocks;
+  if (config->isNetlinkFibHandlerEnabled()) {
+    for (int32_t i = 1; i < config->getNetlinkFibHandlerNumSockets(); ++i) {
+      auto nlRouteOpenrEvb = std::make_unique<OpenrEventBase>();
+      nlRouteSocks.emplace_back(
+          std::make_unique<openr::fbnl::NetlinkProtocolSocket>(
+              nlRouteOpenrEvb->getEvb(),
+              netlinkEventsQueue,
+              false /* enableIPv6RouteReplaceSemantics */,
+              false /* subscribeEvents */));
+      startEventBase(
+          allThreads,
+          orderedEvbs,
+          watchdog,
+          fmt::format("netlink-route-{}", i),
+          std::move(nlRouteOpenrEvb));
+    }
+  }
+
   // Start NetlinkFibHandler if specified
   if (config->isNetlinkFibHandlerEnabled()) {
     // Create ThreadManager for thrift services
@@ -335,10 +356,15 @@ main(int argc, char** argv) {
     netlinkFibServer->setCpp2WorkerThreadName("FibTWorker");
     netlinkFibServer->setPort(*config->getConfig().fib_port_ref());
 
-    netlinkFibServerThread =
-        std::make_unique<std::thread>([&netlinkFibServer, &nlSock]() {
+    netlinkFibServerThread = std::make_unique<std::thread>(
+        [&netlinkFibServer, &nlSock, &nlRouteSocks]() {
           folly::setThreadName("openr-fibService");
-          auto fibHandler = std::make_shared<NetlinkFibHandler>(nlSock.get());
+          std::vector<openr::fbnl::NetlinkProtocolSocket*> routeSocks;
+          for (auto& nlRouteSock : nlRouteSocks) {
+            routeSocks.emplace_back(nlRouteSock.get());
+          }
+          auto fibHandler =
+              std::make_shared<NetlinkFibHandler>(nlSock.get(), routeSocks);
           netlinkFibServer->setInterface(std::move(fibHandler));
 
           XLOG(INFO) << "Starting NetlinkFib server...";
@@ -631,6 +657,7 @@ main(int argc, char** argv) {
     thriftThreadMgr->stop();
   }
 
+  nlRouteSocks.clear();
   nlSock.reset();
 
   // Wait for all threads
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <glog/logging.h>
+
+#include <openr/common/FlapDampener.h>
+
+namespace openr {
+
+namespace {
+
+double
+getMaxPenalty(FlapDampener::Params const& params) {
+  return params.reuseThreshold *
+      std::exp2(
+             static_cast<double>(params.maxSuppressTime.count()) /
+             params.halfLife.count());
+}
+
+} // namespace
+
+FlapDampener::FlapDampener(Params const& params, NowFunc now)
+    : params_(params),
+      now_(std::move(now)),
+      maxPenalty_(getMaxPenalty(params)),
+      lastFlapTime_(now_()) {
+  CHECK_GT(params_.penaltyPerFlap, 0);
+  CHECK_GT(params_.reuseThreshold, 0);
+  CHECK_LT(params_.reuseThreshold, params_.suppressThreshold);
+  CHECK_GT(params_.halfLife.count(), 0);
+  CHECK_GT(params_.maxSuppressTime.count(), 0);
+}
+
+bool
+FlapDampener::reportFlap() {
+  const bool wasSuppressed = isSuppressed();
+
+  penalty_ = std::min(getPenalty() + params_.penaltyPerFlap, maxPenalty_);
+  lastFlapTime_ = now_();
+  suppressed_ = wasSuppressed or penalty_ > params_.suppressThreshold;
+  ++numFlaps_;
+
+  if (suppressed_ and not wasSuppressed) {
+    ++numSuppressions_;
+    return true;
+  }
+  return false;
+}
+
+double
+FlapDampener::getPenalty() const {
+  if (penalty_ == 0) {
+    return 0;
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      now_() - lastFlapTime_);
+  return penalty_ *
+      std::exp2(
+             -static_cast<double>(elapsed.count()) / params_.halfLife.count());
+}
+
+bool
+FlapDampener::isSuppressed() const {
+  // NOTE: penalty only decays in between flaps. Once it has decayed to the
+  // reuse threshold, object stays reusable until the next flap.
+  return suppressed_ and getPenalty() > params_.reuseThreshold;
+}
+
+std::chrono::milliseconds
+FlapDampener::getTimeUntilReuse() const {
+  if (not isSuppressed()) {
+    return std::chrono::milliseconds(0);
+  }
+
+  // penalty * 2 ^ (-t / halfLife) = reuseThreshold
+  const double remainingMs = params_.halfLife.count() *
+      std::log2(getPenalty() / params_.reuseThreshold);
+  return std::chrono::milliseconds(
+      static_cast<int64_t>(std::ceil(remainingMs)));
+}
+
+bool
+FlapDampener::canForget() const {
+  return not isSuppressed() and getPenalty() < params_.reuseThreshold / 2.0;
+}
+
+} // namespace openr
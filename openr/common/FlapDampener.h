@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace openr {
+
+/**
+ * Penalty based flap dampening, modeled after BGP route flap dampening
+ * (RFC 2439), for interfaces and adjacencies.
+ *
+ * Every flap adds `penaltyPerFlap` to the figure of merit (penalty), which
+ * decays exponentially with `halfLife`. Once penalty exceeds
+ * `suppressThreshold` the object is suppressed, and it stays suppressed until
+ * penalty decays below `reuseThreshold`. Penalty is capped at
+ * `reuseThreshold * 2 ^ (maxSuppressTime / halfLife)` so that an object is
+ * never suppressed longer than `maxSuppressTime` after its last flap.
+ *
+ * Decay is computed lazily on access, hence dampener does not need any timer
+ * of its own. Owner is expected to schedule re-evaluation after
+ * `getTimeUntilReuse()`. A custom `now` function allows tests to replay flap
+ * traces with a virtual clock.
+ */
+class FlapDampener final {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using NowFunc = std::function<Clock::time_point()>;
+
+  struct Params {
+    uint32_t penaltyPerFlap{1000};
+    uint32_t suppressThreshold{2000};
+    uint32_t reuseThreshold{750};
+    std::chrono::milliseconds halfLife{15000};
+    std::chrono::milliseconds maxSuppressTime{60000};
+  };
+
+  /**
+   * @param params  Dampening parameters. Thresholds must be positive and
+   *                `reuseThreshold` must be lower than `suppressThreshold`.
+   * @param now     Function returning current time.
+   */
+  explicit FlapDampener(Params const& params, NowFunc now = Clock::now);
+
+  /**
+   * Record a flap. Returns true if object transitioned into suppressed state
+   * because of this flap.
+   */
+  bool reportFlap();
+
+  /**
+   * Get current (decayed) penalty
+   */
+  double getPenalty() const;
+
+  /**
+   * Is object suppressed at this moment
+   */
+  bool isSuppressed() const;
+
+  /**
+   * Get time remaining until suppressed object can be reused. Returns zero if
+   * object is not suppressed.
+   */
+  std::chrono::milliseconds getTimeUntilReuse() const;
+
+  /**
+   * Penalty has decayed enough that all history can be forgotten. Same as in
+   * RFC 2439, this is when penalty drops below half of the reuse threshold.
+   */
+  bool canForget() const;
+
+  /**
+   * Total number of flaps reported
+   */
+  uint64_t
+  getNumFlaps() const {
+    return numFlaps_;
+  }
+
+  /**
+   * Number of times object transitioned into suppressed state
+   */
+  uint64_t
+  getNumSuppressions() const {
+    return numSuppressions_;
+  }
+
+  Params const&
+  getParams() const {
+    return params_;
+  }
+
+ private:
+  const Params params_;
+
+  const NowFunc now_;
+
+  // Ceiling of penalty, derived from `maxSuppressTime`
+  const double maxPenalty_{0};
+
+  // Penalty at the time of last flap. Current penalty is derived from it.
+  double penalty_{0};
+  Clock::time_point lastFlapTime_;
+
+  // Suppressed state as of last flap. Current state is derived from it.
+  bool suppressed_{false};
+
+  uint64_t numFlaps_{0};
+  uint64_t numSuppressions_{0};
+};
+
+} // namespace openr
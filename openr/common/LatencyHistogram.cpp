@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <fb303/ServiceData.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/common/LatencyHistogram.h>
+
+namespace fb303 = facebook::fb303;
+
+namespace openr {
+
+namespace {
+
+// Nearest-rank percentile on sorted samples
+int64_t
+getPercentileSorted(const std::vector<int64_t>& sorted, double percentile) {
+  const size_t rank = static_cast<size_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+  return sorted.at(std::max<size_t>(rank, 1) - 1);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(size_t windowSize)
+    : maxWindowSize_(windowSize) {
+  XCHECK_GT(maxWindowSize_, 0) << "Window size must be positive";
+  samples_.reserve(maxWindowSize_);
+}
+
+void
+LatencyHistogram::addValue(int64_t value) {
+  ++count_;
+  if (samples_.size() < maxWindowSize_) {
+    samples_.emplace_back(value);
+    return;
+  }
+  samples_[nextIndex_] = value;
+  nextIndex_ = (nextIndex_ + 1) % maxWindowSize_;
+}
+
+LatencyHistogram::Percentiles
+LatencyHistogram::getPercentiles() const {
+  Percentiles percentiles;
+  if (samples_.empty()) {
+    return percentiles;
+  }
+
+  auto sorted = samples_;
+  std::sort(sorted.begin(), sorted.end());
+  percentiles.p50 = getPercentileSorted(sorted, 50);
+  percentiles.p99 = getPercentileSorted(sorted, 99);
+  percentiles.p999 = getPercentileSorted(sorted, 99.9);
+  percentiles.max = sorted.back();
+  return percentiles;
+}
+
+void
+LatencyHistogram::exportCounters(const std::string& key) const {
+  const auto percentiles = getPercentiles();
+  fb303::fbData->setCounter(key + ".p50", percentiles.p50);
+  fb303::fbData->setCounter(key + ".p99", percentiles.p99);
+  fb303::fbData->setCounter(key + ".p999", percentiles.p999);
+  fb303::fbData->setCounter(key + ".max", percentiles.max);
+  fb303::fbData->setCounter(key + ".errors", numErrors_);
+}
+
+} // namespace openr
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace openr {
+
+/**
+ * Latency distribution over a rolling window of most recent samples. Used for
+ * reporting tail latencies (p50/p99/p999) of a stage, e.g. route programming
+ * in Fib or netlink request acknowledgement.
+ *
+ * Recording a sample is O(1). Percentiles are computed on demand by sorting a
+ * copy of the window, hence must be queried/exported once per batch of
+ * samples and not per sample.
+ *
+ * NOTE: This class is not thread-safe.
+ */
+class LatencyHistogram {
+ public:
+  // Default number of most recent samples to compute percentiles over
+  static constexpr size_t kDefaultWindowSize{1024};
+
+  struct Percentiles {
+    int64_t p50{0};
+    int64_t p99{0};
+    int64_t p999{0};
+    int64_t max{0};
+  };
+
+  explicit LatencyHistogram(size_t windowSize = kDefaultWindowSize);
+
+  /**
+   * Record latency sample
+   */
+  void addValue(int64_t value);
+
+  /**
+   * Record an error of the stage being tracked
+   */
+  void
+  addError() {
+    ++numErrors_;
+  }
+
+  /**
+   * Compute percentiles over the samples in current window. Returns all zeros
+   * if no sample has been recorded yet.
+   */
+  Percentiles getPercentiles() const;
+
+  /**
+   * Export percentiles of current window as fb303 counters, named as
+   * `<key>.p50`, `<key>.p99`, `<key>.p999` and `<key>.max`. Error count is
+   * exported as `<key>.errors`.
+   */
+  void exportCounters(const std::string& key) const;
+
+  // Total number of samples recorded
+  int64_t
+  getCount() const {
+    return count_;
+  }
+
+  // Total number of errors recorded
+  int64_t
+  getNumErrors() const {
+    return numErrors_;
+  }
+
+  // Number of samples in current window
+  size_t
+  getWindowSize() const {
+    return samples_.size();
+  }
+
+ private:
+  // Maximum number of samples retained
+  const size_t maxWindowSize_{kDefaultWindowSize};
+
+  // Circular buffer of most recent samples
+  std::vector<int64_t> samples_;
+
+  // Index in `samples_` to be overwritten by next sample once buffer is full
+  size_t nextIndex_{0};
+
+  int64_t count_{0};
+  int64_t numErrors_{0};
+};
+
+} // namespace openr
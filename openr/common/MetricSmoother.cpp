@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <glog/logging.h>
+
+#include <openr/common/MetricSmoother.h>
+
+namespace openr {
+
+MetricSmoother::MetricSmoother(
+    Params const& params, int64_t initialValue, NowFunc now)
+    : params_(params),
+      now_(std::move(now)),
+      smoothedValue_(initialValue),
+      lastUpdateTime_(now_()) {
+  CHECK_GT(params_.ewmaWeightPct, 0);
+  CHECK_LE(params_.ewmaWeightPct, 100);
+  CHECK_GT(params_.quantizationBand, 0);
+  update();
+}
+
+MetricSmoother::Result
+MetricSmoother::addSample(int64_t value) {
+  const double weight = params_.ewmaWeightPct / 100.0;
+  smoothedValue_ = weight * value + (1 - weight) * smoothedValue_;
+
+  if (not isOutOfBand()) {
+    // Smoothed value is back within band. Drop deferred change if any.
+    hasPendingUpdate_ = false;
+    return Result::SUPPRESSED;
+  }
+
+  if (now_() - lastUpdateTime_ < params_.minHoldTime) {
+    hasPendingUpdate_ = true;
+    return Result::DEFERRED;
+  }
+
+  update();
+  return Result::UPDATED;
+}
+
+bool
+MetricSmoother::applyPendingUpdate() {
+  if (not hasPendingUpdate_ or getTimeUntilUpdate().count() > 0) {
+    return false;
+  }
+
+  if (not isOutOfBand()) {
+    hasPendingUpdate_ = false;
+    return false;
+  }
+
+  update();
+  return true;
+}
+
+std::chrono::milliseconds
+MetricSmoother::getTimeUntilUpdate() const {
+  if (not hasPendingUpdate_) {
+    return std::chrono::milliseconds(0);
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      now_() - lastUpdateTime_);
+  return std::max(
+      std::chrono::milliseconds(0), params_.minHoldTime - elapsed);
+}
+
+bool
+MetricSmoother::isOutOfBand() const {
+  return std::abs(smoothedValue_ - value_) >= params_.quantizationBand;
+}
+
+void
+MetricSmoother::update() {
+  const auto band = params_.quantizationBand;
+  value_ = std::llround(smoothedValue_ / band) * band;
+  lastUpdateTime_ = now_();
+  hasPendingUpdate_ = false;
+}
+
+} // namespace openr
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace openr {
+
+/**
+ * Smooths a noisy measurement, e.g. RTT of an adjacency, before it is turned
+ * into an advertised metric. Each change of advertised metric costs a
+ * network-wide flood and route computation, hence only significant and
+ * sustained changes are let through.
+ *
+ * Smoothing is a pipeline of three stages:
+ * 1) EWMA: every sample is blended into the smoothed value with weight
+ *    `ewmaWeightPct` (100 disables averaging).
+ * 2) Quantization band: advertised value is a multiple of `quantizationBand`,
+ *    and is only changed once smoothed value moves at least one full band
+ *    away from it. This adds hysteresis around band boundaries.
+ * 3) Hold time: advertised value is changed at most once per `minHoldTime`.
+ *    Change within hold time is deferred. Owner is expected to call
+ *    `applyPendingUpdate()` after `getTimeUntilUpdate()`, at which point the
+ *    change is re-evaluated against the latest smoothed value.
+ */
+class MetricSmoother final {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using NowFunc = std::function<Clock::time_point()>;
+
+  struct Params {
+    uint32_t ewmaWeightPct{100};
+    int64_t quantizationBand{1};
+    std::chrono::milliseconds minHoldTime{0};
+  };
+
+  enum class Result {
+    // Advertised value has changed
+    UPDATED,
+    // Change is within quantization band of advertised value
+    SUPPRESSED,
+    // Change is deferred till end of hold time
+    DEFERRED,
+  };
+
+  /**
+   * @param params        Smoothing parameters. EWMA weight must be within
+   *                      (0, 100] and quantization band must be positive.
+   * @param initialValue  Initial measurement. It is advertised quantized and
+   *                      starts the hold time.
+   * @param now           Function returning current time.
+   */
+  MetricSmoother(
+      Params const& params, int64_t initialValue, NowFunc now = Clock::now);
+
+  /**
+   * Feed a new measurement
+   */
+  Result addSample(int64_t value);
+
+  /**
+   * Apply deferred change if hold time has passed and smoothed value is still
+   * out of band. Returns true if advertised value has changed.
+   */
+  bool applyPendingUpdate();
+
+  /**
+   * Time remaining until deferred change can be applied. Returns zero if
+   * there is no deferred change.
+   */
+  std::chrono::milliseconds getTimeUntilUpdate() const;
+
+  bool
+  hasPendingUpdate() const {
+    return hasPendingUpdate_;
+  }
+
+  /**
+   * Value to advertise
+   */
+  int64_t
+  getValue() const {
+    return value_;
+  }
+
+  double
+  getSmoothedValue() const {
+    return smoothedValue_;
+  }
+
+ private:
+  // Is smoothed value out of quantization band of advertised value
+  bool isOutOfBand() const;
+
+  // Advertise quantized smoothed value
+  void update();
+
+  Params params_;
+
+  NowFunc now_;
+
+  double smoothedValue_{0};
+
+  int64_t value_{0};
+
+  Clock::time_point lastUpdateTime_;
+
+  bool hasPendingUpdate_{false};
+};
+
+} // namespace openr
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <folly/IPAddress.h>
+
+namespace openr {
+
+/*
+ * Binary trie of IP networks, one per address family. Every network is stored
+ * at the node reached by walking its first `cidr` bits. This allows to find
+ * all networks containing an address with single walk along its bits, i.e.
+ * O(address length) regardless of number of stored networks.
+ */
+template <typename T>
+class PrefixTrie {
+ public:
+  /*
+   * Insert network with value, or replace value of existing network. Return
+   * true if network is newly inserted.
+   */
+  bool
+  insert(const folly::CIDRNetwork& network, T value) {
+    auto* node = &getRoot(network.first);
+    for (size_t i = 0; i < network.second; ++i) {
+      auto& child = node->children.at(network.first.getNthMSBit(i));
+      if (not child) {
+        child = std::make_unique<Node>();
+      }
+      node = child.get();
+    }
+    const bool inserted = not node->entry.has_value();
+    node->entry = std::make_pair(network, std::move(value));
+    size_ += inserted ? 1 : 0;
+    return inserted;
+  }
+
+  /*
+   * Erase network. Nodes left without any network underneath are pruned.
+   * Return true if network existed.
+   */
+  bool
+  erase(const folly::CIDRNetwork& network) {
+    std::vector<Node*> path{&getRoot(network.first)};
+    for (size_t i = 0; i < network.second; ++i) {
+      auto& child = path.back()->children.at(network.first.getNthMSBit(i));
+      if (not child) {
+        return false;
+      }
+      path.emplace_back(child.get());
+    }
+    if (not path.back()->entry.has_value()) {
+      return false;
+    }
+    path.back()->entry.reset();
+    --size_;
+
+    for (size_t i = network.second; i > 0; --i) {
+      const auto* node = path.at(i);
+      if (node->entry.has_value() or node->children[0] or node->children[1]) {
+        break;
+      }
+      path.at(i - 1)->children.at(network.first.getNthMSBit(i - 1)).reset();
+    }
+    return true;
+  }
+
+  // Return value of the exact network if it exists
+  T*
+  get(const folly::CIDRNetwork& network) {
+    auto* node = &getRoot(network.first);
+    for (size_t i = 0; node and i < network.second; ++i) {
+      node = node->children.at(network.first.getNthMSBit(i)).get();
+    }
+    if (not node or not node->entry.has_value()) {
+      return nullptr;
+    }
+    return &node->entry->second;
+  }
+
+  /*
+   * Invoke `fn(network, value)` for every network containing the address,
+   * from least to most specific one.
+   */
+  template <typename Fn>
+  void
+  forEachCovering(const folly::IPAddress& addr, Fn&& fn) {
+    auto* node = &getRoot(addr);
+    for (size_t i = 0; node; ++i) {
+      if (node->entry.has_value()) {
+        fn(node->entry->first, node->entry->second);
+      }
+      if (i == addr.bitCount()) {
+        break;
+      }
+      node = node->children.at(addr.getNthMSBit(i)).get();
+    }
+  }
+
+  size_t
+  size() const {
+    return size_;
+  }
+
+  bool
+  empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  struct Node {
+    std::array<std::unique_ptr<Node>, 2> children;
+    std::optional<std::pair<folly::CIDRNetwork, T>> entry;
+  };
+
+  Node&
+  getRoot(const folly::IPAddress& addr) {
+    return addr.isV4() ? v4Root_ : v6Root_;
+  }
+
+  Node v4Root_;
+  Node v6Root_;
+  size_t size_{0};
+};
+
+} // namespace openr
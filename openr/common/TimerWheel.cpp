@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <limits>
+
+#include <folly/Bits.h>
+#include <glog/logging.h>
+
+#include <openr/common/TimerWheel.h>
+
+namespace openr {
+
+TimerWheel::Timer::Timer(TimerWheel& wheel, std::function<void()> callback)
+    : wheel_(wheel),
+      callback_(
+          std::make_shared<const std::function<void()>>(std::move(callback))) {
+}
+
+TimerWheel::Timer::~Timer() {
+  cancelTimeout();
+}
+
+void
+TimerWheel::Timer::scheduleTimeout(std::chrono::milliseconds timeout) {
+  cancelTimeout();
+  wheel_.schedule(*this, timeout);
+}
+
+void
+TimerWheel::Timer::cancelTimeout() {
+  if (isScheduled()) {
+    wheel_.cancel(*this);
+  }
+}
+
+TimerWheel::TimerWheel(
+    folly::EventBase* evb,
+    std::chrono::milliseconds tickInterval,
+    size_t numSlots,
+    NowFunc now)
+    : tickInterval_(tickInterval),
+      now_(std::move(now)),
+      startTime_(now_()),
+      slots_(folly::nextPowTwo(numSlots)),
+      slotMask_(slots_.size() - 1) {
+  CHECK(tickInterval_ > std::chrono::milliseconds(0))
+      << "Tick interval can't be 0";
+  CHECK_GT(numSlots, 0) << "Number of slots can't be 0";
+
+  if (evb) {
+    tickTimeout_ = folly::AsyncTimeout::make(*evb, [this]() noexcept {
+      ++numTicks_;
+      advance();
+    });
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  // Unlink pending timers, so that they don't refer to wheel on destruction
+  for (auto& slot : slots_) {
+    slot.clear();
+  }
+}
+
+std::unique_ptr<TimerWheel::Timer>
+TimerWheel::makeTimer(std::function<void()> callback) {
+  return std::unique_ptr<Timer>(new Timer(*this, std::move(callback)));
+}
+
+int64_t
+TimerWheel::getCurrentTick() const {
+  return (now_() - startTime_) / tickInterval_;
+}
+
+void
+TimerWheel::schedule(Timer& timer, std::chrono::milliseconds timeout) {
+  // Round up, so that timer never fires early
+  const auto expireTime = now_() - startTime_ + timeout;
+  timer.expireTick_ = std::max<int64_t>(
+      (expireTime + tickInterval_ - Clock::duration(1)) / tickInterval_,
+      lastTick_ + 1);
+
+  slots_[timer.expireTick_ & slotMask_].push_back(timer);
+  ++numScheduled_;
+  maybeScheduleTick(timer.expireTick_);
+}
+
+void
+TimerWheel::cancel(Timer& timer) {
+  timer.hook_.unlink();
+  --numScheduled_;
+  if (tickTimeout_ and numScheduled_ == 0) {
+    tickTimeout_->cancelTimeout();
+  }
+}
+
+void
+TimerWheel::advance() {
+  const auto currentTick = getCurrentTick();
+
+  // Collect due timers first, as callbacks may arm or cancel other timers.
+  // Each slot needs to be visited at most once.
+  TimerList expired;
+  const auto numTicks =
+      std::min<int64_t>(currentTick - lastTick_, slots_.size());
+  for (int64_t i = 1; i <= numTicks; ++i) {
+    auto& slot = slots_[(lastTick_ + i) & slotMask_];
+    for (auto it = slot.begin(); it != slot.end();) {
+      auto& timer = *it;
+      if (timer.expireTick_ > currentTick) {
+        ++it;
+        continue;
+      }
+      it = slot.erase(it);
+      expired.push_back(timer);
+    }
+  }
+  lastTick_ = std::max(lastTick_, currentTick);
+
+  // NOTE: timer is unlinked before invoking its callback, so that callback
+  // can re-arm or destroy it. Pending expired timers destroyed by callbacks
+  // unlink themselves from the list.
+  while (not expired.empty()) {
+    auto& timer = expired.front();
+    expired.pop_front();
+    --numScheduled_;
+    auto callback = timer.callback_;
+    (*callback)();
+  }
+
+  if (tickTimeout_ and numScheduled_) {
+    maybeScheduleTick(getNextExpireTick());
+  }
+}
+
+int64_t
+TimerWheel::getNextExpireTick() const {
+  // All pending timers expire after `lastTick_`. Visiting slots in tick order,
+  // the first timer expiring within this revolution is the earliest one.
+  // Otherwise all timers are visited and the earliest of them is returned.
+  int64_t nextTick = std::numeric_limits<int64_t>::max();
+  for (int64_t tick = lastTick_ + 1;
+       tick <= lastTick_ + static_cast<int64_t>(slots_.size());
+       ++tick) {
+    for (auto const& timer : slots_[tick & slotMask_]) {
+      nextTick = std::min(nextTick, timer.expireTick_);
+    }
+    if (nextTick == tick) {
+      break;
+    }
+  }
+  return nextTick;
+}
+
+void
+TimerWheel::maybeScheduleTick(int64_t tick) {
+  if (not tickTimeout_ or
+      (tickTimeout_->isScheduled() and scheduledTick_ <= tick)) {
+    return;
+  }
+
+  // Round up, so that tick timeout never fires before the tick
+  const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(
+      startTime_ + tick * tickInterval_ - now_());
+  tickTimeout_->scheduleTimeout(
+      std::max(timeout, std::chrono::milliseconds(0)));
+  scheduledTick_ = tick;
+}
+
+} // namespace openr
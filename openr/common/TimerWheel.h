@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <folly/IntrusiveList.h>
+#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/EventBase.h>
+
+namespace openr {
+
+/**
+ * Hashed timer wheel to drive large number of timers, e.g. per neighbor and
+ * per interface timers of Spark, with O(1) arm and cancel.
+ *
+ * Time is divided into ticks of `tickInterval`. A timer expiring at tick `t`
+ * is kept in slot `t % numSlots`. On every tick, only the slot of that tick
+ * is visited and timers which are due are fired. Timers which are more than
+ * one revolution away stay in their slot until due. Timers never fire early,
+ * but may fire up to one tick late.
+ *
+ * The wheel is driven by a single AsyncTimeout on the given EventBase, which
+ * is only scheduled while there are pending timers. It is scheduled for the
+ * tick of the earliest pending timer, instead of every tick, so that an idle
+ * thread with long timers only wakes up when they are due. Finding it scans
+ * the slots, which is only done when the tick fires. If no EventBase is given,
+ * the owner must call `advance()`. Together with a custom `now` function this
+ * allows tests to drive timers with a virtual clock.
+ *
+ * NOTE: Not thread-safe. All timers must be armed, cancelled and destroyed in
+ * the thread driving the wheel. Wheel must outlive its timers.
+ */
+class TimerWheel final {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using NowFunc = std::function<Clock::time_point()>;
+
+  static constexpr size_t kDefaultNumSlots{512};
+
+  class Timer final {
+   public:
+    ~Timer();
+
+    // Timer is non-copyable
+    Timer(Timer const&) = delete;
+    Timer& operator=(Timer const&) = delete;
+
+    // (Re)schedule timer to fire after `timeout`
+    void scheduleTimeout(std::chrono::milliseconds timeout);
+
+    void cancelTimeout();
+
+    bool
+    isScheduled() const {
+      return hook_.is_linked();
+    }
+
+   private:
+    friend class TimerWheel;
+
+    Timer(TimerWheel& wheel, std::function<void()> callback);
+
+    TimerWheel& wheel_;
+
+    // NOTE: shared so that callback survives destruction of the timer from
+    // within the callback itself
+    const std::shared_ptr<const std::function<void()>> callback_;
+
+    // Tick at which timer expires
+    int64_t expireTick_{0};
+
+    // Links timer into its slot
+    folly::IntrusiveListHook hook_;
+  };
+
+  TimerWheel(
+      folly::EventBase* evb,
+      std::chrono::milliseconds tickInterval,
+      size_t numSlots = kDefaultNumSlots,
+      NowFunc now = Clock::now);
+
+  ~TimerWheel();
+
+  // TimerWheel is non-copyable
+  TimerWheel(TimerWheel const&) = delete;
+  TimerWheel& operator=(TimerWheel const&) = delete;
+
+  // Create timer driven by this wheel. Timer is not scheduled.
+  std::unique_ptr<Timer> makeTimer(std::function<void()> callback);
+
+  // Fire all timers which are due as of now. Invoked on every tick if driven
+  // by EventBase.
+  void advance();
+
+  size_t
+  getNumScheduled() const {
+    return numScheduled_;
+  }
+
+  // Number of times the wheel has been driven by EventBase
+  size_t
+  getNumTicks() const {
+    return numTicks_;
+  }
+
+ private:
+  using TimerList = folly::IntrusiveList<Timer, &Timer::hook_>;
+
+  void schedule(Timer& timer, std::chrono::milliseconds timeout);
+
+  void cancel(Timer& timer);
+
+  // Current tick as per clock, rounded down
+  int64_t getCurrentTick() const;
+
+  // Earliest tick at which a pending timer expires. Must only be called if
+  // there are pending timers.
+  int64_t getNextExpireTick() const;
+
+  // Schedule tick timeout for given tick, unless it is already scheduled for
+  // an earlier one
+  void maybeScheduleTick(int64_t tick);
+
+  const std::chrono::milliseconds tickInterval_{0};
+
+  const NowFunc now_;
+
+  const Clock::time_point startTime_;
+
+  // Slot of timers per tick. Size is a power of 2.
+  std::vector<TimerList> slots_;
+
+  const size_t slotMask_{0};
+
+  // Last tick for which due timers have been fired
+  int64_t lastTick_{0};
+
+  size_t numScheduled_{0};
+
+  // Drives the wheel. Only set if EventBase is given.
+  std::unique_ptr<folly::AsyncTimeout> tickTimeout_{nullptr};
+
+  // Tick for which `tickTimeout_` is scheduled
+  int64_t scheduledTick_{0};
+
+  size_t numTicks_{0};
+};
+
+} // namespace openr
@@ -6,6 +6,7 @@
  */
 
 #include <fmt/core.h>
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 
 #include <openr/common/NetworkUtil.h>
@@ -56,6 +57,28 @@ PrefixKey::PrefixKey(
           prefix_.first.str(),
           prefix_.second)) {}
 
+std::string
+PrefixKey::getPrefixBucketKey(std::string const& node, size_t bucket) {
+  return fmt::format(
+      "{}{}:#{}", Constants::kPrefixDbMarker.toString(), node, bucket);
+}
+
+bool
+PrefixKey::isPrefixBucketKey(std::string const& key) {
+  return key.find(Constants::kPrefixDbMarker.toString()) == 0 and
+      key.find(":#") != std::string::npos;
+}
+
+size_t
+PrefixKey::getPrefixBucket(
+    folly::CIDRNetwork const& prefix, size_t numBuckets) {
+  CHECK_GT(numBuckets, 0);
+  auto hash =
+      folly::hash::fnv64_buf(prefix.first.bytes(), prefix.first.byteCount());
+  hash = folly::hash::fnv64_buf(&prefix.second, sizeof(prefix.second), hash);
+  return hash % numBuckets;
+}
+
 folly::Expected<PrefixKey, std::string>
 PrefixKey::fromStr(const std::string& key, const std::string& areaIn) {
   bool isV2PrefixKey{false};
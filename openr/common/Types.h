@@ -14,6 +14,7 @@
 #include <fmt/core.h>
 #include <folly/Expected.h>
 #include <folly/IPAddress.h>
+#include <folly/sorted_vector_types.h>
 #include <re2/re2.h>
 #include <re2/set.h>
 
@@ -29,8 +30,10 @@ namespace openr {
 // Aliases for data-structures
 //
 using NodeAndArea = std::pair<std::string, std::string>;
-using PrefixEntries =
-    std::unordered_map<NodeAndArea, std::shared_ptr<thrift::PrefixEntry>>;
+// Prefix is announced by a handful of [node, area] only. Keep its entries in
+// single contiguous (sorted) allocation instead of node per announcement.
+using PrefixEntries = folly::
+    sorted_vector_map<NodeAndArea, std::shared_ptr<thrift::PrefixEntry>>;
 
 // KvStore URLs
 BOOST_STRONG_TYPEDEF(std::string, KvStoreGlobalCmdUrl);
@@ -127,6 +130,27 @@ enum class PrefixEventType {
    * same list of prefixes twice for SYNC will result in no updates second time.
    */
   SYNC_PREFIXES_BY_TYPE = 4,
+
+  /**
+   * Stage listed prefixes of specified type for the following
+   * COMMIT_PREFIXES_BY_TYPE. Nothing is advertised, withdrawn or reported as
+   * originated until commit. This allows to stream large set of prefixes in
+   * chunks.
+   */
+  STAGE_PREFIXES_BY_TYPE = 5,
+
+  /**
+   * Replace existing prefixes of specified type with staged (and listed)
+   * prefixes in one go, same as SYNC_PREFIXES_BY_TYPE does. Origination policy
+   * is applied on commit.
+   */
+  COMMIT_PREFIXES_BY_TYPE = 6,
+
+  /**
+   * Discard staged prefixes of specified type, e.g. when producer fails in the
+   * middle of streaming them. Existing prefixes of the type are kept as is.
+   */
+  ABORT_STAGED_PREFIXES_BY_TYPE = 7,
 };
 
 struct TtlCountdownQueueEntry {
@@ -610,6 +634,23 @@ class PrefixKey {
       const std::string& key,
       const std::string& area = Constants::kDefaultArea.toString());
 
+  /*
+   * Key of PrefixDatabase holding a bucket of prefixes advertised by node,
+   * e.g. "prefix:node1:#17". Used when prefixes are packed into a bounded
+   * number of keys. See OpenrConfig.prefix_db_key_buckets.
+   */
+  static std::string getPrefixBucketKey(std::string const& node, size_t bucket);
+
+  // Return true if key is a prefix bucket key
+  static bool isPrefixBucketKey(std::string const& key);
+
+  /*
+   * Bucket of the prefix among `numBuckets`. It only depends on the prefix
+   * itself, hence is stable across restarts and nodes.
+   */
+  static size_t getPrefixBucket(
+      folly::CIDRNetwork const& prefix, size_t numBuckets);
+
   static const RE2&
   getPrefixRE2V2() {
     static const RE2 prefixKeyPatternV2{fmt::format(
@@ -987,6 +987,38 @@ getNodeNameFromKey(const std::string& key) {
   return split[1];
 }
 
+std::string
+getAdjacencyKey(
+    const std::string& nodeName,
+    const std::string& otherNodeName,
+    const std::string& ifName) {
+  const auto separator = Constants::kPrefixNameSeparator.toString();
+  return Constants::kAdjDbMarker.toString() + nodeName + separator +
+      otherNodeName + separator + ifName;
+}
+
+std::optional<std::pair<std::string, std::string>>
+parseAdjacencyKey(const std::string& key) {
+  const folly::StringPiece marker = Constants::kAdjDbMarker;
+  const folly::StringPiece separator = Constants::kPrefixNameSeparator;
+  if (not folly::StringPiece(key).startsWith(marker)) {
+    return std::nullopt;
+  }
+
+  // Skip node name and extract other node name
+  const auto nodeEnd = key.find(separator.data(), marker.size(), 1);
+  if (nodeEnd == std::string::npos) {
+    return std::nullopt;
+  }
+  const auto otherNodeEnd = key.find(separator.data(), nodeEnd + 1, 1);
+  if (otherNodeEnd == std::string::npos or otherNodeEnd + 1 == key.size()) {
+    return std::nullopt;
+  }
+  return std::make_pair(
+      key.substr(nodeEnd + 1, otherNodeEnd - nodeEnd - 1),
+      key.substr(otherNodeEnd + 1));
+}
+
 NodeAndArea
 selectBestNodeArea(
     std::set<NodeAndArea> const& allNodeAreas, std::string const& myNodeName) {
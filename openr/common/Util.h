@@ -442,6 +442,23 @@ std::vector<thrift::MplsRoute> createMplsRoutesFromMap(
 
 std::string getNodeNameFromKey(const std::string& key);
 
+/**
+ * Per adjacency KvStore key `adj:<nodeName>:<otherNodeName>:<ifName>`. Node
+ * names can't contain separator, hence interface name is everything after
+ * the third separator.
+ */
+std::string getAdjacencyKey(
+    const std::string& nodeName,
+    const std::string& otherNodeName,
+    const std::string& ifName);
+
+/**
+ * Parse <otherNodeName, ifName> out of per adjacency key. Returns
+ * std::nullopt if key is not a per adjacency key, e.g. `adj:<nodeName>`.
+ */
+std::optional<std::pair<std::string, std::string>> parseAdjacencyKey(
+    const std::string& key);
+
 /**
  * Implements Open/R best route selection based on `thrift::PrefixMetrics`. The
  * metrics are compared and keys representing the best metric are returned. It
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <optional>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/FlapDampener.h>
+
+namespace chrono = std::chrono;
+
+namespace openr {
+
+namespace {
+
+// Interface goes DOWN at `time` and comes back UP after `downFor`
+struct Flap {
+  chrono::milliseconds time;
+  chrono::milliseconds downFor;
+};
+
+// Outcome of replaying a flap trace
+struct ReplayResult {
+  // Number of UP/DOWN transitions advertised to the rest of the network
+  size_t churn{0};
+  // Whether link is advertised UP at the end of replay
+  bool isAdvertisedUp{false};
+  // Time link stayed suppressed after the last event of the trace
+  chrono::milliseconds suppressedAfterTrace{0};
+};
+
+} // namespace
+
+/**
+ * Drives dampener with virtual clock, so that tests are deterministic and
+ * recorded flap traces spanning several minutes are replayed instantly.
+ */
+class FlapDampenerFixture : public ::testing::Test {
+ protected:
+  FlapDampener
+  makeDampener() {
+    return FlapDampener(params_, [this]() { return now_; });
+  }
+
+  void
+  advanceTime(chrono::milliseconds duration) {
+    now_ += duration;
+  }
+
+  /**
+   * Replay flap trace of a link and count UP/DOWN transitions which would be
+   * advertised, with or without dampening. Advertised state is UP only if
+   * link is UP and not suppressed. It is re-evaluated on every link event and
+   * at the end of suppression.
+   */
+  ReplayResult
+  replayTrace(std::vector<Flap> const& trace, bool enableDampening) {
+    const auto startTime = now_;
+    std::optional<FlapDampener> dampener;
+    if (enableDampening) {
+      dampener.emplace(makeDampener());
+    }
+
+    ReplayResult result;
+    bool isUp{true};
+    result.isAdvertisedUp = true;
+    auto updateAdvertised = [&]() {
+      const bool isAdvertisedUp =
+          isUp and not(dampener.has_value() and dampener->isSuppressed());
+      if (isAdvertisedUp != result.isAdvertisedUp) {
+        result.isAdvertisedUp = isAdvertisedUp;
+        ++result.churn;
+      }
+    };
+    auto processEvent = [&](chrono::milliseconds time, bool newIsUp) {
+      const auto eventTime = startTime + time;
+      // Suppression may end in between events
+      if (dampener.has_value() and dampener->isSuppressed()) {
+        const auto reuseTime = now_ + dampener->getTimeUntilReuse();
+        if (reuseTime <= eventTime) {
+          now_ = reuseTime;
+          updateAdvertised();
+        }
+      }
+      now_ = eventTime;
+      if (isUp and not newIsUp and dampener.has_value()) {
+        dampener->reportFlap();
+      }
+      isUp = newIsUp;
+      updateAdvertised();
+    };
+
+    for (auto const& flap : trace) {
+      processEvent(flap.time, false);
+      processEvent(flap.time + flap.downFor, true);
+    }
+
+    // Wait for suppression to end
+    if (dampener.has_value() and dampener->isSuppressed()) {
+      result.suppressedAfterTrace = dampener->getTimeUntilReuse();
+      advanceTime(result.suppressedAfterTrace);
+      updateAdvertised();
+    }
+    return result;
+  }
+
+  FlapDampener::Params params_;
+
+  FlapDampener::Clock::time_point now_{FlapDampener::Clock::now()};
+};
+
+TEST_F(FlapDampenerFixture, PenaltyDecayTest) {
+  auto dampener = makeDampener();
+  EXPECT_EQ(0, dampener.getPenalty());
+  EXPECT_EQ(0, dampener.getNumFlaps());
+
+  EXPECT_FALSE(dampener.reportFlap());
+  EXPECT_DOUBLE_EQ(1000, dampener.getPenalty());
+  EXPECT_EQ(1, dampener.getNumFlaps());
+
+  // penalty halves every half-life
+  advanceTime(params_.halfLife);
+  EXPECT_DOUBLE_EQ(500, dampener.getPenalty());
+  advanceTime(params_.halfLife);
+  EXPECT_DOUBLE_EQ(250, dampener.getPenalty());
+
+  // new flap adds up to decayed penalty
+  EXPECT_FALSE(dampener.reportFlap());
+  EXPECT_DOUBLE_EQ(1250, dampener.getPenalty());
+  EXPECT_FALSE(dampener.isSuppressed());
+  EXPECT_EQ(chrono::milliseconds(0), dampener.getTimeUntilReuse());
+}
+
+TEST_F(FlapDampenerFixture, SuppressAndReuseTest) {
+  auto dampener = makeDampener();
+
+  // suppressed only once penalty exceeds suppress threshold
+  EXPECT_FALSE(dampener.reportFlap());
+  EXPECT_FALSE(dampener.reportFlap());
+  EXPECT_FALSE(dampener.isSuppressed());
+  EXPECT_TRUE(dampener.reportFlap());
+  EXPECT_TRUE(dampener.isSuppressed());
+  EXPECT_EQ(1, dampener.getNumSuppressions());
+
+  // 3000 decays to reuse threshold of 750 in two half-lives
+  EXPECT_EQ(chrono::milliseconds(30001), dampener.getTimeUntilReuse());
+
+  // stays suppressed while penalty is in between reuse and suppress thresholds
+  advanceTime(params_.halfLife);
+  EXPECT_DOUBLE_EQ(1500, dampener.getPenalty());
+  EXPECT_TRUE(dampener.isSuppressed());
+
+  // flap while suppressed extends suppression, but is not a new suppression
+  EXPECT_FALSE(dampener.reportFlap());
+  EXPECT_TRUE(dampener.isSuppressed());
+  EXPECT_EQ(1, dampener.getNumSuppressions());
+
+  // reused once penalty decays to reuse threshold
+  const auto reuseTime = dampener.getTimeUntilReuse();
+  advanceTime(reuseTime - chrono::milliseconds(1));
+  EXPECT_TRUE(dampener.isSuppressed());
+  advanceTime(chrono::milliseconds(1));
+  EXPECT_FALSE(dampener.isSuppressed());
+  EXPECT_EQ(chrono::milliseconds(0), dampener.getTimeUntilReuse());
+
+  // not suppressed again until penalty exceeds suppress threshold
+  EXPECT_FALSE(dampener.reportFlap());
+  EXPECT_FALSE(dampener.isSuppressed());
+  EXPECT_TRUE(dampener.reportFlap());
+  EXPECT_EQ(2, dampener.getNumSuppressions());
+}
+
+TEST_F(FlapDampenerFixture, MaxSuppressTimeTest) {
+  auto dampener = makeDampener();
+
+  // penalty is capped at reuse * 2 ^ (maxSuppressTime / halfLife)
+  for (int i = 0; i < 100; ++i) {
+    dampener.reportFlap();
+  }
+  EXPECT_DOUBLE_EQ(750 * 16, dampener.getPenalty());
+  EXPECT_TRUE(dampener.isSuppressed());
+
+  advanceTime(params_.maxSuppressTime - chrono::milliseconds(1));
+  EXPECT_TRUE(dampener.isSuppressed());
+  advanceTime(chrono::milliseconds(1));
+  EXPECT_FALSE(dampener.isSuppressed());
+}
+
+TEST_F(FlapDampenerFixture, ForgetTest) {
+  auto dampener = makeDampener();
+  EXPECT_TRUE(dampener.canForget());
+
+  dampener.reportFlap();
+  EXPECT_FALSE(dampener.canForget());
+
+  // history is forgotten once penalty is below half of reuse threshold
+  advanceTime(chrono::milliseconds(20000));
+  EXPECT_FALSE(dampener.canForget());
+  advanceTime(chrono::milliseconds(2000));
+  EXPECT_TRUE(dampener.canForget());
+}
+
+//
+// Replay recorded link flap traces and compare number of advertised UP/DOWN
+// transitions (control-plane churn) with and without dampening
+//
+TEST_F(FlapDampenerFixture, ReplayFlapTracesTest) {
+  using chrono::milliseconds;
+  using chrono::minutes;
+  using chrono::seconds;
+
+  // Healthy link with a rare flap every 10 minutes. Never suppressed.
+  {
+    std::vector<Flap> trace;
+    for (int i = 1; i <= 6; ++i) {
+      trace.push_back({minutes(10) * i, seconds(1)});
+    }
+    const auto undampened = replayTrace(trace, false);
+    const auto dampened = replayTrace(trace, true);
+    EXPECT_EQ(12, undampened.churn);
+    EXPECT_EQ(12, dampened.churn);
+    EXPECT_TRUE(dampened.isAdvertisedUp);
+    EXPECT_EQ(milliseconds(0), dampened.suppressedAfterTrace);
+  }
+
+  // Faulty optic flapping every 2 seconds for 2 minutes. Suppressed on third
+  // flap and reused within max suppress time after flapping stops.
+  {
+    std::vector<Flap> trace;
+    for (int i = 1; i <= 60; ++i) {
+      trace.push_back({seconds(2) * i, seconds(1)});
+    }
+    const auto undampened = replayTrace(trace, false);
+    const auto dampened = replayTrace(trace, true);
+    LOG(INFO) << "Periodic flaps. Churn without dampening: "
+              << undampened.churn << ", with dampening: " << dampened.churn;
+    EXPECT_EQ(120, undampened.churn);
+    EXPECT_EQ(6, dampened.churn);
+    EXPECT_TRUE(dampened.isAdvertisedUp);
+    EXPECT_LT(milliseconds(0), dampened.suppressedAfterTrace);
+    EXPECT_GE(params_.maxSuppressTime, dampened.suppressedAfterTrace);
+  }
+
+  // Bursts of 5 flaps within 5 seconds every 5 minutes. Each burst is cut
+  // short by suppression, and history decays in between bursts.
+  {
+    std::vector<Flap> trace;
+    for (int burst = 0; burst < 4; ++burst) {
+      for (int i = 1; i <= 5; ++i) {
+        trace.push_back(
+            {minutes(5) * burst + seconds(1) * i, milliseconds(500)});
+      }
+    }
+    const auto undampened = replayTrace(trace, false);
+    const auto dampened = replayTrace(trace, true);
+    LOG(INFO) << "Bursty flaps. Churn without dampening: " << undampened.churn
+              << ", with dampening: " << dampened.churn;
+    EXPECT_EQ(40, undampened.churn);
+    EXPECT_EQ(24, dampened.churn);
+    EXPECT_TRUE(dampened.isAdvertisedUp);
+  }
+}
+
+} // namespace openr
+
+int
+main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = true;
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/LatencyHistogram.h>
+
+using namespace openr;
+
+TEST(LatencyHistogramTest, EmptyTest) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.getCount());
+  EXPECT_EQ(0, histogram.getWindowSize());
+
+  const auto percentiles = histogram.getPercentiles();
+  EXPECT_EQ(0, percentiles.p50);
+  EXPECT_EQ(0, percentiles.p99);
+  EXPECT_EQ(0, percentiles.p999);
+  EXPECT_EQ(0, percentiles.max);
+}
+
+TEST(LatencyHistogramTest, PercentileTest) {
+  LatencyHistogram histogram(1000);
+
+  // Add samples 1..1000 in reverse order
+  for (int64_t i = 1000; i > 0; --i) {
+    histogram.addValue(i);
+  }
+  EXPECT_EQ(1000, histogram.getCount());
+  EXPECT_EQ(1000, histogram.getWindowSize());
+
+  const auto percentiles = histogram.getPercentiles();
+  EXPECT_EQ(500, percentiles.p50);
+  EXPECT_EQ(990, percentiles.p99);
+  EXPECT_EQ(999, percentiles.p999);
+  EXPECT_EQ(1000, percentiles.max);
+
+  // Single sample
+  LatencyHistogram single;
+  single.addValue(7);
+  EXPECT_EQ(7, single.getPercentiles().p50);
+  EXPECT_EQ(7, single.getPercentiles().p999);
+}
+
+TEST(LatencyHistogramTest, RollingWindowTest) {
+  LatencyHistogram histogram(10);
+
+  // Older samples must be evicted from the window
+  for (int64_t i = 0; i < 10; ++i) {
+    histogram.addValue(1000);
+  }
+  for (int64_t i = 0; i < 10; ++i) {
+    histogram.addValue(1);
+  }
+  EXPECT_EQ(20, histogram.getCount());
+  EXPECT_EQ(10, histogram.getWindowSize());
+  EXPECT_EQ(1, histogram.getPercentiles().max);
+
+  histogram.addError();
+  histogram.addError();
+  EXPECT_EQ(2, histogram.getNumErrors());
+}
+
+int
+main(int argc, char** argv) {
+  // Basic initialization
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <optional>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/MetricSmoother.h>
+
+namespace chrono = std::chrono;
+
+namespace openr {
+
+/**
+ * Drives smoother with virtual clock, so that tests are deterministic and
+ * don't depend on real time.
+ */
+class MetricSmootherFixture : public ::testing::Test {
+ protected:
+  MetricSmoother
+  makeSmoother(MetricSmoother::Params const& params, int64_t initialValue) {
+    return MetricSmoother(params, initialValue, [this]() { return now_; });
+  }
+
+  void
+  advanceTime(chrono::milliseconds duration) {
+    now_ += duration;
+  }
+
+  MetricSmoother::Clock::time_point now_{MetricSmoother::Clock::now()};
+};
+
+TEST_F(MetricSmootherFixture, PassThroughTest) {
+  // default parameters let every change through as is
+  auto smoother = makeSmoother({}, 1234);
+  EXPECT_EQ(1234, smoother.getValue());
+
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(1235));
+  EXPECT_EQ(1235, smoother.getValue());
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(100));
+  EXPECT_EQ(100, smoother.getValue());
+  EXPECT_EQ(MetricSmoother::Result::SUPPRESSED, smoother.addSample(100));
+  EXPECT_FALSE(smoother.hasPendingUpdate());
+}
+
+TEST_F(MetricSmootherFixture, EwmaTest) {
+  MetricSmoother::Params params;
+  params.ewmaWeightPct = 50;
+  auto smoother = makeSmoother(params, 1000);
+
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(2000));
+  EXPECT_DOUBLE_EQ(1500, smoother.getSmoothedValue());
+  EXPECT_EQ(1500, smoother.getValue());
+
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(2000));
+  EXPECT_EQ(1750, smoother.getValue());
+
+  // spike is cut by half
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(10250));
+  EXPECT_EQ(6000, smoother.getValue());
+}
+
+TEST_F(MetricSmootherFixture, QuantizationBandTest) {
+  MetricSmoother::Params params;
+  params.quantizationBand = 1000;
+  auto smoother = makeSmoother(params, 10200);
+
+  // initial value is quantized as well
+  EXPECT_EQ(10000, smoother.getValue());
+
+  // change within a band is suppressed, even if it rounds to next band
+  EXPECT_EQ(MetricSmoother::Result::SUPPRESSED, smoother.addSample(10800));
+  EXPECT_EQ(10000, smoother.getValue());
+
+  // change of a full band goes through
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(11000));
+  EXPECT_EQ(11000, smoother.getValue());
+
+  // same in the other direction
+  EXPECT_EQ(MetricSmoother::Result::SUPPRESSED, smoother.addSample(10100));
+  EXPECT_EQ(11000, smoother.getValue());
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(9900));
+  EXPECT_EQ(10000, smoother.getValue());
+}
+
+TEST_F(MetricSmootherFixture, HoldTimeTest) {
+  MetricSmoother::Params params;
+  params.minHoldTime = chrono::seconds(10);
+  auto smoother = makeSmoother(params, 1000);
+
+  // change within hold time is deferred
+  advanceTime(chrono::seconds(1));
+  EXPECT_EQ(MetricSmoother::Result::DEFERRED, smoother.addSample(2000));
+  EXPECT_TRUE(smoother.hasPendingUpdate());
+  EXPECT_EQ(1000, smoother.getValue());
+  EXPECT_EQ(chrono::seconds(9), smoother.getTimeUntilUpdate());
+  EXPECT_FALSE(smoother.applyPendingUpdate());
+
+  // deferred change is applied after hold time with latest value
+  advanceTime(chrono::seconds(5));
+  EXPECT_EQ(MetricSmoother::Result::DEFERRED, smoother.addSample(3000));
+  advanceTime(chrono::seconds(4));
+  EXPECT_EQ(chrono::seconds(0), smoother.getTimeUntilUpdate());
+  EXPECT_TRUE(smoother.applyPendingUpdate());
+  EXPECT_EQ(3000, smoother.getValue());
+  EXPECT_FALSE(smoother.hasPendingUpdate());
+
+  // hold time restarts after update. Deferred change is dropped if value
+  // settles back within band.
+  EXPECT_EQ(MetricSmoother::Result::DEFERRED, smoother.addSample(4000));
+  EXPECT_EQ(MetricSmoother::Result::SUPPRESSED, smoother.addSample(3000));
+  EXPECT_FALSE(smoother.hasPendingUpdate());
+  advanceTime(chrono::seconds(10));
+  EXPECT_FALSE(smoother.applyPendingUpdate());
+  EXPECT_EQ(3000, smoother.getValue());
+
+  // change after hold time is applied immediately
+  EXPECT_EQ(MetricSmoother::Result::UPDATED, smoother.addSample(4000));
+  EXPECT_EQ(4000, smoother.getValue());
+}
+
+//
+// Replay RTT measured every second on a loaded link. RTT is noisy around 10ms
+// and steps up to 20ms half way through. Without smoothing every sample is a
+// metric update, and thus a network wide flood and route computation. With
+// smoothing only the real step results in updates.
+//
+TEST_F(MetricSmootherFixture, NoisyRttTest) {
+  const std::vector<int64_t> noiseUs{
+      10000, 13000, 8000, 11500, 9000, 12000, 7500, 10500};
+
+  auto replay = [&](MetricSmoother::Params const& params) {
+    auto smoother = makeSmoother(params, 10000);
+    size_t numUpdates{0};
+    std::optional<MetricSmoother::Clock::time_point> holdTimerExpiry;
+
+    for (size_t i = 1; i <= 300; ++i) {
+      const auto sampleTime = now_ + chrono::seconds(1);
+      // hold timer fires in between samples
+      if (holdTimerExpiry.has_value() and *holdTimerExpiry <= sampleTime) {
+        now_ = *holdTimerExpiry;
+        holdTimerExpiry.reset();
+        if (smoother.applyPendingUpdate()) {
+          ++numUpdates;
+        } else if (smoother.hasPendingUpdate()) {
+          holdTimerExpiry = now_ + smoother.getTimeUntilUpdate();
+        }
+      }
+      now_ = sampleTime;
+
+      const int64_t stepUs = i <= 150 ? 0 : 10000;
+      switch (smoother.addSample(noiseUs.at(i % noiseUs.size()) + stepUs)) {
+      case MetricSmoother::Result::UPDATED:
+        ++numUpdates;
+        break;
+      case MetricSmoother::Result::DEFERRED:
+        holdTimerExpiry = now_ + smoother.getTimeUntilUpdate();
+        break;
+      case MetricSmoother::Result::SUPPRESSED:
+        break;
+      }
+    }
+
+    if (holdTimerExpiry.has_value()) {
+      now_ = *holdTimerExpiry;
+      if (smoother.applyPendingUpdate()) {
+        ++numUpdates;
+      }
+    }
+    return std::make_pair(numUpdates, smoother.getValue());
+  };
+
+  // no smoothing
+  const auto rawUpdates = replay({}).first;
+  EXPECT_EQ(300, rawUpdates);
+
+  // quantization alone doesn't help against noise spanning multiple bands
+  MetricSmoother::Params params;
+  params.quantizationBand = 1000;
+  EXPECT_EQ(300, replay(params).first);
+
+  // EWMA + quantization + hold time
+  params.ewmaWeightPct = 30;
+  params.minHoldTime = chrono::seconds(10);
+  const auto [smoothUpdates, smoothValue] = replay(params);
+  LOG(INFO) << "Metric updates without smoothing: " << rawUpdates
+            << ", with smoothing: " << smoothUpdates;
+  EXPECT_EQ(2, smoothUpdates);
+  EXPECT_EQ(20000, smoothValue);
+}
+
+} // namespace openr
+
+int
+main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = true;
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/PrefixTrie.h>
+
+namespace openr {
+
+namespace {
+
+std::vector<std::string>
+getCovering(PrefixTrie<int>& trie, const std::string& addr) {
+  std::vector<std::string> networks;
+  trie.forEachCovering(
+      folly::IPAddress(addr), [&](const folly::CIDRNetwork& network, int&) {
+        networks.emplace_back(folly::IPAddress::networkToString(network));
+      });
+  return networks;
+}
+
+} // namespace
+
+TEST(PrefixTrieTest, InsertGetEraseTest) {
+  PrefixTrie<int> trie;
+  const auto net8 = folly::IPAddress::createNetwork("10.0.0.0/8");
+  const auto net16 = folly::IPAddress::createNetwork("10.1.0.0/16");
+
+  EXPECT_TRUE(trie.empty());
+  EXPECT_TRUE(trie.insert(net8, 8));
+  EXPECT_TRUE(trie.insert(net16, 16));
+  EXPECT_EQ(2, trie.size());
+
+  // replace existing value
+  EXPECT_FALSE(trie.insert(net16, 160));
+  EXPECT_EQ(2, trie.size());
+  ASSERT_NE(nullptr, trie.get(net16));
+  EXPECT_EQ(160, *trie.get(net16));
+
+  // intermediate node is not a network
+  EXPECT_EQ(nullptr, trie.get(folly::IPAddress::createNetwork("10.0.0.0/12")));
+
+  // erase less specific network, more specific one is kept
+  EXPECT_TRUE(trie.erase(net8));
+  EXPECT_FALSE(trie.erase(net8));
+  EXPECT_EQ(nullptr, trie.get(net8));
+  ASSERT_NE(nullptr, trie.get(net16));
+  EXPECT_EQ(1, trie.size());
+
+  EXPECT_TRUE(trie.erase(net16));
+  EXPECT_TRUE(trie.empty());
+}
+
+TEST(PrefixTrieTest, ForEachCoveringTest) {
+  PrefixTrie<int> trie;
+  trie.insert(folly::IPAddress::createNetwork("0.0.0.0/0"), 0);
+  trie.insert(folly::IPAddress::createNetwork("10.0.0.0/8"), 0);
+  trie.insert(folly::IPAddress::createNetwork("10.1.0.0/16"), 0);
+  trie.insert(folly::IPAddress::createNetwork("10.2.0.0/16"), 0);
+  trie.insert(folly::IPAddress::createNetwork("10.1.1.1/32"), 0);
+  trie.insert(folly::IPAddress::createNetwork("fc00::/7"), 0);
+  trie.insert(folly::IPAddress::createNetwork("fc00:cafe::/32"), 0);
+
+  // from least to most specific
+  EXPECT_EQ(
+      std::vector<std::string>(
+          {"0.0.0.0/0", "10.0.0.0/8", "10.1.0.0/16", "10.1.1.1/32"}),
+      getCovering(trie, "10.1.1.1"));
+  EXPECT_EQ(
+      std::vector<std::string>({"0.0.0.0/0", "10.0.0.0/8", "10.1.0.0/16"}),
+      getCovering(trie, "10.1.1.2"));
+  EXPECT_EQ(
+      std::vector<std::string>({"0.0.0.0/0"}), getCovering(trie, "11.0.0.1"));
+
+  // address families are kept apart
+  EXPECT_EQ(
+      std::vector<std::string>({"fc00::/7", "fc00:cafe::/32"}),
+      getCovering(trie, "fc00:cafe::1"));
+  EXPECT_TRUE(getCovering(trie, "2001:db8::1").empty());
+
+  // must be consistent with folly::IPAddress::inSubnet()
+  for (const auto& addr : {"10.1.1.1", "10.2.3.4", "192.168.0.1"}) {
+    size_t numCovering{0};
+    trie.forEachCovering(
+        folly::IPAddress(addr),
+        [&](const folly::CIDRNetwork& network, int&) {
+          EXPECT_TRUE(
+              folly::IPAddress(addr).inSubnet(network.first, network.second));
+          ++numCovering;
+        });
+    EXPECT_EQ(getCovering(trie, addr).size(), numCovering);
+  }
+}
+
+TEST(PrefixTrieTest, PruneTest) {
+  PrefixTrie<int> trie;
+  const auto net24 = folly::IPAddress::createNetwork("10.1.1.0/24");
+  const auto net32 = folly::IPAddress::createNetwork("10.1.1.1/32");
+  trie.insert(net24, 24);
+  trie.insert(net32, 32);
+
+  // erasing most specific network must not affect its parent
+  EXPECT_TRUE(trie.erase(net32));
+  ASSERT_NE(nullptr, trie.get(net24));
+  EXPECT_EQ(24, *trie.get(net24));
+  EXPECT_EQ(
+      std::vector<std::string>({"10.1.1.0/24"}),
+      getCovering(trie, "10.1.1.1"));
+
+  // re-insert after prune
+  EXPECT_TRUE(trie.insert(net32, 320));
+  EXPECT_EQ(320, *trie.get(net32));
+}
+
+} // namespace openr
+
+int
+main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = true;
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <folly/io/async/EventBase.h>
+#include <openr/common/TimerWheel.h>
+
+namespace chrono = std::chrono;
+
+namespace openr {
+
+/**
+ * Drives timer wheel with virtual clock, so that tests are deterministic and
+ * don't depend on real time.
+ */
+class TimerWheelFixture : public ::testing::Test {
+ protected:
+  void
+  advanceTime(chrono::milliseconds duration) {
+    now_ += duration;
+    wheel_.advance();
+  }
+
+  TimerWheel::Clock::time_point now_{TimerWheel::Clock::now()};
+
+  TimerWheel wheel_{
+      nullptr /* evb */,
+      chrono::milliseconds(10) /* tickInterval */,
+      8 /* numSlots */,
+      [this]() { return now_; }};
+};
+
+TEST_F(TimerWheelFixture, FireTest) {
+  int count{0};
+  auto timer = wheel_.makeTimer([&count]() { ++count; });
+  EXPECT_FALSE(timer->isScheduled());
+
+  timer->scheduleTimeout(chrono::milliseconds(25));
+  EXPECT_TRUE(timer->isScheduled());
+  EXPECT_EQ(1, wheel_.getNumScheduled());
+
+  // timer never fires early, and at most a tick late
+  advanceTime(chrono::milliseconds(20));
+  EXPECT_EQ(0, count);
+  advanceTime(chrono::milliseconds(10));
+  EXPECT_EQ(1, count);
+  EXPECT_FALSE(timer->isScheduled());
+  EXPECT_EQ(0, wheel_.getNumScheduled());
+
+  // fired timer is not fired again
+  advanceTime(chrono::milliseconds(100));
+  EXPECT_EQ(1, count);
+
+  // timer can be re-armed
+  timer->scheduleTimeout(chrono::milliseconds(10));
+  advanceTime(chrono::milliseconds(10));
+  EXPECT_EQ(2, count);
+}
+
+TEST_F(TimerWheelFixture, CancelAndRescheduleTest) {
+  int count{0};
+  auto timer = wheel_.makeTimer([&count]() { ++count; });
+
+  timer->scheduleTimeout(chrono::milliseconds(20));
+  timer->cancelTimeout();
+  EXPECT_FALSE(timer->isScheduled());
+  EXPECT_EQ(0, wheel_.getNumScheduled());
+  advanceTime(chrono::milliseconds(50));
+  EXPECT_EQ(0, count);
+
+  // rescheduling postpones expiry
+  timer->scheduleTimeout(chrono::milliseconds(20));
+  advanceTime(chrono::milliseconds(10));
+  timer->scheduleTimeout(chrono::milliseconds(20));
+  EXPECT_EQ(1, wheel_.getNumScheduled());
+  advanceTime(chrono::milliseconds(10));
+  EXPECT_EQ(0, count);
+  advanceTime(chrono::milliseconds(10));
+  EXPECT_EQ(1, count);
+
+  // destroyed timer never fires
+  timer->scheduleTimeout(chrono::milliseconds(10));
+  timer.reset();
+  EXPECT_EQ(0, wheel_.getNumScheduled());
+  advanceTime(chrono::milliseconds(50));
+  EXPECT_EQ(1, count);
+}
+
+//
+// Timers farther than one revolution of the wheel (8 slots x 10ms) must only
+// fire when due, even if they share the slot with earlier timers.
+//
+TEST_F(TimerWheelFixture, MultipleRevolutionsTest) {
+  std::vector<int> fired;
+  auto timer1 = wheel_.makeTimer([&fired]() { fired.push_back(1); });
+  auto timer2 = wheel_.makeTimer([&fired]() { fired.push_back(2); });
+  auto timer3 = wheel_.makeTimer([&fired]() { fired.push_back(3); });
+
+  timer1->scheduleTimeout(chrono::milliseconds(30));
+  timer2->scheduleTimeout(chrono::milliseconds(110)); // same slot as timer1
+  timer3->scheduleTimeout(chrono::milliseconds(1000));
+
+  advanceTime(chrono::milliseconds(30));
+  EXPECT_EQ(std::vector<int>({1}), fired);
+
+  advanceTime(chrono::milliseconds(80));
+  EXPECT_EQ(std::vector<int>({1, 2}), fired);
+
+  // jump way beyond one revolution at once
+  advanceTime(chrono::milliseconds(2000));
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), fired);
+  EXPECT_EQ(0, wheel_.getNumScheduled());
+}
+
+//
+// Callbacks may re-arm, cancel or destroy timers, including themselves and
+// other timers due in the same tick.
+//
+TEST_F(TimerWheelFixture, CallbackModifiesTimersTest) {
+  int count1{0}, count2{0}, count3{0};
+  std::unique_ptr<TimerWheel::Timer> timer1, timer2, timer3;
+
+  timer1 = wheel_.makeTimer([&]() {
+    ++count1;
+    timer1->scheduleTimeout(chrono::milliseconds(10)); // periodic
+    timer2.reset(); // destroy other due timer
+  });
+  timer2 = wheel_.makeTimer([&]() { ++count2; });
+  timer3 = wheel_.makeTimer([&]() {
+    ++count3;
+    timer3.reset(); // destroy self
+  });
+
+  timer1->scheduleTimeout(chrono::milliseconds(10));
+  timer2->scheduleTimeout(chrono::milliseconds(10));
+  timer3->scheduleTimeout(chrono::milliseconds(10));
+
+  advanceTime(chrono::milliseconds(10));
+  EXPECT_EQ(1, count1);
+  EXPECT_EQ(0, count2);
+  EXPECT_EQ(1, count3);
+  EXPECT_EQ(nullptr, timer3);
+  EXPECT_EQ(1, wheel_.getNumScheduled());
+
+  for (int i = 0; i < 5; ++i) {
+    advanceTime(chrono::milliseconds(10));
+  }
+  EXPECT_EQ(6, count1);
+}
+
+//
+// Wheel driven by EventBase fires timers in real time
+//
+TEST(TimerWheelTest, EventBaseTest) {
+  folly::EventBase evb;
+  TimerWheel wheel(&evb, chrono::milliseconds(10));
+
+  const auto startTime = chrono::steady_clock::now();
+  chrono::steady_clock::time_point fireTime;
+  auto timer = wheel.makeTimer([&]() {
+    fireTime = chrono::steady_clock::now();
+    evb.terminateLoopSoon();
+  });
+  timer->scheduleTimeout(chrono::milliseconds(50));
+
+  evb.loopForever();
+  EXPECT_LE(chrono::milliseconds(50), fireTime - startTime);
+  EXPECT_EQ(0, wheel.getNumScheduled());
+}
+
+//
+// Wheel driven by EventBase must only wake up when pending timers are due,
+// not on every tick, while only long timers are pending.
+//
+TEST(TimerWheelTest, EventBaseIdleTest) {
+  folly::EventBase evb;
+  TimerWheel wheel(&evb, chrono::milliseconds(10), 8 /* numSlots */);
+
+  int count{0};
+  auto timer1 = wheel.makeTimer([&]() { ++count; });
+  auto timer2 = wheel.makeTimer([&]() {
+    ++count;
+    evb.terminateLoopSoon();
+  });
+  // Farther than one revolution of the wheel (8 slots x 10ms)
+  timer1->scheduleTimeout(chrono::milliseconds(200));
+  timer2->scheduleTimeout(chrono::milliseconds(500));
+
+  // cancelled timer must not wake up the wheel either
+  auto timer3 = wheel.makeTimer([&]() { ++count; });
+  timer3->scheduleTimeout(chrono::milliseconds(10));
+  timer3->cancelTimeout();
+
+  evb.loopForever();
+  EXPECT_EQ(2, count);
+
+  // ideally one tick per timer. Allow a few more in case tick timeout fires
+  // early as per steady clock.
+  EXPECT_GE(6, wheel.getNumTicks());
+}
+
+} // namespace openr
+
+int
+main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = true;
+
+  return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include <openr/common/Types.h>
+#include <openr/common/Util.h>
 
 using namespace openr;
 
@@ -54,6 +55,33 @@ TEST(TypesTest, fromStrTest) {
   EXPECT_TRUE(PrefixKey::fromStr(invalidStrWithBadPrefixV2, areaId).hasError());
 }
 
+TEST(TypesTest, PrefixBucketKeyTest) {
+  const std::string nodeName{"node-1"};
+  const auto bucketKey = PrefixKey::getPrefixBucketKey(nodeName, 17);
+  EXPECT_EQ(
+      fmt::format("{}{}:#17", Constants::kPrefixDbMarker.toString(), nodeName),
+      bucketKey);
+  EXPECT_TRUE(PrefixKey::isPrefixBucketKey(bucketKey));
+  EXPECT_EQ(nodeName, getNodeNameFromKey(bucketKey));
+
+  // per prefix keys are not bucket keys, and vice versa
+  const auto v4Network = folly::IPAddress::createNetwork("10.0.0.0/24");
+  const auto v6Network = folly::IPAddress::createNetwork("fc00::1/128");
+  EXPECT_FALSE(PrefixKey::isPrefixBucketKey(
+      PrefixKey(nodeName, v4Network, "area").getPrefixKeyV2()));
+  EXPECT_FALSE(PrefixKey::isPrefixBucketKey(
+      PrefixKey(nodeName, v6Network, "area").getPrefixKeyV2()));
+  EXPECT_TRUE(PrefixKey::fromStr(bucketKey).hasError());
+
+  // bucket only depends on the prefix
+  for (const auto& network : {v4Network, v6Network}) {
+    const auto bucket = PrefixKey::getPrefixBucket(network, 64);
+    EXPECT_LT(bucket, 64);
+    EXPECT_EQ(bucket, PrefixKey::getPrefixBucket(network, 64));
+    EXPECT_EQ(0, PrefixKey::getPrefixBucket(network, 1));
+  }
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
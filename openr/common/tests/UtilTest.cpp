@@ -372,6 +372,21 @@ TEST(UtilTest, GetNodeNameFromKeyTest) {
   }
 }
 
+TEST(UtilTest, AdjacencyKeyTest) {
+  const auto key = getAdjacencyKey("node1", "node2", "eth0:1");
+  EXPECT_EQ("adj:node1:node2:eth0:1", key);
+  EXPECT_EQ("node1", getNodeNameFromKey(key));
+  EXPECT_EQ(
+      std::make_pair(std::string("node2"), std::string("eth0:1")),
+      parseAdjacencyKey(key));
+
+  // Not per adjacency keys
+  for (const auto& k : std::vector<std::string>{
+           "adj:node1", "adj:node1:node2", "adj:node1:node2:", "prefix:a:b"}) {
+    EXPECT_EQ(std::nullopt, parseAdjacencyKey(k)) << k;
+  }
+}
+
 // test getNthPrefix()
 TEST(UtilTest, getNthPrefix) {
   // v6 allocation parameters
@@ -10,6 +10,7 @@
 #include <glog/logging.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <cctype>
 #include <stdexcept>
 
 #include <openr/common/Constants.h>
@@ -24,8 +25,125 @@ using openr::thrift::PrefixForwardingType;
 
 namespace openr {
 
+namespace {
+// Upper bound on number of names with cached regex match result
+const size_t kMaxCachedNames{100000};
+
+// Regex special characters, which are literal only if escaped
+const std::string kRegexMetaChars{"\\.^$|?*+()[]{}"};
+
+// Return lower-cased literal matched by the regex, or std::nullopt if regex
+// is not a plain literal
+std::optional<std::string>
+parseLiteral(std::string const& regex) {
+  std::string literal;
+  literal.reserve(regex.size());
+  for (size_t i = 0; i < regex.size(); ++i) {
+    auto c = static_cast<unsigned char>(regex[i]);
+    if (c == '\\') {
+      // escaped punctuation, e.g. "\.", is literal
+      if (i + 1 == regex.size() or
+          not std::ispunct(static_cast<unsigned char>(regex[i + 1]))) {
+        return std::nullopt;
+      }
+      c = static_cast<unsigned char>(regex[++i]);
+    } else if (
+        c >= 0x80 or not std::isprint(c) or
+        kRegexMetaChars.find(c) != std::string::npos) {
+      return std::nullopt;
+    }
+    literal.push_back(std::tolower(c));
+  }
+  return literal;
+}
+} // namespace
+
+NameMatcher::NameMatcher(std::vector<std::string> const& regexes) {
+  // validate all regexes first
+  allRegexSet_ = compileRegexSet(regexes);
+
+  std::vector<std::string> nonLiteralRegexes;
+  for (const auto& regex : regexes) {
+    if (auto literal = parseLiteral(regex)) {
+      literals_.emplace(std::move(*literal));
+      continue;
+    }
+    if (regex.size() >= 2 and regex.compare(regex.size() - 2, 2, ".*") == 0) {
+      if (auto prefix = parseLiteral(regex.substr(0, regex.size() - 2))) {
+        auto* node = &literalPrefixTrie_;
+        for (const auto c : *prefix) {
+          auto& child = node->children[c];
+          if (not child) {
+            child = std::make_unique<TrieNode>();
+          }
+          node = child.get();
+        }
+        node->terminal = true;
+        continue;
+      }
+    }
+    nonLiteralRegexes.emplace_back(regex);
+  }
+  if (not nonLiteralRegexes.empty()) {
+    regexSet_ = compileRegexSet(nonLiteralRegexes);
+  }
+}
+
+bool
+NameMatcher::match(std::string const& name) const {
+  // Regex case folding and `.` are only equivalent to literal matching for
+  // printable ASCII
+  std::string lowerName;
+  lowerName.reserve(name.size());
+  for (const auto ch : name) {
+    const auto c = static_cast<unsigned char>(ch);
+    if (c >= 0x80 or not std::isprint(c)) {
+      return allRegexSet_->Match(name, nullptr);
+    }
+    lowerName.push_back(std::tolower(c));
+  }
+
+  if (literals_.count(lowerName) or matchLiteralPrefix(lowerName)) {
+    return true;
+  }
+  if (not regexSet_) {
+    return false;
+  }
+
+  {
+    auto cache = regexCache_.rlock();
+    auto it = cache->find(name);
+    if (it != cache->end()) {
+      return it->second;
+    }
+  }
+  const bool matched = regexSet_->Match(name, nullptr);
+  auto cache = regexCache_.wlock();
+  if (cache->size() >= kMaxCachedNames) {
+    cache->clear();
+  }
+  cache->emplace(name, matched);
+  return matched;
+}
+
+bool
+NameMatcher::matchLiteralPrefix(std::string const& name) const {
+  const auto* node = &literalPrefixTrie_;
+  for (const auto c : name) {
+    if (node->terminal) {
+      return true;
+    }
+    auto it = node->children.find(c);
+    if (it == node->children.end()) {
+      return false;
+    }
+    node = it->second.get();
+  }
+  return node->terminal;
+}
+
 std::shared_ptr<re2::RE2::Set>
-AreaConfiguration::compileRegexSet(std::vector<std::string> const& strings) {
+NameMatcher::compileRegexSet(std::vector<std::string> const& strings) {
   re2::RE2::Options regexOpts;
   std::string regexErr;
   regexOpts.set_case_sensitive(false);
@@ -284,6 +402,13 @@ Config::checkDecisionConfig() const {
         decisionConf.get_debounce_min_ms(),
         decisionConf.get_debounce_max_ms()));
   }
+  if (auto grHoldMs = decisionConf.graceful_restart_hold_ms_ref()) {
+    if (*grHoldMs <= 0) {
+      throw std::invalid_argument(fmt::format(
+          "decision_config.graceful_restart_hold_ms ({}) should be > 0",
+          *grHoldMs));
+    }
+  }
 }
 
 void
@@ -383,6 +508,30 @@ Config::checkSparkConfig() const {
         *sparkConfig.step_detector_conf_ref()->lower_threshold_ref(),
         *sparkConfig.step_detector_conf_ref()->upper_threshold_ref()));
   }
+
+  if (*sparkConfig.enable_fast_liveness_ref()) {
+    auto& fastLivenessConfig = *sparkConfig.fast_liveness_config_ref();
+    if (*fastLivenessConfig.tx_interval_ms_ref() <= 0 ||
+        *fastLivenessConfig.tx_interval_ms_ref() > 65535) {
+      throw std::out_of_range(fmt::format(
+          "fast_liveness_config.tx_interval_ms ({}) should be in range [1, 65535]",
+          *fastLivenessConfig.tx_interval_ms_ref()));
+    }
+    if (*fastLivenessConfig.detect_multiplier_ref() <= 0 ||
+        *fastLivenessConfig.detect_multiplier_ref() > 255) {
+      throw std::out_of_range(fmt::format(
+          "fast_liveness_config.detect_multiplier ({}) should be in range [1, 255]",
+          *fastLivenessConfig.detect_multiplier_ref()));
+    }
+    if (*fastLivenessConfig.port_ref() <= 0 ||
+        *fastLivenessConfig.port_ref() > 65535 ||
+        *fastLivenessConfig.port_ref() ==
+            *sparkConfig.neighbor_discovery_port_ref()) {
+      throw std::out_of_range(fmt::format(
+          "fast_liveness_config.port ({}) should be in range [1, 65535] and differ from neighbor_discovery_port",
+          *fastLivenessConfig.port_ref()));
+    }
+  }
 }
 
 void
@@ -418,6 +567,49 @@ Config::checkLinkMonitorConfig() const {
         *lmConf.linkflap_initial_backoff_ms_ref(),
         *lmConf.linkflap_max_backoff_ms_ref()));
   }
+
+  // flap dampening validation
+  if (const auto& dampConf = lmConf.flap_dampening_config_ref()) {
+    if (*dampConf->penalty_per_flap_ref() <= 0 or
+        *dampConf->reuse_threshold_ref() <= 0 or
+        *dampConf->half_life_ms_ref() <= 0 or
+        *dampConf->max_suppress_time_ms_ref() <= 0) {
+      throw std::out_of_range(fmt::format(
+          "flap_dampening_config: penalty_per_flap ({}), reuse_threshold ({}), "
+          "half_life_ms ({}) and max_suppress_time_ms ({}) should be > 0",
+          *dampConf->penalty_per_flap_ref(),
+          *dampConf->reuse_threshold_ref(),
+          *dampConf->half_life_ms_ref(),
+          *dampConf->max_suppress_time_ms_ref()));
+    }
+
+    if (*dampConf->reuse_threshold_ref() >=
+        *dampConf->suppress_threshold_ref()) {
+      throw std::out_of_range(fmt::format(
+          "flap_dampening_config: reuse_threshold ({}) should be < suppress_threshold ({})",
+          *dampConf->reuse_threshold_ref(),
+          *dampConf->suppress_threshold_ref()));
+    }
+  }
+
+  // rtt metric smoothing validation
+  if (const auto& smoothConf = lmConf.rtt_metric_smoothing_config_ref()) {
+    if (*smoothConf->ewma_weight_pct_ref() <= 0 or
+        *smoothConf->ewma_weight_pct_ref() > 100) {
+      throw std::out_of_range(fmt::format(
+          "rtt_metric_smoothing_config: ewma_weight_pct ({}) should be in range [1, 100]",
+          *smoothConf->ewma_weight_pct_ref()));
+    }
+
+    if (*smoothConf->quantization_band_us_ref() <= 0 or
+        *smoothConf->min_hold_time_ms_ref() < 0) {
+      throw std::out_of_range(fmt::format(
+          "rtt_metric_smoothing_config: quantization_band_us ({}) should be "
+          "> 0 and min_hold_time_ms ({}) should be >= 0",
+          *smoothConf->quantization_band_us_ref(),
+          *smoothConf->min_hold_time_ms_ref()));
+    }
+  }
 }
 
 void
@@ -649,6 +841,19 @@ Config::populateInternalDb() {
     throw std::invalid_argument("Route delete duration must be >= 0ms");
   }
 
+  // Check number of netlink sockets for route programming
+  if (*config_.netlink_fib_handler_num_sockets_ref() < 1) {
+    throw std::invalid_argument(
+        "netlink_fib_handler_num_sockets must be >= 1");
+  }
+
+  // Check number of prefix key buckets
+  if (auto buckets = config_.prefix_db_key_buckets_ref()) {
+    if (*buckets < 1) {
+      throw std::invalid_argument("prefix_db_key_buckets must be >= 1");
+    }
+  }
+
   // validate KvStore config (e.g. ttl/flood-rate/etc.)
   checkKvStoreConfig();
 
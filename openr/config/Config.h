@@ -15,6 +15,7 @@ namespace fs = std::filesystem;
 namespace fs = std::experimental::filesystem;
 #endif
 #include <folly/IPAddress.h>
+#include <folly/Synchronized.h>
 #include <folly/io/async/SSLContext.h>
 #include <openr/common/FileUtil.h>
 #include <openr/common/MplsUtil.h>
@@ -31,6 +32,50 @@ namespace openr {
 
 using PrefixAllocationParams = std::pair<folly::CIDRNetwork, uint8_t>;
 
+/*
+ * Case-insensitive matcher of names (e.g. interface or neighbor names)
+ * against a list of fully anchored regexes. Patterns which are plain literals
+ * or literal prefixes (e.g. "po1" or "po.*") are matched by hash lookup and
+ * by walking a trie, without any regex evaluation. Results of rest of the
+ * patterns are cached per name. Cache lives as long as the matcher, i.e.
+ * until config is reloaded.
+ */
+class NameMatcher {
+ public:
+  // throws std::invalid_argument if any regex is invalid
+  explicit NameMatcher(std::vector<std::string> const& regexes);
+
+  bool match(std::string const& name) const;
+
+ private:
+  struct TrieNode {
+    bool terminal{false};
+    std::unordered_map<char, std::unique_ptr<TrieNode>> children;
+  };
+
+  bool matchLiteralPrefix(std::string const& name) const;
+
+  // given a list of strings we will convert is to a compiled RE2::Set
+  static std::shared_ptr<re2::RE2::Set> compileRegexSet(
+      std::vector<std::string> const& strings);
+
+  // lower-cased literal patterns
+  std::unordered_set<std::string> literals_;
+
+  // lower-cased literal prefixes of "<literal>.*" patterns
+  TrieNode literalPrefixTrie_;
+
+  // patterns which are neither literal nor literal prefix. nullptr if none.
+  std::shared_ptr<re2::RE2::Set> regexSet_{nullptr};
+
+  // all patterns, for names which can't be matched literally
+  std::shared_ptr<re2::RE2::Set> allRegexSet_{nullptr};
+
+  // match result of `regexSet_` per name
+  mutable folly::Synchronized<std::unordered_map<std::string, bool>>
+      regexCache_;
+};
+
 class AreaConfiguration {
  public:
   explicit AreaConfiguration(thrift::AreaConfig const& area)
@@ -46,13 +91,14 @@ class AreaConfiguration {
       srPrependLLabelRanges_ = *prependLabel;
     }
 
-    neighborRegexSet_ = compileRegexSet(area.get_neighbor_regexes());
-    interfaceIncludeRegexSet_ =
-        compileRegexSet(area.get_include_interface_regexes());
-    interfaceExcludeRegexSet_ =
-        compileRegexSet(area.get_exclude_interface_regexes());
-    interfaceRedistRegexSet_ =
-        compileRegexSet(area.get_redistribute_interface_regexes());
+    neighborMatcher_ =
+        std::make_shared<NameMatcher>(area.get_neighbor_regexes());
+    interfaceIncludeMatcher_ =
+        std::make_shared<NameMatcher>(area.get_include_interface_regexes());
+    interfaceExcludeMatcher_ =
+        std::make_shared<NameMatcher>(area.get_exclude_interface_regexes());
+    interfaceRedistMatcher_ = std::make_shared<NameMatcher>(
+        area.get_redistribute_interface_regexes());
     if (area.get_import_policy_name()) {
       importPolicyName_ = *area.import_policy_name_ref();
     }
@@ -80,18 +126,18 @@ class AreaConfiguration {
 
   bool
   shouldDiscoverOnIface(std::string const& iface) const {
-    return !interfaceExcludeRegexSet_->Match(iface, nullptr) &&
-        interfaceIncludeRegexSet_->Match(iface, nullptr);
+    return !interfaceExcludeMatcher_->match(iface) &&
+        interfaceIncludeMatcher_->match(iface);
   }
 
   bool
   shouldPeerWithNeighbor(std::string const& neighbor) const {
-    return neighborRegexSet_->Match(neighbor, nullptr);
+    return neighborMatcher_->match(neighbor);
   }
 
   bool
   shouldRedistributeIface(std::string const& iface) const {
-    return interfaceRedistRegexSet_->Match(iface, nullptr);
+    return interfaceRedistMatcher_->match(iface);
   }
 
   std::optional<std::string>
@@ -112,12 +158,8 @@ class AreaConfiguration {
 
   std::optional<std::string> importPolicyName_{std::nullopt};
 
-  // given a list of strings we will convert is to a compiled RE2::Set
-  static std::shared_ptr<re2::RE2::Set> compileRegexSet(
-      std::vector<std::string> const& strings);
-
-  std::shared_ptr<re2::RE2::Set> neighborRegexSet_, interfaceIncludeRegexSet_,
-      interfaceExcludeRegexSet_, interfaceRedistRegexSet_;
+  std::shared_ptr<NameMatcher> neighborMatcher_, interfaceIncludeMatcher_,
+      interfaceExcludeMatcher_, interfaceRedistMatcher_;
 };
 
 class Config {
@@ -184,6 +226,11 @@ class Config {
     return config_.enable_netlink_fib_handler_ref().value_or(false);
   }
 
+  int32_t
+  getNetlinkFibHandlerNumSockets() const {
+    return *config_.netlink_fib_handler_num_sockets_ref();
+  }
+
   bool
   isFibServiceWaitingEnabled() const {
     return *config_.enable_fib_service_waiting_ref();
@@ -427,6 +427,53 @@ TEST(ConfigTest, AreaConfiguration) {
   EXPECT_FALSE(areaConf.shouldRedistributeIface(""));
 }
 
+TEST(ConfigTest, NameMatcher) {
+  const std::vector<std::string> regexes{
+      "po1", "eth0\\.100", "RSW.*", "fsw00.*", "iface[0-9]+", ".*-mgmt"};
+  NameMatcher matcher(regexes);
+
+  // literal and literal prefix, case-insensitive
+  EXPECT_TRUE(matcher.match("po1"));
+  EXPECT_TRUE(matcher.match("PO1"));
+  EXPECT_FALSE(matcher.match("po10"));
+  EXPECT_TRUE(matcher.match("eth0.100"));
+  EXPECT_FALSE(matcher.match("eth0x100"));
+  EXPECT_TRUE(matcher.match("rsw"));
+  EXPECT_TRUE(matcher.match("rsw001.p001"));
+  EXPECT_TRUE(matcher.match("fsw001"));
+  EXPECT_FALSE(matcher.match("fsw010"));
+
+  // regex, cached result is consistent
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(matcher.match("iface20"));
+    EXPECT_FALSE(matcher.match("iface"));
+    EXPECT_TRUE(matcher.match("ssw001-mgmt"));
+  }
+  EXPECT_FALSE(matcher.match(""));
+
+  // must be consistent with matching all regexes with RE2::Set
+  re2::RE2::Options regexOpts;
+  regexOpts.set_case_sensitive(false);
+  re2::RE2::Set reSet(regexOpts, re2::RE2::ANCHOR_BOTH);
+  for (const auto& regex : regexes) {
+    ASSERT_NE(-1, reSet.Add(regex, nullptr));
+  }
+  ASSERT_TRUE(reSet.Compile());
+  for (const auto& name :
+       {"po1", "Po1", "po", "eth0.100", "RSW001", "rsw\n", "fsw00", "iface1a",
+        "x-mgmt", "x-MGMT", "r\xc5\xa1w", "\xe2\x84\xaa"}) {
+    EXPECT_EQ(reSet.Match(name, nullptr), matcher.match(name)) << name;
+  }
+
+  // empty list matches nothing
+  NameMatcher emptyMatcher(std::vector<std::string>{});
+  EXPECT_FALSE(emptyMatcher.match(""));
+  EXPECT_FALSE(emptyMatcher.match("po1"));
+
+  // invalid regex
+  EXPECT_THROW(NameMatcher({"po1", "iface["}), std::invalid_argument);
+}
+
 TEST(ConfigTest, BgpTranslationConfig) {
   auto tConfig = getBasicOpenrConfig();
   tConfig.enable_bgp_peering_ref() = true;
@@ -603,6 +650,25 @@ TEST(ConfigTest, PopulateInternalDb) {
     EXPECT_THROW(auto c = Config(confInvalidSpark), std::invalid_argument);
   }
 
+  // Decision
+
+  // graceful_restart_hold_ms <= 0
+  {
+    auto confInvalidDecision = getBasicOpenrConfig();
+    confInvalidDecision.decision_config_ref()->graceful_restart_hold_ms_ref() =
+        0;
+    EXPECT_THROW(auto c = Config(confInvalidDecision), std::invalid_argument);
+  }
+
+  // Prefix Manager
+
+  // prefix_db_key_buckets <= 0
+  {
+    auto confInvalidPrefixMgr = getBasicOpenrConfig();
+    confInvalidPrefixMgr.prefix_db_key_buckets_ref() = 0;
+    EXPECT_THROW(auto c = Config(confInvalidPrefixMgr), std::invalid_argument);
+  }
+
   // Monitor
 
   // Exception monitor_max_event_log >= 0
@@ -636,6 +702,43 @@ TEST(ConfigTest, PopulateInternalDb) {
         300000;
     EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
   }
+  // flap_dampening_config.half_life_ms <= 0
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    thrift::FlapDampeningConfig dampConf;
+    dampConf.half_life_ms_ref() = 0;
+    confInvalidLm.link_monitor_config_ref()->flap_dampening_config_ref() =
+        dampConf;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
+  // flap_dampening_config.reuse_threshold >= suppress_threshold
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    thrift::FlapDampeningConfig dampConf;
+    dampConf.reuse_threshold_ref() = 2000;
+    dampConf.suppress_threshold_ref() = 2000;
+    confInvalidLm.link_monitor_config_ref()->flap_dampening_config_ref() =
+        dampConf;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
+  // rtt_metric_smoothing_config.ewma_weight_pct > 100
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    thrift::RttMetricSmoothingConfig smoothConf;
+    smoothConf.ewma_weight_pct_ref() = 101;
+    confInvalidLm.link_monitor_config_ref()->rtt_metric_smoothing_config_ref() =
+        smoothConf;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
+  // rtt_metric_smoothing_config.quantization_band_us <= 0
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    thrift::RttMetricSmoothingConfig smoothConf;
+    smoothConf.quantization_band_us_ref() = 0;
+    confInvalidLm.link_monitor_config_ref()->rtt_metric_smoothing_config_ref() =
+        smoothConf;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
 
   // prefix allocation
 
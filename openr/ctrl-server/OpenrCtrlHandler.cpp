@@ -622,6 +622,12 @@ OpenrCtrlHandler::semifuture_getPerfDb() {
   return fib_->getPerfDb();
 }
 
+folly::SemiFuture<std::unique_ptr<std::map<std::string, thrift::LatencyStats>>>
+OpenrCtrlHandler::semifuture_getFibLatencyStats() {
+  CHECK(fib_);
+  return fib_->getLatencyStats();
+}
+
 //
 // Decision APIs
 //
@@ -1201,6 +1207,12 @@ OpenrCtrlHandler::semifuture_getInterfaces() {
   return linkMonitor_->semifuture_getInterfaces();
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::DumpFlapDampeningReply>>
+OpenrCtrlHandler::semifuture_getFlapDampeningStates() {
+  CHECK(linkMonitor_);
+  return linkMonitor_->semifuture_getFlapDampeningStates();
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDatabase>>
 OpenrCtrlHandler::semifuture_getLinkMonitorAdjacencies() {
   CHECK(linkMonitor_);
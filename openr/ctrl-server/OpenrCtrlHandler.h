@@ -198,6 +198,10 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>>
   semifuture_getPerfDb() override;
 
+  folly::SemiFuture<
+      std::unique_ptr<std::map<std::string, thrift::LatencyStats>>>
+  semifuture_getFibLatencyStats() override;
+
   //
   // Decision APIs
   //
@@ -360,6 +364,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::DumpLinksReply>>
   semifuture_getInterfaces() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::DumpFlapDampeningReply>>
+  semifuture_getFlapDampeningStates() override;
+
   folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDatabase>>
   semifuture_getLinkMonitorAdjacencies() override;
 
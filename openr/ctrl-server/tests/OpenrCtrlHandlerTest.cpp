@@ -384,6 +384,12 @@ TEST_F(OpenrCtrlFixture, RouteApis) {
 TEST_F(OpenrCtrlFixture, PerfApis) {
   auto db = handler_->semifuture_getPerfDb().get();
   EXPECT_EQ(nodeName_, db->get_thisNodeName());
+
+  auto latencyStats = handler_->semifuture_getFibLatencyStats().get();
+  for (auto const& [stage, stats] : *latencyStats) {
+    EXPECT_LE(*stats.windowSize_ref(), *stats.count_ref()) << stage;
+    EXPECT_LE(*stats.p50_ref(), *stats.max_ref()) << stage;
+  }
 }
 
 TEST_F(OpenrCtrlFixture, DecisionApis) {
@@ -1963,6 +1969,13 @@ TEST_F(OpenrCtrlFixture, LinkMonitorApis) {
     EXPECT_EQ(1, reply->interfaceDetails_ref()->size());
   }
 
+  {
+    // flap dampening is not enabled
+    auto reply = handler_->semifuture_getFlapDampeningStates().get();
+    EXPECT_TRUE(reply->interfaces_ref()->empty());
+    EXPECT_TRUE(reply->adjacencies_ref()->empty());
+  }
+
   {
     auto ret = handler_->semifuture_getOpenrVersion().get();
     EXPECT_LE(*(ret->lowestSupportedVersion_ref()), *(ret->version_ref()));
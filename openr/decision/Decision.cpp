@@ -284,6 +284,21 @@ Decision::Decision(
     triggerInitialBuildRoutes();
   });
 
+  // Create graceful restart hold timer to apply updates of restarting nodes
+  // which didn't come back in time
+  if (auto holdMs = config->getConfig()
+                        .decision_config_ref()
+                        ->graceful_restart_hold_ms_ref()) {
+    grHoldTime_ = std::chrono::milliseconds(*holdMs);
+  }
+  gracefulRestartHoldTimer_ =
+      folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+        processGracefulRestartHoldTimeout();
+        if (pendingUpdates_.needsRouteUpdate()) {
+          rebuildRoutesDebounced_();
+        }
+      });
+
   // Create RibPolicy timer to process routes on policy expiry
   ribPolicyTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     XLOG(WARNING) << "RibPolicy is expired";
@@ -693,11 +708,9 @@ Decision::processPublication(thrift::Publication&& thriftPub) {
   CHECK(not thriftPub.area_ref()->empty());
   auto const& area = *thriftPub.area_ref();
 
-  auto it = areaLinkStates_.find(area);
-  if (it == areaLinkStates_.end()) {
-    it = areaLinkStates_.emplace(area, area).first;
+  if (not areaLinkStates_.count(area)) {
+    areaLinkStates_.emplace(area, area);
   }
-  auto& areaLinkState = it->second;
 
   // Nothing to process if no adj/prefix db changes
   if (thriftPub.keyVals_ref()->empty() and
@@ -722,27 +735,28 @@ Decision::processPublication(thrift::Publication&& thriftPub) {
         // Process adjacency to unblock Open/R initialization.
         updatePendingAdjacency(area, adjacencyDb);
 
-        // Filter adjacency that cannot be used by this node in route
-        // computation.
-        filterUnuseableAdjacency(adjacencyDb);
-
-        auto& nodeName = adjacencyDb.get_thisNodeName();
-        LinkStateMetric holdUpTtl = 0, holdDownTtl = 0;
-        // TODO: can we directly use area in AdjacencyDatabase?
-        adjacencyDb.area_ref() = area;
+        const auto nodeName = adjacencyDb.get_thisNodeName();
 
         // TODO: Is this useful?
         fb303::fbData->addStatValue("decision.adj_db_update", 1, fb303::COUNT);
-        pendingUpdates_.applyLinkStateChange(
-            nodeName,
-            areaLinkState.updateAdjacencyDatabase(
-                adjacencyDb, holdUpTtl, holdDownTtl),
-            adjacencyDb.perfEvents_ref());
+
+        // Restarting flags are tracked as received, even if update is held
+        updateGracefulRestartHolds(area, key, nodeName, adjacencyDb);
+        if (holdAdjacencyDbUpdate(area, key, nodeName, adjacencyDb)) {
+          continue;
+        }
+        applyAdjacencyDbUpdate(area, key, nodeName, std::move(adjacencyDb));
       } else if (key.find(Constants::kPrefixDbMarker.toString()) == 0) {
         // prefixDb: update keys starting with "prefix:"
         auto prefixDb = readThriftObjStr<thrift::PrefixDatabase>(
             rawVal.value_ref().value(), serializer_);
 
+        // Bucket key carries many prefixes of a node
+        if (PrefixKey::isPrefixBucketKey(key)) {
+          applyPrefixBucketUpdate(area, key, std::move(prefixDb));
+          continue;
+        }
+
         // We expect per prefix key, ignore if publication is still in old
         // format.
         if (1 != prefixDb.get_prefixEntries().size()) {
@@ -776,8 +790,8 @@ Decision::processPublication(thrift::Publication&& thriftPub) {
             "decision.prefix_db_update", 1, fb303::COUNT);
         pendingUpdates_.applyPrefixStateChange(
             prefixDb.get_deletePrefix()
-                ? prefixState_.deletePrefix(prefixKey)
-                : prefixState_.updatePrefix(prefixKey, entry),
+                ? deletePrefixKeySource(prefixKey)
+                : updatePrefixKeySource(prefixKey, entry),
             prefixDb.perfEvents_ref());
       }
     } catch (const std::exception& e) {
@@ -794,12 +808,17 @@ Decision::processPublication(thrift::Publication&& thriftPub) {
 
     if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
       // adjacencyDb: delete keys starting with "adj:"
-      pendingUpdates_.applyLinkStateChange(
-          nodeName,
-          areaLinkState.deleteAdjacencyDatabase(nodeName),
-          thrift::PrefixDatabase().perfEvents_ref()); // Empty perf events
+      updateGracefulRestartHolds(area, key, nodeName, std::nullopt);
+      if (holdAdjacencyDbUpdate(area, key, nodeName, std::nullopt)) {
+        continue;
+      }
+      applyAdjacencyDbUpdate(area, key, nodeName, std::nullopt);
     } else if (key.find(Constants::kPrefixDbMarker.toString()) == 0) {
       // prefixDb: delete keys starting with "prefix:"
+      if (PrefixKey::isPrefixBucketKey(key)) {
+        applyPrefixBucketUpdate(area, key, std::nullopt);
+        continue;
+      }
       auto maybePrefixKey = PrefixKey::fromStr(key, area);
       if (maybePrefixKey.hasError()) {
         // this is bad format of key.
@@ -810,10 +829,342 @@ Decision::processPublication(thrift::Publication&& thriftPub) {
         continue;
       }
       pendingUpdates_.applyPrefixStateChange(
-          prefixState_.deletePrefix(maybePrefixKey.value()),
+          deletePrefixKeySource(maybePrefixKey.value()),
+          thrift::PrefixDatabase().perfEvents_ref()); // Empty perf events
+    }
+  }
+}
+
+void
+Decision::applyPrefixBucketUpdate(
+    const std::string& area,
+    const std::string& key,
+    std::optional<thrift::PrefixDatabase> prefixDb) {
+  const auto nodeName =
+      prefixDb ? prefixDb->get_thisNodeName() : getNodeNameFromKey(key);
+  std::unordered_set<folly::CIDRNetwork> prefixes;
+  std::unordered_set<folly::CIDRNetwork> changed;
+
+  auto& areaBuckets = prefixBuckets_[area];
+  auto bucketIt = areaBuckets.find(key);
+  auto inBucket = [&](folly::CIDRNetwork const& prefix) {
+    return bucketIt != areaBuckets.end() and bucketIt->second.count(prefix);
+  };
+
+  if (prefixDb and not prefixDb->get_deletePrefix()) {
+    for (const auto& entry : prefixDb->get_prefixEntries()) {
+      auto const& areaStack = entry.get_area_stack();
+
+      // Ignore self redistributed route reflection
+      if (nodeName == myNodeName_ && areaStack.size() > 0 &&
+          areaLinkStates_.count(areaStack.back())) {
+        continue;
+      }
+
+      PrefixKey prefixKey(nodeName, toIPNetwork(entry.get_prefix()), area);
+      if (not inBucket(prefixKey.getCIDRNetwork())) {
+        addPrefixBucketSource(prefixKey);
+      }
+      changed.merge(prefixState_.updatePrefix(prefixKey, entry));
+      prefixes.emplace(prefixKey.getCIDRNetwork());
+    }
+  }
+
+  // Withdraw prefixes which are no longer in the bucket, unless node still
+  // advertises them with another key
+  if (bucketIt != areaBuckets.end()) {
+    for (const auto& prefix : bucketIt->second) {
+      if (not prefixes.count(prefix)) {
+        changed.merge(
+            deletePrefixBucketSource(PrefixKey(nodeName, prefix, area)));
+      }
+    }
+  }
+  if (prefixes.empty()) {
+    if (bucketIt != areaBuckets.end()) {
+      areaBuckets.erase(bucketIt);
+    }
+  } else {
+    areaBuckets[key] = std::move(prefixes);
+  }
+
+  fb303::fbData->addStatValue(
+      "decision.prefix_bucket_update", 1, fb303::COUNT);
+  if (prefixDb) {
+    pendingUpdates_.applyPrefixStateChange(
+        std::move(changed), prefixDb->perfEvents_ref());
+  } else {
+    pendingUpdates_.applyPrefixStateChange(
+        std::move(changed),
+        thrift::PrefixDatabase().perfEvents_ref()); // Empty perf events
+  }
+}
+
+std::unordered_set<folly::CIDRNetwork>
+Decision::updatePrefixKeySource(
+    PrefixKey const& prefixKey, thrift::PrefixEntry const& entry) {
+  auto it = bucketedPrefixSources_.find(prefixKey);
+  if (it != bucketedPrefixSources_.end()) {
+    it->second.hasPrefixKey = true;
+  }
+  return prefixState_.updatePrefix(prefixKey, entry);
+}
+
+std::unordered_set<folly::CIDRNetwork>
+Decision::deletePrefixKeySource(PrefixKey const& prefixKey) {
+  auto it = bucketedPrefixSources_.find(prefixKey);
+  if (it != bucketedPrefixSources_.end()) {
+    // Still advertised with bucket key
+    it->second.hasPrefixKey = false;
+    return {};
+  }
+  return prefixState_.deletePrefix(prefixKey);
+}
+
+void
+Decision::addPrefixBucketSource(PrefixKey const& prefixKey) {
+  auto [it, inserted] = bucketedPrefixSources_.try_emplace(prefixKey);
+  if (inserted) {
+    // Prefix already known from node is advertised with per prefix key, as
+    // prefixes of bucket keys are always tracked
+    auto prefixIt = prefixState_.prefixes().find(prefixKey.getCIDRNetwork());
+    it->second.hasPrefixKey = prefixIt != prefixState_.prefixes().end() and
+        prefixIt->second.count(prefixKey.getNodeAndArea());
+  }
+  ++it->second.numBuckets;
+}
+
+std::unordered_set<folly::CIDRNetwork>
+Decision::deletePrefixBucketSource(PrefixKey const& prefixKey) {
+  auto it = bucketedPrefixSources_.find(prefixKey);
+  if (it == bucketedPrefixSources_.end()) {
+    return prefixState_.deletePrefix(prefixKey);
+  }
+  if (--it->second.numBuckets > 0) {
+    // Still advertised with another bucket key
+    return {};
+  }
+  const bool hasPrefixKey = it->second.hasPrefixKey;
+  bucketedPrefixSources_.erase(it);
+  if (hasPrefixKey) {
+    // Still advertised with per prefix key
+    return {};
+  }
+  return prefixState_.deletePrefix(prefixKey);
+}
+
+void
+Decision::applyAdjacencyDbUpdate(
+    const std::string& area,
+    const std::string& key,
+    const std::string& nodeName,
+    std::optional<thrift::AdjacencyDatabase> adjacencyDb) {
+  auto& areaLinkState = areaLinkStates_.at(area);
+  const auto maybeAdjKey = parseAdjacencyKey(key);
+
+  if (not adjacencyDb.has_value()) {
+    if (maybeAdjKey.has_value()) {
+      // per adjacency key: withdraw single adjacency
+      const auto& [otherNodeName, ifName] = *maybeAdjKey;
+      pendingUpdates_.applyLinkStateChange(
+          nodeName,
+          areaLinkState.updateAdjacency(
+              nodeName, otherNodeName, ifName, std::nullopt),
+          thrift::PrefixDatabase().perfEvents_ref()); // Empty perf events
+    } else {
+      pendingUpdates_.applyLinkStateChange(
+          nodeName,
+          areaLinkState.deleteAdjacencyDatabase(nodeName),
           thrift::PrefixDatabase().perfEvents_ref()); // Empty perf events
     }
+    return;
+  }
+
+  // Filter adjacency that cannot be used by this node in route
+  // computation.
+  filterUnuseableAdjacency(*adjacencyDb);
+
+  LinkStateMetric holdUpTtl = 0, holdDownTtl = 0;
+  // TODO: can we directly use area in AdjacencyDatabase?
+  adjacencyDb->area_ref() = area;
+
+  // Per adjacency key carries single adjacency of the node, or none if
+  // adjacency is withdrawn
+  if (maybeAdjKey.has_value()) {
+    const auto& [otherNodeName, ifName] = *maybeAdjKey;
+    std::optional<thrift::Adjacency> adj;
+    if (not adjacencyDb->get_adjacencies().empty()) {
+      adj = adjacencyDb->get_adjacencies().front();
+    }
+    pendingUpdates_.applyLinkStateChange(
+        nodeName,
+        areaLinkState.updateAdjacency(
+            nodeName, otherNodeName, ifName, adj, holdUpTtl, holdDownTtl),
+        adjacencyDb->perfEvents_ref());
+    return;
+  }
+
+  pendingUpdates_.applyLinkStateChange(
+      nodeName,
+      areaLinkState.updateAdjacencyDatabase(
+          *adjacencyDb, holdUpTtl, holdDownTtl),
+      adjacencyDb->perfEvents_ref());
+}
+
+void
+Decision::updateGracefulRestartHolds(
+    const std::string& area,
+    const std::string& key,
+    const std::string& nodeName,
+    const std::optional<thrift::AdjacencyDatabase>& adjacencyDb) {
+  if (not grHoldTime_.has_value()) {
+    return;
+  }
+
+  // (restarting node, ifName) of adjacencies flagged by the neighbor
+  std::set<std::pair<std::string, std::string>> restartingAdjs;
+  if (adjacencyDb.has_value()) {
+    for (const auto& adj : adjacencyDb->get_adjacencies()) {
+      // Own adjacency database is never held
+      if (*adj.isRestarting_ref() and adj.get_otherNodeName() != myNodeName_) {
+        restartingAdjs.emplace(adj.get_otherNodeName(), adj.get_ifName());
+      }
+    }
+  }
+
+  // Per adjacency key only covers single adjacency of the neighbor
+  const auto maybeAdjKey = parseAdjacencyKey(key);
+  auto& areaHolds = gracefulRestartHolds_[area];
+
+  // Clear flags which are not advertised anymore
+  for (auto& [restartingNode, hold] : areaHolds) {
+    auto& adjs = hold.restartingAdjacencies;
+    for (auto it = adjs.begin(); it != adjs.end();) {
+      const auto& [neighbor, ifName] = *it;
+      if (neighbor == nodeName and
+          (not maybeAdjKey.has_value() or
+           *maybeAdjKey == std::make_pair(restartingNode, ifName)) and
+          not restartingAdjs.count(std::make_pair(restartingNode, ifName))) {
+        it = adjs.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // Start holds for newly reported restarting nodes
+  for (const auto& [restartingNode, ifName] : restartingAdjs) {
+    auto [it, inserted] = areaHolds.try_emplace(restartingNode);
+    if (inserted) {
+      XLOG(INFO) << fmt::format(
+          "[Graceful Restart] Holding adjacency database of node {} in area "
+          "{} for up to {}ms",
+          restartingNode,
+          area,
+          grHoldTime_->count());
+      it->second.holdUntil = std::chrono::steady_clock::now() + *grHoldTime_;
+      fb303::fbData->addStatValue("decision.gr_hold.started", 1, fb303::SUM);
+    }
+    it->second.restartingAdjacencies.emplace(nodeName, ifName);
+  }
+
+  // Release holds which are not reported by any neighbor anymore
+  for (auto it = areaHolds.begin(); it != areaHolds.end();) {
+    auto& [restartingNode, hold] = *it;
+    if (not hold.restartingAdjacencies.empty()) {
+      ++it;
+      continue;
+    }
+    XLOG(INFO) << fmt::format(
+        "[Graceful Restart] Node {} in area {} is back, releasing hold with "
+        "{} pending updates",
+        restartingNode,
+        area,
+        hold.pendingAdjDbs.size());
+    applyHeldAdjacencyDbUpdates(area, restartingNode, hold);
+    it = areaHolds.erase(it);
+  }
+
+  scheduleGracefulRestartHoldTimer();
+}
+
+bool
+Decision::holdAdjacencyDbUpdate(
+    const std::string& area,
+    const std::string& key,
+    const std::string& nodeName,
+    const std::optional<thrift::AdjacencyDatabase>& adjacencyDb) {
+  auto areaIt = gracefulRestartHolds_.find(area);
+  if (areaIt == gracefulRestartHolds_.end()) {
+    return false;
+  }
+  auto holdIt = areaIt->second.find(nodeName);
+  if (holdIt == areaIt->second.end() or holdIt->second.isExpired) {
+    return false;
+  }
+
+  holdIt->second.pendingAdjDbs.insert_or_assign(key, adjacencyDb);
+  fb303::fbData->addStatValue("decision.gr_hold.updates_held", 1, fb303::SUM);
+  return true;
+}
+
+void
+Decision::applyHeldAdjacencyDbUpdates(
+    const std::string& area,
+    const std::string& nodeName,
+    GracefulRestartHold& hold) {
+  for (auto& [key, adjacencyDb] : hold.pendingAdjDbs) {
+    applyAdjacencyDbUpdate(area, key, nodeName, std::move(adjacencyDb));
+  }
+  hold.pendingAdjDbs.clear();
+}
+
+void
+Decision::processGracefulRestartHoldTimeout() {
+  const auto now = std::chrono::steady_clock::now();
+  for (auto& [area, areaHolds] : gracefulRestartHolds_) {
+    for (auto& [restartingNode, hold] : areaHolds) {
+      if (hold.isExpired or hold.holdUntil > now) {
+        continue;
+      }
+      XLOG(WARNING) << fmt::format(
+          "[Graceful Restart] Hold of node {} in area {} expired, applying {} "
+          "pending updates",
+          restartingNode,
+          area,
+          hold.pendingAdjDbs.size());
+      applyHeldAdjacencyDbUpdates(area, restartingNode, hold);
+      hold.isExpired = true;
+      fb303::fbData->addStatValue("decision.gr_hold.expired", 1, fb303::SUM);
+    }
+  }
+  scheduleGracefulRestartHoldTimer();
+}
+
+void
+Decision::scheduleGracefulRestartHoldTimer() {
+  std::optional<std::chrono::steady_clock::time_point> nextExpiry;
+  int64_t numHeldNodes{0};
+  for (const auto& [area, areaHolds] : gracefulRestartHolds_) {
+    for (const auto& [restartingNode, hold] : areaHolds) {
+      if (hold.isExpired) {
+        continue;
+      }
+      ++numHeldNodes;
+      nextExpiry =
+          std::min(nextExpiry.value_or(hold.holdUntil), hold.holdUntil);
+    }
+  }
+
+  fb303::fbData->setCounter("decision.gr_hold.num_nodes", numHeldNodes);
+  if (not nextExpiry.has_value()) {
+    gracefulRestartHoldTimer_->cancelTimeout();
+    return;
   }
+  const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(
+      *nextExpiry - std::chrono::steady_clock::now());
+  gracefulRestartHoldTimer_->scheduleTimeout(
+      std::max(timeout, std::chrono::milliseconds(0)));
 }
 
 void
@@ -938,6 +1289,7 @@ Decision::rebuildRoutes(std::string const& event) {
   pendingUpdates_.reset();
 
   // send `DecisionRouteUpdate` to Fib/PrefixMgr
+  update.enqueueTime = std::chrono::steady_clock::now();
   routeUpdatesQueue_.push(std::move(update));
 }
 
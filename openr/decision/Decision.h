@@ -230,6 +230,96 @@ class Decision : public OpenrEventBase {
   // Trigger initial route build in OpenR initialization process.
   void triggerInitialBuildRoutes();
 
+  /*
+   * Apply adjacency database received with given adjacency key to link state
+   * of the area. std::nullopt withdraws adjacency database of the key.
+   */
+  void applyAdjacencyDbUpdate(
+      const std::string& area,
+      const std::string& key,
+      const std::string& nodeName,
+      std::optional<thrift::AdjacencyDatabase> adjacencyDb);
+
+  /*
+   * Apply prefix database received with given prefix bucket key, holding
+   * many prefixes of a node. Prefixes which are no longer in the bucket are
+   * withdrawn. std::nullopt withdraws all prefixes of the bucket.
+   */
+  void applyPrefixBucketUpdate(
+      const std::string& area,
+      const std::string& key,
+      std::optional<thrift::PrefixDatabase> prefixDb);
+
+  /*
+   * A node may advertise the same prefix with more than one key, e.g. per
+   * prefix key and bucket key while switching to bucket keys, or two bucket
+   * keys while changing number of buckets. Prefix is withdrawn only once no
+   * key advertises it anymore. Return changed prefixes.
+   */
+  std::unordered_set<folly::CIDRNetwork> updatePrefixKeySource(
+      PrefixKey const& prefixKey, thrift::PrefixEntry const& entry);
+  std::unordered_set<folly::CIDRNetwork> deletePrefixKeySource(
+      PrefixKey const& prefixKey);
+  void addPrefixBucketSource(PrefixKey const& prefixKey);
+  std::unordered_set<folly::CIDRNetwork> deletePrefixBucketSource(
+      PrefixKey const& prefixKey);
+
+  /*
+   * Graceful restart hold. Neighbors of a gracefully restarting node keep
+   * their adjacencies towards it and flag them with `isRestarting`. Adjacency
+   * database of the restarting node is held, i.e. its updates are buffered
+   * instead of applied, as long as any neighbor reports it as restarting but
+   * no longer than graceful_restart_hold_ms. This avoids two rounds of route
+   * computation for a node which is expected to come back as it was.
+   */
+  struct GracefulRestartHold {
+    // (neighbor, ifName) of adjacencies flagged as restarting
+    std::set<std::pair<std::string, std::string>> restartingAdjacencies;
+
+    // Latest adjacency database per adjacency key of the restarting node.
+    // std::nullopt stands for withdrawn key.
+    std::map<std::string, std::optional<thrift::AdjacencyDatabase>>
+        pendingAdjDbs;
+
+    // Time until which updates are held
+    std::chrono::steady_clock::time_point holdUntil;
+
+    // Set once hold time is over. Updates are no longer held, but hold is
+    // kept until neighbors clear the flag to not start it over.
+    bool isExpired{false};
+  };
+
+  /*
+   * Update graceful restart holds based on `isRestarting` flag of adjacencies
+   * advertised by `nodeName` with given adjacency key. Holds which are not
+   * reported by any neighbor anymore are released.
+   */
+  void updateGracefulRestartHolds(
+      const std::string& area,
+      const std::string& key,
+      const std::string& nodeName,
+      const std::optional<thrift::AdjacencyDatabase>& adjacencyDb);
+
+  /*
+   * Buffer adjacency database update of `nodeName` if node is held. Return
+   * true if update is held and must not be applied.
+   */
+  bool holdAdjacencyDbUpdate(
+      const std::string& area,
+      const std::string& key,
+      const std::string& nodeName,
+      const std::optional<thrift::AdjacencyDatabase>& adjacencyDb);
+
+  // Apply buffered adjacency database updates of the hold
+  void applyHeldAdjacencyDbUpdates(
+      const std::string& area,
+      const std::string& nodeName,
+      GracefulRestartHold& hold);
+
+  // Expire holds which are due and re-arm timer for the next one
+  void processGracefulRestartHoldTimeout();
+  void scheduleGracefulRestartHoldTimer();
+
   // node to prefix entries database for nodes advertising per prefix keys
   std::optional<thrift::PrefixDatabase> updateNodePrefixDatabase(
       const std::string& key, const thrift::PrefixDatabase& prefixDb);
@@ -269,6 +359,24 @@ class Decision : public OpenrEventBase {
   // Global prefix state
   PrefixState prefixState_;
 
+  // Prefixes of every received prefix bucket key, per area
+  std::unordered_map<
+      std::string /* area */,
+      std::unordered_map<
+          std::string /* key */,
+          std::unordered_set<folly::CIDRNetwork>>>
+      prefixBuckets_;
+
+  // Keys advertising prefixes of bucket keys. Tracked only for prefixes in
+  // bucket keys, as others come with a single per prefix key.
+  struct PrefixSources {
+    // Number of bucket keys advertising the prefix
+    size_t numBuckets{0};
+    // Whether per prefix key advertises the prefix as well
+    bool hasPrefixKey{false};
+  };
+  std::unordered_map<PrefixKey, PrefixSources> bucketedPrefixSources_;
+
   apache::thrift::CompactSerializer serializer_;
 
   // Base interval to submit to monitor with (jitter will be added)
@@ -283,6 +391,19 @@ class Decision : public OpenrEventBase {
   // this node's name and the key markers
   const std::string myNodeName_;
 
+  // Max time to hold adjacency database of a restarting node. Not set if
+  // graceful restart hold is disabled.
+  std::optional<std::chrono::milliseconds> grHoldTime_;
+
+  // Graceful restart holds per area and restarting node
+  std::unordered_map<
+      std::string,
+      std::unordered_map<std::string, GracefulRestartHold>>
+      gracefulRestartHolds_;
+
+  // Timer to expire graceful restart holds
+  std::unique_ptr<folly::AsyncTimeout> gracefulRestartHoldTimer_{nullptr};
+
   // store rebuildRoutes to-do status and perf events
   detail::DecisionPendingUpdates pendingUpdates_;
 
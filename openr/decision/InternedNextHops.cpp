@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <folly/Indestructible.h>
+#include <folly/hash/Hash.h>
+
+#include <openr/decision/InternedNextHops.h>
+
+namespace openr {
+
+namespace {
+
+/**
+ * Order independent hash of next-hop set. Element hashes are mixed before
+ * being summed to avoid cancellations among them.
+ */
+size_t
+hashNextHops(const InternedNextHops::NextHops& nexthops) {
+  size_t hash{nexthops.size()};
+  for (auto const& nexthop : nexthops) {
+    hash +=
+        folly::hash::twang_mix64(std::hash<thrift::NextHopThrift>()(nexthop));
+  }
+  return hash;
+}
+
+} // namespace
+
+folly::Synchronized<InternedNextHops::InternTable>&
+InternedNextHops::getInternTable() {
+  // NOTE: Intentionally leaked, as handles may outlive static destruction
+  static folly::Indestructible<folly::Synchronized<InternTable>> table;
+  return *table;
+}
+
+const std::shared_ptr<const InternedNextHops::Node>&
+InternedNextHops::getEmptyNode() {
+  static const folly::Indestructible<std::shared_ptr<const Node>> kEmpty{
+      std::make_shared<const Node>(NextHops{}, 0)};
+  return *kEmpty;
+}
+
+InternedNextHops::InternedNextHops() : node_(getEmptyNode()) {}
+
+InternedNextHops::InternedNextHops(NextHops nexthops)
+    : InternedNextHops() {
+  if (not nexthops.empty()) {
+    node_ = intern(std::move(nexthops));
+  }
+}
+
+size_t
+InternedNextHops::getNumInterned() {
+  size_t numInterned{0};
+  getInternTable().withRLock([&numInterned](auto const& table) {
+    for (auto const& [_, entries] : table) {
+      numInterned += entries.size();
+    }
+  });
+  return numInterned;
+}
+
+std::shared_ptr<const InternedNextHops::Node>
+InternedNextHops::intern(NextHops&& nexthops) {
+  const auto hash = hashNextHops(nexthops);
+
+  // NOTE: Non-matching entries locked during lookup are released after
+  // releasing the table lock. Releasing the last reference of an entry invokes
+  // its deleter, which acquires the table lock.
+  std::vector<std::shared_ptr<const Node>> mismatched;
+  std::shared_ptr<const Node> node;
+
+  getInternTable().withWLock([&](auto& table) {
+    auto& entries = table[hash];
+    for (auto const& entry : entries) {
+      auto existing = entry.lock();
+      if (not existing) {
+        continue; // Expired entry. Will be cleaned up by its deleter
+      }
+      if (existing->nexthops == nexthops) {
+        node = std::move(existing);
+        return;
+      }
+      mismatched.emplace_back(std::move(existing));
+    }
+
+    // Create new entry. Deleter removes it from the table
+    node = std::shared_ptr<const Node>(
+        new Node(std::move(nexthops), hash), [](const Node* expired) {
+          getInternTable().withWLock([expired](auto& table) {
+            auto it = table.find(expired->hash);
+            if (it != table.end()) {
+              auto& entries = it->second;
+              entries.erase(
+                  std::remove_if(
+                      entries.begin(),
+                      entries.end(),
+                      [](auto const& entry) { return entry.expired(); }),
+                  entries.end());
+              if (entries.empty()) {
+                table.erase(it);
+              }
+            }
+          });
+          delete expired;
+        });
+    entries.emplace_back(node);
+  });
+
+  return node;
+}
+
+} // namespace openr
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <folly/Synchronized.h>
+
+#include <openr/common/NetworkUtil.h>
+#include <openr/if/gen-cpp2/Network_types.h>
+
+namespace openr {
+
+/**
+ * Immutable, reference counted handle to an interned set of next-hops.
+ *
+ * Routes in a network commonly share very few distinct next-hop sets (e.g.
+ * all prefixes behind the same set of neighbors). Instead of each route
+ * holding its own copy, equal next-hop sets are de-duplicated in a process
+ * wide table and routes hold a shared handle to it. This
+ * - reduces memory for next-hops by orders of magnitude for large RIBs
+ * - makes copy of a route's next-hops a reference count increment
+ * - makes equality check of next-hops a pointer comparison
+ *
+ * An entry is removed from the table once the last handle referring to it
+ * is destroyed. Interning hashes and compares the given set, hence handles
+ * should be created once when route is computed and then copied around.
+ *
+ * NOTE: Creation and destruction of handles is thread-safe. Handles are
+ * shared by Decision, Fib and PrefixManager running in different threads.
+ */
+class InternedNextHops {
+ public:
+  using NextHops = std::unordered_set<thrift::NextHopThrift>;
+  using value_type = NextHops::value_type;
+  using const_iterator = NextHops::const_iterator;
+  using iterator = NextHops::const_iterator;
+  using size_type = NextHops::size_type;
+
+  // Empty next-hop set. Doesn't require any lookup in the intern table.
+  InternedNextHops();
+
+  /* implicit */ InternedNextHops(NextHops nexthops);
+
+  /* implicit */ InternedNextHops(
+      std::initializer_list<thrift::NextHopThrift> nexthops)
+      : InternedNextHops(NextHops(nexthops)) {}
+
+  InternedNextHops(const InternedNextHops&) = default;
+  InternedNextHops& operator=(const InternedNextHops&) = default;
+
+  // Moved-from handle refers to the empty next-hop set, hence remains valid
+  // to read like any other handle
+  InternedNextHops(InternedNextHops&& other) noexcept
+      : node_(std::exchange(other.node_, getEmptyNode())) {}
+
+  InternedNextHops&
+  operator=(InternedNextHops&& other) noexcept {
+    node_ = std::exchange(other.node_, getEmptyNode());
+    return *this;
+  }
+
+  const NextHops&
+  get() const {
+    return node_->nexthops;
+  }
+
+  const NextHops&
+  operator*() const {
+    return get();
+  }
+
+  const NextHops*
+  operator->() const {
+    return &get();
+  }
+
+  const_iterator
+  begin() const {
+    return get().begin();
+  }
+
+  const_iterator
+  end() const {
+    return get().end();
+  }
+
+  size_type
+  size() const {
+    return get().size();
+  }
+
+  bool
+  empty() const {
+    return get().empty();
+  }
+
+  size_type
+  count(const thrift::NextHopThrift& nexthop) const {
+    return get().count(nexthop);
+  }
+
+  // Equal next-hop sets are always interned to the same entry
+  friend bool
+  operator==(const InternedNextHops& lhs, const InternedNextHops& rhs) {
+    return lhs.node_ == rhs.node_;
+  }
+
+  friend bool
+  operator!=(const InternedNextHops& lhs, const InternedNextHops& rhs) {
+    return not(lhs == rhs);
+  }
+
+  /**
+   * Number of distinct non-empty next-hop sets currently interned
+   */
+  static size_t getNumInterned();
+
+ private:
+  struct Node {
+    Node(NextHops nexthops, size_t hash)
+        : nexthops(std::move(nexthops)), hash(hash) {}
+
+    const NextHops nexthops;
+    const size_t hash{0};
+  };
+
+  // Maps hash of next-hop set to interned entries with that hash
+  using InternTable = std::unordered_map<
+      size_t /* hash */,
+      std::vector<std::weak_ptr<const Node>>>;
+
+  static folly::Synchronized<InternTable>& getInternTable();
+
+  // Shared entry of the empty next-hop set. It is never added to the table
+  static const std::shared_ptr<const Node>& getEmptyNode();
+
+  static std::shared_ptr<const Node> intern(NextHops&& nexthops);
+
+  std::shared_ptr<const Node> node_;
+};
+
+} // namespace openr
@@ -586,13 +586,120 @@ LinkState::getOrderedLinkSet(const thrift::AdjacencyDatabase& adjDb) const {
   return links;
 }
 
+void
+LinkState::updateLinkAttributes(
+    const std::string& nodeName,
+    Link& oldLink,
+    const Link& newLink,
+    LinkStateMetric holdUpTtl,
+    LinkStateMetric holdDownTtl,
+    LinkStateChange& change) {
+  // change the metric on the link object we already have
+  if (newLink.getMetricFromNode(nodeName) !=
+      oldLink.getMetricFromNode(nodeName)) {
+    XLOG(DBG1) << fmt::format(
+        "[LINK UPDATE] Metric change on link {}, {} -> {}",
+        newLink.directionalToString(nodeName),
+        oldLink.getMetricFromNode(nodeName),
+        newLink.getMetricFromNode(nodeName));
+    change.topologyChanged |= oldLink.setMetricFromNode(
+        nodeName, newLink.getMetricFromNode(nodeName), holdUpTtl, holdDownTtl);
+  }
+
+  if (newLink.getOverloadFromNode(nodeName) !=
+      oldLink.getOverloadFromNode(nodeName)) {
+    XLOG(DBG1) << fmt::format(
+        "[LINK UPDATE] Overload change on link {}: {} -> {}",
+        newLink.directionalToString(nodeName),
+        oldLink.getOverloadFromNode(nodeName),
+        newLink.getOverloadFromNode(nodeName));
+    change.topologyChanged |= oldLink.setOverloadFromNode(
+        nodeName,
+        newLink.getOverloadFromNode(nodeName),
+        holdUpTtl,
+        holdDownTtl);
+  }
+
+  // Check if adjacency label has changed
+  if (newLink.getAdjLabelFromNode(nodeName) !=
+      oldLink.getAdjLabelFromNode(nodeName)) {
+    XLOG(DBG1) << fmt::format(
+        "[LINK UPDATE] AdjLabel change on link {}: {} => {}",
+        newLink.directionalToString(nodeName),
+        oldLink.getAdjLabelFromNode(nodeName),
+        newLink.getAdjLabelFromNode(nodeName));
+
+    change.linkAttributesChanged |= true;
+
+    // change the adjLabel on the link object we already have
+    oldLink.setAdjLabelFromNode(
+        nodeName, newLink.getAdjLabelFromNode(nodeName));
+  }
+
+  // Check if link weight has changed
+  if (newLink.getWeightFromNode(nodeName) !=
+      oldLink.getWeightFromNode(nodeName)) {
+    XLOG(DBG1) << folly::sformat(
+        "[LINK UPDATE] Weight change on link {}: {} => {}",
+        newLink.directionalToString(nodeName),
+        oldLink.getWeightFromNode(nodeName),
+        newLink.getWeightFromNode(nodeName));
+
+    change.linkAttributesChanged |= true;
+
+    // change the weight on the link object we already have
+    oldLink.setWeightFromNode(nodeName, newLink.getWeightFromNode(nodeName));
+  }
+
+  // check if local nextHops Changed
+  if (newLink.getNhV4FromNode(nodeName) !=
+      oldLink.getNhV4FromNode(nodeName)) {
+    XLOG(DBG1) << fmt::format(
+        "[LINK UPDATE] V4-NextHop address change on link {}: {} => {}",
+        newLink.directionalToString(nodeName),
+        toString(oldLink.getNhV4FromNode(nodeName)),
+        toString(newLink.getNhV4FromNode(nodeName)));
+
+    change.linkAttributesChanged |= true;
+    oldLink.setNhV4FromNode(nodeName, newLink.getNhV4FromNode(nodeName));
+  }
+  if (newLink.getNhV6FromNode(nodeName) !=
+      oldLink.getNhV6FromNode(nodeName)) {
+    XLOG(DBG1) << fmt::format(
+        "[LINK UPDATE] V6-NextHop address change on link {}: {} => {}",
+        newLink.directionalToString(nodeName),
+        toString(oldLink.getNhV6FromNode(nodeName)),
+        toString(newLink.getNhV6FromNode(nodeName)));
+
+    change.linkAttributesChanged |= true;
+    oldLink.setNhV6FromNode(nodeName, newLink.getNhV6FromNode(nodeName));
+  }
+}
+
 LinkState::LinkStateChange
 LinkState::updateAdjacencyDatabase(
-    thrift::AdjacencyDatabase const& newAdjacencyDb,
+    thrift::AdjacencyDatabase const& adjacencyDb,
     LinkStateMetric holdUpTtl,
     LinkStateMetric holdDownTtl) {
   LinkStateChange change;
-  auto const& nodeName = *newAdjacencyDb.thisNodeName_ref();
+  auto const& nodeName = *adjacencyDb.thisNodeName_ref();
+
+  // Node advertising per adjacency keys only carries node attributes in its
+  // adjacency database. Fill in adjacencies received with per adjacency keys.
+  std::optional<thrift::AdjacencyDatabase> mergedAdjacencyDb;
+  if (*adjacencyDb.perAdjacencyKeys_ref()) {
+    mergedAdjacencyDb = adjacencyDb;
+    mergedAdjacencyDb->adjacencies_ref()->clear();
+    auto it = perAdjacencies_.find(nodeName);
+    if (it != perAdjacencies_.end()) {
+      for (auto const& [_, adj] : it->second) {
+        mergedAdjacencyDb->adjacencies_ref()->emplace_back(adj);
+      }
+    }
+  }
+  auto const& newAdjacencyDb =
+      mergedAdjacencyDb.has_value() ? *mergedAdjacencyDb : adjacencyDb;
+
   XLOG(DBG1) << "Updating adjacency database for node " << nodeName << ", area "
              << *newAdjacencyDb.area_ref();
 
@@ -664,95 +771,113 @@ LinkState::updateAdjacencyDatabase(
     // The newIter and oldIter point to the same link. This link did not go up
     // or down. The topology may still have changed though if the link overlaod
     // or metric changed
-    auto& newLink = **newIter;
-    auto& oldLink = **oldIter;
-
-    // change the metric on the link object we already have
-    if (newLink.getMetricFromNode(nodeName) !=
-        oldLink.getMetricFromNode(nodeName)) {
-      XLOG(DBG1) << fmt::format(
-          "[LINK UPDATE] Metric change on link {}, {} -> {}",
-          newLink.directionalToString(nodeName),
-          oldLink.getMetricFromNode(nodeName),
-          newLink.getMetricFromNode(nodeName));
-      change.topologyChanged |= oldLink.setMetricFromNode(
-          nodeName,
-          newLink.getMetricFromNode(nodeName),
-          holdUpTtl,
-          holdDownTtl);
-    }
-
-    if (newLink.getOverloadFromNode(nodeName) !=
-        oldLink.getOverloadFromNode(nodeName)) {
-      XLOG(DBG1) << fmt::format(
-          "[LINK UPDATE] Overload change on link {}: {} -> {}",
-          newLink.directionalToString(nodeName),
-          oldLink.getOverloadFromNode(nodeName),
-          newLink.getOverloadFromNode(nodeName));
-      change.topologyChanged |= oldLink.setOverloadFromNode(
-          nodeName,
-          newLink.getOverloadFromNode(nodeName),
-          holdUpTtl,
-          holdDownTtl);
-    }
-
-    // Check if adjacency label has changed
-    if (newLink.getAdjLabelFromNode(nodeName) !=
-        oldLink.getAdjLabelFromNode(nodeName)) {
-      XLOG(DBG1) << fmt::format(
-          "[LINK UPDATE] AdjLabel change on link {}: {} => {}",
-          newLink.directionalToString(nodeName),
-          oldLink.getAdjLabelFromNode(nodeName),
-          newLink.getAdjLabelFromNode(nodeName));
+    updateLinkAttributes(
+        nodeName, **oldIter, **newIter, holdUpTtl, holdDownTtl, change);
+    ++newIter;
+    ++oldIter;
+  }
+  if (change.topologyChanged) {
+    spfResults_.clear();
+    kthPathResults_.clear();
+  }
+  return change;
+}
 
-      change.linkAttributesChanged |= true;
+LinkState::LinkStateChange
+LinkState::updateAdjacency(
+    const std::string& nodeName,
+    const std::string& otherNodeName,
+    const std::string& ifName,
+    std::optional<thrift::Adjacency> const& newAdj,
+    LinkStateMetric holdUpTtl,
+    LinkStateMetric holdDownTtl) {
+  LinkStateChange change;
+  XLOG(DBG1) << fmt::format(
+      "{} adjacency {}:{}->{} in area {}",
+      newAdj.has_value() ? "Updating" : "Withdrawing",
+      nodeName,
+      ifName,
+      otherNodeName,
+      area_);
+
+  if (newAdj.has_value() and
+      (*newAdj->otherNodeName_ref() != otherNodeName or
+       *newAdj->ifName_ref() != ifName)) {
+    XLOG(ERR) << fmt::format(
+        "Ignoring adjacency {}:{}->{} advertised with key of {}:{}->{}",
+        nodeName,
+        *newAdj->ifName_ref(),
+        *newAdj->otherNodeName_ref(),
+        nodeName,
+        ifName,
+        otherNodeName);
+    return change;
+  }
 
-      // change the adjLabel on the link object we already have
-      oldLink.setAdjLabelFromNode(
-          nodeName, newLink.getAdjLabelFromNode(nodeName));
+  // Record adjacency, so that it is applied whenever node key is received
+  const auto adjKey = std::make_pair(otherNodeName, ifName);
+  if (newAdj.has_value()) {
+    perAdjacencies_[nodeName][adjKey] = *newAdj;
+  } else {
+    auto it = perAdjacencies_.find(nodeName);
+    if (it != perAdjacencies_.end()) {
+      it->second.erase(adjKey);
+      if (it->second.empty()) {
+        perAdjacencies_.erase(it);
+      }
     }
+  }
 
-    // Check if link weight has changed
-    if (newLink.getWeightFromNode(nodeName) !=
-        oldLink.getWeightFromNode(nodeName)) {
-      XLOG(DBG1) << folly::sformat(
-          "[LINK UPDATE] Weight change on link {}: {} => {}",
-          newLink.directionalToString(nodeName),
-          oldLink.getWeightFromNode(nodeName),
-          newLink.getWeightFromNode(nodeName));
-
-      change.linkAttributesChanged |= true;
+  // Apply to link state only if node is known to advertise per adjacency keys
+  auto dbIt = adjacencyDatabases_.find(nodeName);
+  if (dbIt == adjacencyDatabases_.end() or
+      not *dbIt->second.perAdjacencyKeys_ref()) {
+    return change;
+  }
 
-      // change the weight on the link object we already have
-      oldLink.setWeightFromNode(nodeName, newLink.getWeightFromNode(nodeName));
+  // Replace adjacency in node's adjacency database and find its link if any
+  auto& adjs = *dbIt->second.adjacencies_ref();
+  auto adjIt = std::find_if(adjs.begin(), adjs.end(), [&](auto const& adj) {
+    return *adj.otherNodeName_ref() == otherNodeName and
+        *adj.ifName_ref() == ifName;
+  });
+  std::shared_ptr<Link> oldLink{nullptr};
+  if (adjIt != adjs.end()) {
+    auto const& links = linksFromNode(nodeName);
+    auto linkIt = links.find(std::make_shared<Link>(
+        area_, nodeName, ifName, otherNodeName, *adjIt->otherIfName_ref()));
+    if (linkIt != links.end()) {
+      oldLink = *linkIt;
     }
+    if (newAdj.has_value()) {
+      *adjIt = *newAdj;
+    } else {
+      adjs.erase(adjIt);
+    }
+  } else if (newAdj.has_value()) {
+    adjs.emplace_back(*newAdj);
+  }
 
-    // check if local nextHops Changed
-    if (newLink.getNhV4FromNode(nodeName) !=
-        oldLink.getNhV4FromNode(nodeName)) {
-      XLOG(DBG1) << fmt::format(
-          "[LINK UPDATE] V4-NextHop address change on link {}: {} => {}",
-          newLink.directionalToString(nodeName),
-          toString(oldLink.getNhV4FromNode(nodeName)),
-          toString(newLink.getNhV4FromNode(nodeName)));
-
-      change.linkAttributesChanged |= true;
-      oldLink.setNhV4FromNode(nodeName, newLink.getNhV4FromNode(nodeName));
+  auto newLink =
+      newAdj.has_value() ? maybeMakeLink(nodeName, *newAdj) : nullptr;
+  if (oldLink and newLink and *oldLink == *newLink) {
+    updateLinkAttributes(
+        nodeName, *oldLink, *newLink, holdUpTtl, holdDownTtl, change);
+  } else {
+    if (oldLink) {
+      change.topologyChanged |= oldLink->isUp();
+      removeLink(oldLink);
+      XLOG(DBG1) << "[LINK DOWN] " << oldLink->toString();
     }
-    if (newLink.getNhV6FromNode(nodeName) !=
-        oldLink.getNhV6FromNode(nodeName)) {
-      XLOG(DBG1) << fmt::format(
-          "[LINK UPDATE] V6-NextHop address change on link {}: {} => {}",
-          newLink.directionalToString(nodeName),
-          toString(oldLink.getNhV6FromNode(nodeName)),
-          toString(newLink.getNhV6FromNode(nodeName)));
-
-      change.linkAttributesChanged |= true;
-      oldLink.setNhV6FromNode(nodeName, newLink.getNhV6FromNode(nodeName));
+    if (newLink) {
+      newLink->setHoldUpTtl(holdUpTtl);
+      change.topologyChanged |= newLink->isUp();
+      addLink(newLink);
+      change.addedLinks.emplace_back(newLink);
+      XLOG(DBG1) << "[LINK UP]" << newLink->toString();
     }
-    ++newIter;
-    ++oldIter;
   }
+
   if (change.topologyChanged) {
     spfResults_.clear();
     kthPathResults_.clear();
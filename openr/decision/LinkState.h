@@ -8,8 +8,10 @@
 #pragma once
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -420,6 +422,17 @@ class LinkState {
       LinkStateMetric holdUpTtl = 0,
       LinkStateMetric holdDownTtl = 0);
 
+  // update or withdraw (if `adj` is std::nullopt) single adjacency of the
+  // given router, as advertised with per adjacency key. Only applied if
+  // router's adjacency database has `perAdjacencyKeys` set.
+  LinkStateChange updateAdjacency(
+      const std::string& nodeName,
+      const std::string& otherNodeName,
+      const std::string& ifName,
+      std::optional<thrift::Adjacency> const& adj,
+      LinkStateMetric holdUpTtl = 0,
+      LinkStateMetric holdDownTtl = 0);
+
   // delete a node's adjacency database
   // return true if this has caused any change in graph
   LinkStateChange deleteAdjacencyDatabase(const std::string& nodeName);
@@ -506,6 +519,15 @@ class LinkState {
 
   void removeNode(const std::string& nodeName);
 
+  // apply attribute changes of the same link advertised by nodeName
+  void updateLinkAttributes(
+      const std::string& nodeName,
+      Link& oldLink,
+      const Link& newLink,
+      LinkStateMetric holdUpTtl,
+      LinkStateMetric holdDownTtl,
+      LinkStateChange& change);
+
   bool updateNodeOverloaded(
       const std::string& nodeName,
       bool isOverloaded,
@@ -546,6 +568,14 @@ class LinkState {
   std::unordered_map<std::string, thrift::AdjacencyDatabase>
       adjacencyDatabases_;
 
+  // adjacencies received with per adjacency keys from each node
+  std::unordered_map<
+      std::string /* nodeName */,
+      std::map<
+          std::pair<std::string /* otherNodeName */, std::string /* ifName */>,
+          thrift::Adjacency>>
+      perAdjacencies_;
+
 }; // class LinkState
 
 // Classes needed for running Dijkstra to build an SPF graph starting at a root
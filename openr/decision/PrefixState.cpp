@@ -17,16 +17,19 @@ PrefixState::updatePrefix(
     PrefixKey const& key, thrift::PrefixEntry const& entry) {
   std::unordered_set<folly::CIDRNetwork> changed;
 
-  auto [it, inserted] = prefixes_[key.getCIDRNetwork()].emplace(
-      key.getNodeAndArea(), std::make_shared<thrift::PrefixEntry>(entry));
+  auto& prefixEntries = prefixes_[key.getCIDRNetwork()];
+  auto it = prefixEntries.find(key.getNodeAndArea());
 
   // Skip rest of code, if prefix exists and has no change
-  if (not inserted && *it->second == entry) {
+  if (it != prefixEntries.end() and *it->second == entry) {
     return changed;
   }
-  // Update prefix
-  if (not inserted) {
-    it->second = std::make_shared<thrift::PrefixEntry>(entry);
+  // Add or update prefix
+  auto entryPtr = getSharedEntry(prefixEntries, entry);
+  if (it == prefixEntries.end()) {
+    prefixEntries.emplace(key.getNodeAndArea(), std::move(entryPtr));
+  } else {
+    it->second = std::move(entryPtr);
   }
   changed.insert(key.getCIDRNetwork());
 
@@ -57,6 +60,20 @@ PrefixState::deletePrefix(PrefixKey const& key) {
   return changed;
 }
 
+std::shared_ptr<thrift::PrefixEntry>
+PrefixState::getSharedEntry(
+    PrefixEntries const& prefixEntries, thrift::PrefixEntry const& entry) {
+  // Announcers of a prefix (e.g. anycast or aggregate) commonly advertise it
+  // with identical attributes. Entries are never mutated once stored, hence
+  // such announcements can share the same instance.
+  for (auto const& [_, existingEntry] : prefixEntries) {
+    if (*existingEntry == entry) {
+      return existingEntry;
+    }
+  }
+  return std::make_shared<thrift::PrefixEntry>(entry);
+}
+
 std::vector<thrift::ReceivedRouteDetail>
 PrefixState::getReceivedRoutesFiltered(
     thrift::ReceivedRouteFilter const& filter) const {
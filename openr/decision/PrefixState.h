@@ -55,6 +55,11 @@ class PrefixState {
   static bool hasConflictingForwardingInfo(PrefixEntries const& prefixEntries);
 
  private:
+  // Return entry instance to store for an announcement of prefix. Instance is
+  // shared with other announcer of the same prefix if their entries are equal.
+  static std::shared_ptr<thrift::PrefixEntry> getSharedEntry(
+      PrefixEntries const& prefixEntries, thrift::PrefixEntry const& entry);
+
   // TODO: Also maintain clean list of reachable prefix entries. A node might
   // become un-reachable we might still have their prefix entries, until gets
   // expired in KvStore. This will simplify logic in route computation where
@@ -62,6 +67,8 @@ class PrefixState {
 
   // Data structure to maintain mapping from:
   //  IpPrefix -> collection of originator(i.e. [node, area] combination)
+  // Entries of a prefix are stored contiguously and handed over as is to
+  // route computation.
   std::unordered_map<folly::CIDRNetwork, PrefixEntries> prefixes_;
 };
 } // namespace openr
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -14,6 +15,7 @@
 
 #include <folly/IPAddress.h>
 #include <openr/common/NetworkUtil.h>
+#include <openr/decision/InternedNextHops.h>
 #include <openr/if/gen-cpp2/Network_types.h>
 #include <openr/if/gen-cpp2/OpenrCtrl.h>
 #include <openr/if/gen-cpp2/Types_types.h>
@@ -22,15 +24,15 @@ namespace openr {
 
 struct RibEntry {
   // TODO: should this be map<area, nexthops>?
-  std::unordered_set<thrift::NextHopThrift> nexthops;
+  // NOTE: Next-hops are interned and shared among routes. Comparison is a
+  // pointer compare. Assign a new set to modify them.
+  InternedNextHops nexthops;
 
   // igp cost of all routes (ecmp) or of lowest cost route (if ucmp)
   unsigned int igpCost;
 
   // constructor
-  explicit RibEntry(
-      std::unordered_set<thrift::NextHopThrift> nexthops,
-      unsigned int igpCost = 0)
+  explicit RibEntry(InternedNextHops nexthops, unsigned int igpCost = 0)
       : nexthops(std::move(nexthops)), igpCost(igpCost) {}
 
   RibEntry() = default;
@@ -50,19 +52,22 @@ struct RibUnicastEntry : RibEntry {
   // Counter Id assigned to this route. Assignment comes from the
   // RibPolicyStatement that matches to this route.
   std::optional<thrift::RouteCounterID> counterID{std::nullopt};
+  // Entry of PrefixState which `bestPrefixEntry` is copied from, if any.
+  // Entries of PrefixState are never mutated, hence routes built from the
+  // same one can be compared by pointer. Must be reset if `bestPrefixEntry`
+  // is modified.
+  std::shared_ptr<const thrift::PrefixEntry> bestPrefixEntrySource{nullptr};
 
   // constructor
   explicit RibUnicastEntry() {}
   explicit RibUnicastEntry(const folly::CIDRNetwork& prefix) : prefix(prefix) {}
 
-  RibUnicastEntry(
-      const folly::CIDRNetwork& prefix,
-      std::unordered_set<thrift::NextHopThrift> nexthops)
+  RibUnicastEntry(const folly::CIDRNetwork& prefix, InternedNextHops nexthops)
       : RibEntry(std::move(nexthops)), prefix(prefix) {}
 
   RibUnicastEntry(
       const folly::CIDRNetwork& prefix,
-      std::unordered_set<thrift::NextHopThrift> nexthops,
+      InternedNextHops nexthops,
       thrift::PrefixEntry bestPrefixEntryThrift,
       const std::string& bestArea,
       bool doNotInstall = false,
@@ -76,11 +81,44 @@ struct RibUnicastEntry : RibEntry {
     bestPrefixEntry.weight_ref().from_optional(ucmpWeight);
   }
 
+  RibUnicastEntry(
+      const folly::CIDRNetwork& prefix,
+      InternedNextHops nexthops,
+      std::shared_ptr<const thrift::PrefixEntry> bestPrefixEntrySource,
+      const std::string& bestArea,
+      bool doNotInstall = false,
+      unsigned int igpCost = 0,
+      const std::optional<int64_t>& ucmpWeight = std::nullopt)
+      : RibUnicastEntry(
+            prefix,
+            std::move(nexthops),
+            *bestPrefixEntrySource,
+            bestArea,
+            doNotInstall,
+            igpCost,
+            ucmpWeight) {
+    this->bestPrefixEntrySource = std::move(bestPrefixEntrySource);
+  }
+
+  // NOTE: Cheap comparisons go first. Field-wise comparison of
+  // `bestPrefixEntry` is only reached if everything else matches, and
+  // neither if both are copied from the same PrefixState entry.
   bool
   operator==(const RibUnicastEntry& other) const {
-    return prefix == other.prefix && bestPrefixEntry == other.bestPrefixEntry &&
-        doNotInstall == other.doNotInstall && counterID == other.counterID &&
-        RibEntry::operator==(other);
+    return RibEntry::operator==(other) && doNotInstall == other.doNotInstall &&
+        counterID == other.counterID && prefix == other.prefix &&
+        isBestPrefixEntryEqual(other);
+  }
+
+  bool
+  isBestPrefixEntryEqual(const RibUnicastEntry& other) const {
+    // Copies of the same entry may only differ in ucmp weight
+    if (bestPrefixEntrySource and
+        bestPrefixEntrySource == other.bestPrefixEntrySource) {
+      return bestPrefixEntry.weight_ref().to_optional() ==
+          other.bestPrefixEntry.weight_ref().to_optional();
+    }
+    return bestPrefixEntry == other.bestPrefixEntry;
   }
 
   bool
@@ -116,8 +154,7 @@ struct RibMplsEntry : RibEntry {
 
   // constructor
   explicit RibMplsEntry() {}
-  RibMplsEntry(
-      int32_t label, std::unordered_set<thrift::NextHopThrift> nexthops)
+  RibMplsEntry(int32_t label, InternedNextHops nexthops)
       : RibEntry(std::move(nexthops)), label(label) {}
 
   static RibMplsEntry
@@ -183,13 +220,15 @@ struct RibMplsEntry : RibEntry {
     }
 
     // Filter nexthop that do not match selected MPLS action
-    for (auto it = nexthops.begin(); it != nexthops.end();) {
-      if (mplsActionCode != *it->mplsAction_ref()->action_ref()) {
-        it = nexthops.erase(it);
-      } else {
-        ++it;
+    std::unordered_set<thrift::NextHopThrift> filteredNexthops;
+    for (auto const& nextHop : nexthops) {
+      if (mplsActionCode == *nextHop.mplsAction_ref()->action_ref()) {
+        filteredNexthops.emplace(nextHop);
       }
     }
+    if (filteredNexthops.size() != nexthops.size()) {
+      nexthops = std::move(filteredNexthops);
+    }
   }
 };
 } // namespace openr
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <sstream>
 
 #include <folly/IPAddress.h>
@@ -54,6 +55,11 @@ struct DecisionRouteUpdate {
   // Optional perf events associated with this route update
   std::optional<thrift::PerfEvents> perfEvents{std::nullopt};
 
+  // Optional time at which the producer enqueued this route update. Used by
+  // consumer to measure the queueing delay.
+  std::optional<std::chrono::steady_clock::time_point> enqueueTime{
+      std::nullopt};
+
   bool
   empty() const {
     return (
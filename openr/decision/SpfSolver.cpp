@@ -25,8 +25,12 @@ DecisionRouteDb::calculateUpdate(DecisionRouteDb&& newDb) const {
   DecisionRouteUpdate delta;
 
   // unicastRoutesToUpdate
+  size_t numRetainedUnicastRoutes{0};
   for (auto& [prefix, entry] : newDb.unicastRoutes) {
     const auto& search = unicastRoutes.find(prefix);
+    if (search != unicastRoutes.end()) {
+      ++numRetainedUnicastRoutes;
+    }
     if (search == unicastRoutes.end() || search->second != entry) {
       // new prefix, or prefix entry changed
       delta.addRouteToUpdate(std::move(entry));
@@ -34,24 +38,34 @@ DecisionRouteDb::calculateUpdate(DecisionRouteDb&& newDb) const {
   }
 
   // unicastRoutesToDelete
-  for (auto const& [prefix, _] : unicastRoutes) {
-    if (!newDb.unicastRoutes.count(prefix)) {
-      delta.unicastRoutesToDelete.emplace_back(prefix);
+  // NOTE: Skip lookups if all of existing prefixes are retained, which is the
+  // common case on rebuild of large route database.
+  if (numRetainedUnicastRoutes != unicastRoutes.size()) {
+    for (auto const& [prefix, _] : unicastRoutes) {
+      if (!newDb.unicastRoutes.count(prefix)) {
+        delta.unicastRoutesToDelete.emplace_back(prefix);
+      }
     }
   }
 
   // mplsRoutesToUpdate
+  size_t numRetainedMplsRoutes{0};
   for (auto& [label, entry] : newDb.mplsRoutes) {
     const auto& search = mplsRoutes.find(label);
+    if (search != mplsRoutes.end()) {
+      ++numRetainedMplsRoutes;
+    }
     if (search == mplsRoutes.end() || search->second != entry) {
       delta.addMplsRouteToUpdate(std::move(entry));
     }
   }
 
   // mplsRoutesToDelete
-  for (auto const& [label, _] : mplsRoutes) {
-    if (!newDb.mplsRoutes.count(label)) {
-      delta.mplsRoutesToDelete.emplace_back(label);
+  if (numRetainedMplsRoutes != mplsRoutes.size()) {
+    for (auto const& [label, _] : mplsRoutes) {
+      if (!newDb.mplsRoutes.count(label)) {
+        delta.mplsRoutesToDelete.emplace_back(label);
+      }
     }
   }
   return delta;
@@ -214,6 +228,7 @@ SpfSolver::createRouteForPrefix(
 
   auto search = prefixState.prefixes().find(prefix);
   if (search == prefixState.prefixes().end()) {
+    eraseRouteSelection(prefix);
     return std::nullopt;
   }
   auto const& allPrefixEntries = search->second;
@@ -222,28 +237,37 @@ SpfSolver::createRouteForPrefix(
   bestRoutesCache_.erase(prefix);
 
   //
-  // Create list of prefix-entries from reachable nodes only
-  // NOTE: We're copying prefix-entries and it can be expensive. Using
-  // pointers for storing prefix information can be efficient (CPU & Memory)
+  // Create list of prefix-entries from reachable nodes only. Commonly all of
+  // the advertising nodes are reachable, in which case entries in prefix
+  // state are handed over as is. Filtered copy is made only otherwise.
   //
-  auto prefixEntries = folly::copy(allPrefixEntries);
-  for (auto& [area, linkState] : areaLinkStates) {
-    auto const& mySpfResult = linkState.getSpfResult(myNodeName);
-
-    // Delete entries of unreachable nodes from prefixEntries
-    for (auto it = prefixEntries.cbegin(); it != prefixEntries.cend();) {
-      const auto& [prefixNode, prefixArea] = it->first;
-      // Only check reachability within the area that prefixNode belongs to.
-      if (area != prefixArea || mySpfResult.count(prefixNode)) {
-        ++it; // retain
-      } else {
-        it = prefixEntries.erase(it); // erase the unreachable prefix entry
+  auto isReachable = [&](NodeAndArea const& nodeAndArea) {
+    const auto& [prefixNode, prefixArea] = nodeAndArea;
+    auto linkStateIt = areaLinkStates.find(prefixArea);
+    // Only check reachability within the area that prefixNode belongs to.
+    return linkStateIt == areaLinkStates.end() or
+        linkStateIt->second.getSpfResult(myNodeName).count(prefixNode);
+  };
+  std::optional<PrefixEntries> reachablePrefixEntries;
+  for (auto it = allPrefixEntries.cbegin(); it != allPrefixEntries.cend();
+       ++it) {
+    const bool reachable = isReachable(it->first);
+    if (reachablePrefixEntries.has_value()) {
+      if (reachable) {
+        reachablePrefixEntries->insert(reachablePrefixEntries->end(), *it);
       }
+    } else if (not reachable) {
+      // first unreachable entry, copy over the reachable ones seen so far
+      reachablePrefixEntries.emplace(allPrefixEntries.cbegin(), it);
     }
   }
+  auto const& prefixEntries = reachablePrefixEntries.has_value()
+      ? reachablePrefixEntries.value()
+      : allPrefixEntries;
 
   // Skip if no valid prefixes
   if (prefixEntries.empty()) {
+    eraseRouteSelection(prefix);
     XLOG(DBG3) << "Skipping route to "
                << folly::IPAddress::networkToString(prefix)
                << " with no reachable node.";
@@ -485,6 +509,17 @@ SpfSolver::buildRouteDb(
     }
   }
 
+  // Drop memoized route selection of prefixes which are no longer announced
+  for (auto it = routeSelectionCache_.begin();
+       it != routeSelectionCache_.end();) {
+    if (prefixState.prefixes().count(it->first)) {
+      ++it;
+    } else {
+      clearRouteSelectionInputs(it->second);
+      it = routeSelectionCache_.erase(it);
+    }
+  }
+
   // Create static unicast routes
   for (auto [prefix, ribUnicastEntry] : staticUnicastRoutes_) {
     if (routeDb.unicastRoutes.count(prefix)) {
@@ -652,6 +687,37 @@ SpfSolver::selectBestRoutes(
     bool const isBgp,
     std::unordered_map<std::string, LinkState> const& areaLinkStates) {
   CHECK(prefixEntries.size()) << "No prefixes for best route selection";
+
+  //
+  // Previous selection is reused if none of its inputs, i.e. reachable
+  // announcers, their entries and drain state changed, e.g. on rebuild
+  // triggered by topology change only. Entries are compared by address, as
+  // announcers of a prefix share identical entries.
+  //
+  auto isOverloaded = [&](NodeAndArea const& nodeAndArea) {
+    auto linkStateIt = areaLinkStates.find(nodeAndArea.second);
+    return linkStateIt != areaLinkStates.end() and
+        linkStateIt->second.isNodeOverloaded(nodeAndArea.first);
+  };
+  auto& cacheEntry = routeSelectionCache_[prefix];
+  if (cacheEntry.myNodeName == myNodeName and
+      std::equal(
+          cacheEntry.inputs.cbegin(),
+          cacheEntry.inputs.cend(),
+          prefixEntries.cbegin(),
+          prefixEntries.cend(),
+          [&](auto const& input, auto const& entry) {
+            return input.prefixEntry == entry.second and
+                *input.nodeAndArea == entry.first and
+                input.isOverloaded == isOverloaded(entry.first);
+          })) {
+    fb303::fbData->addStatValue(
+        "decision.route_selection_cache_hits", 1, fb303::COUNT);
+    return cacheEntry.result;
+  }
+  fb303::fbData->addStatValue(
+      "decision.route_selection_cache_misses", 1, fb303::COUNT);
+
   RouteSelectionResult ret;
 
   if (enableBestRouteSelection_) {
@@ -671,7 +737,39 @@ SpfSolver::selectBestRoutes(
     ret.success = true;
   }
 
-  return maybeFilterDrainedNodes(std::move(ret), areaLinkStates);
+  ret = maybeFilterDrainedNodes(std::move(ret), areaLinkStates);
+
+  cacheEntry.myNodeName = myNodeName;
+  clearRouteSelectionInputs(cacheEntry);
+  cacheEntry.inputs.reserve(prefixEntries.size());
+  for (auto const& [nodeAndArea, prefixEntry] : prefixEntries) {
+    auto nodeAreaIt = routeSelectionNodeAreas_.try_emplace(nodeAndArea).first;
+    ++nodeAreaIt->second;
+    cacheEntry.inputs.emplace_back(RouteSelectionInput{
+        &nodeAreaIt->first, prefixEntry, isOverloaded(nodeAndArea)});
+  }
+  cacheEntry.result = ret;
+  return ret;
+}
+
+void
+SpfSolver::eraseRouteSelection(folly::CIDRNetwork const& prefix) {
+  auto it = routeSelectionCache_.find(prefix);
+  if (it != routeSelectionCache_.end()) {
+    clearRouteSelectionInputs(it->second);
+    routeSelectionCache_.erase(it);
+  }
+}
+
+void
+SpfSolver::clearRouteSelectionInputs(RouteSelectionCacheEntry& cacheEntry) {
+  for (auto const& input : cacheEntry.inputs) {
+    auto nodeAreaIt = routeSelectionNodeAreas_.find(*input.nodeAndArea);
+    if (--nodeAreaIt->second == 0) {
+      routeSelectionNodeAreas_.erase(nodeAreaIt);
+    }
+  }
+  cacheEntry.inputs.clear();
 }
 
 void
@@ -1032,7 +1130,7 @@ SpfSolver::addBestPaths(
   return RibUnicastEntry(
       prefix,
       std::move(nextHops),
-      *(prefixEntries.at(routeSelectionResult.bestNodeArea)),
+      prefixEntries.at(routeSelectionResult.bestNodeArea),
       routeSelectionResult.bestNodeArea.second,
       isBgp & (not enableBgpRouteProgramming_), // doNotInstall
       shortestMetric,
@@ -231,6 +231,9 @@ class SpfSolver {
       bool const hasBgp,
       std::unordered_map<std::string, LinkState> const& areaLinkStates);
 
+  // Drop memoized best route selection of the prefix
+  void eraseRouteSelection(folly::CIDRNetwork const& prefix);
+
   /**
    * Extend selected routes from received route announcements of one prefix,
    * assuming that the best routes are already selected, and following the
@@ -311,6 +314,33 @@ class SpfSolver {
   // - Updated for the prefix whenever a route is created for it
   std::unordered_map<folly::CIDRNetwork, RouteSelectionResult> bestRoutesCache_;
 
+  // Memoized best route selection of a prefix along with its inputs, i.e.
+  // reachable announcers, their entries and drain state. Unlike
+  // `bestRoutesCache_`, it is kept across topology changes. Entries of
+  // withdrawn prefixes are dropped, hence it never outgrows PrefixState.
+  struct RouteSelectionInput {
+    // Key of `routeSelectionNodeAreas_`, hence not copied per prefix
+    NodeAndArea const* nodeAndArea{nullptr};
+    // Held to keep entry alive, hence its address can't be reused
+    std::shared_ptr<thrift::PrefixEntry> prefixEntry;
+    bool isOverloaded{false};
+  };
+  struct RouteSelectionCacheEntry {
+    std::string myNodeName;
+    std::vector<RouteSelectionInput> inputs;
+    RouteSelectionResult result;
+  };
+  std::unordered_map<folly::CIDRNetwork, RouteSelectionCacheEntry>
+      routeSelectionCache_;
+
+  // Announcers referred by inputs of `routeSelectionCache_`, along with number
+  // of inputs referring to them. Node based map, hence keys have stable
+  // addresses.
+  std::unordered_map<NodeAndArea, size_t> routeSelectionNodeAreas_;
+
+  // Drop inputs of memoized route selection, releasing announcers they refer
+  void clearRouteSelectionInputs(RouteSelectionCacheEntry& cacheEntry);
+
   const std::string myNodeName_;
 
   // is v4 enabled. If yes then Decision will forward v4 prefixes with v4
@@ -461,6 +461,23 @@ BENCHMARK_COUNTERS_PARAM3(
     100,
     100,
     SP_ECMP);
+
+/*
+ * BM_PrefixStateAnnouncements:
+ * @first param - integer: num of prefixes
+ * @second param - integer: num of announcers per prefix
+ *
+ * Measures memory footprint of prefix state, i.e. how many bytes does
+ * Decision hold per received prefix announcement.
+ */
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixStateAnnouncements, counters, 10000_4, 10000, 4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixStateAnnouncements, counters, 100000_4, 100000, 4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixStateAnnouncements, counters, 300000_4, 300000, 4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixStateAnnouncements, counters, 10000_64, 10000, 64);
 } // namespace openr
 
 int
@@ -747,6 +747,223 @@ TEST(SpfSolver, AdjacencyUpdate) {
   }
 }
 
+/**
+ * Verifies best route selection of a prefix is reused across route builds,
+ * unless its announcements or drain state of announcers change
+ */
+TEST(SpfSolver, RouteSelectionCache) {
+  auto adjacencyDb1 = createAdjDb("1", {adj12}, 1);
+  auto adjacencyDb2 = createAdjDb("2", {adj21}, 2);
+
+  std::string nodeName("1");
+  SpfSolver spfSolver(
+      nodeName,
+      false /* disable v4 */,
+      true /* enable segment label */,
+      true /* enable adj labels */,
+      false /* disable LFA */);
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(kTestingAreaName, LinkState(kTestingAreaName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  PrefixState prefixState;
+
+  linkState.updateAdjacencyDatabase(adjacencyDb1);
+  linkState.updateAdjacencyDatabase(adjacencyDb2);
+  EXPECT_FALSE(updatePrefixDatabase(prefixState, prefixDb1).empty());
+  EXPECT_FALSE(updatePrefixDatabase(prefixState, prefixDb2).empty());
+
+  auto verifyCacheStats = [](int64_t hits, int64_t misses) {
+    auto counters = fb303::fbData->getCounters();
+    EXPECT_EQ(hits, counters.at("decision.route_selection_cache_hits.count"));
+    EXPECT_EQ(
+        misses, counters.at("decision.route_selection_cache_misses.count"));
+  };
+  fb303::fbData->resetAllData();
+
+  // initial build selects routes for both prefixes
+  auto routeDb = spfSolver.buildRouteDb("1", areaLinkStates, prefixState);
+  ASSERT_TRUE(routeDb.has_value());
+  EXPECT_EQ(1, routeDb->unicastRoutes.size());
+  verifyCacheStats(0, 2);
+
+  // topology only change, selection is reused
+  adjacencyDb1.adjacencies_ref()[0].metric_ref() = 10;
+  EXPECT_TRUE(linkState.updateAdjacencyDatabase(adjacencyDb1).topologyChanged);
+  routeDb = spfSolver.buildRouteDb("1", areaLinkStates, prefixState);
+  ASSERT_TRUE(routeDb.has_value());
+  EXPECT_EQ(1, routeDb->unicastRoutes.size());
+  verifyCacheStats(2, 2);
+
+  // changed announcement of node2, selection is redone for its prefix only
+  const auto prefixDb2Config = createPrefixDb(
+      "2", {createPrefixEntry(addr2, thrift::PrefixType::CONFIG)});
+  EXPECT_FALSE(updatePrefixDatabase(prefixState, prefixDb2Config).empty());
+  routeDb = spfSolver.buildRouteDb("1", areaLinkStates, prefixState);
+  ASSERT_TRUE(routeDb.has_value());
+  EXPECT_EQ(1, routeDb->unicastRoutes.size());
+  verifyCacheStats(3, 3);
+
+  // drained node2, selection is redone for its prefix only
+  adjacencyDb2.isOverloaded_ref() = true;
+  linkState.updateAdjacencyDatabase(adjacencyDb2);
+  routeDb = spfSolver.buildRouteDb("1", areaLinkStates, prefixState);
+  ASSERT_TRUE(routeDb.has_value());
+  EXPECT_EQ(1, routeDb->unicastRoutes.size());
+  verifyCacheStats(4, 4);
+
+  // selection is made per computing node
+  routeDb = spfSolver.buildRouteDb("2", areaLinkStates, prefixState);
+  ASSERT_TRUE(routeDb.has_value());
+  verifyCacheStats(4, 6);
+}
+
+/**
+ * Verifies best route selection is redone when announcer of a prefix changes,
+ * even though the new announcer shares the same prefix entry instance
+ */
+TEST(SpfSolver, RouteSelectionCacheAnnouncerChange) {
+  auto adjacencyDb1 = createAdjDb("1", {adj12, adj13}, 1);
+  auto adjacencyDb2 = createAdjDb("2", {adj21}, 2);
+  auto adjacencyDb3 = createAdjDb("3", {adj31}, 3);
+
+  std::string nodeName("1");
+  SpfSolver spfSolver(
+      nodeName,
+      false /* disable v4 */,
+      true /* enable segment label */,
+      true /* enable adj labels */,
+      false /* disable LFA */);
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(kTestingAreaName, LinkState(kTestingAreaName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  PrefixState prefixState;
+
+  linkState.updateAdjacencyDatabase(adjacencyDb1);
+  linkState.updateAdjacencyDatabase(adjacencyDb2);
+  linkState.updateAdjacencyDatabase(adjacencyDb3);
+
+  const auto prefixDb2Addr4 = createPrefixDb("2", {createPrefixEntry(addr4)});
+  const auto prefixDb3Addr4 = createPrefixDb("3", {createPrefixEntry(addr4)});
+  EXPECT_FALSE(updatePrefixDatabase(prefixState, prefixDb2Addr4).empty());
+
+  auto verifyNextHops = [&](std::string const& ifName) {
+    auto routeDb = spfSolver.buildRouteDb("1", areaLinkStates, prefixState);
+    ASSERT_TRUE(routeDb.has_value());
+    ASSERT_EQ(1, routeDb->unicastRoutes.count(toIPNetwork(addr4)));
+    auto const& nexthops =
+        routeDb->unicastRoutes.at(toIPNetwork(addr4)).nexthops;
+    ASSERT_FALSE(nexthops.empty());
+    for (auto const& nexthop : nexthops) {
+      EXPECT_EQ(ifName, *nexthop.address_ref()->ifName_ref());
+    }
+  };
+  fb303::fbData->resetAllData();
+
+  // initial selection towards node2
+  verifyNextHops(*adj12.ifName_ref());
+
+  // node3 announces the identical entry, hence shares node2's instance. Once
+  // node2 withdraws, entry of the prefix is the same instance as before but
+  // from another announcer.
+  EXPECT_FALSE(updatePrefixDatabase(prefixState, prefixDb3Addr4).empty());
+  EXPECT_FALSE(updatePrefixDatabase(prefixState, createPrefixDb("2")).empty());
+  verifyNextHops(*adj13.ifName_ref());
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_EQ(0, counters.at("decision.route_selection_cache_hits.count"));
+  EXPECT_EQ(2, counters.at("decision.route_selection_cache_misses.count"));
+}
+
+/**
+ * Verifies delta between route databases covers new, changed and withdrawn
+ * routes only
+ */
+TEST(DecisionRouteDb, CalculateUpdate) {
+  const auto nh1 = createNextHop(toBinaryAddress("fe80::1"), "iface1");
+  const auto nh2 = createNextHop(toBinaryAddress("fe80::2"), "iface2");
+
+  DecisionRouteDb oldDb;
+  oldDb.addUnicastRoute(RibUnicastEntry(addr1Cidr, {nh1}));
+  oldDb.addUnicastRoute(RibUnicastEntry(toIPNetwork(addr2), {nh1}));
+  oldDb.addMplsRoute(RibMplsEntry(1, {nh1}));
+  oldDb.addMplsRoute(RibMplsEntry(2, {nh1}));
+
+  // unchanged, changed and new routes. Nothing withdrawn
+  {
+    DecisionRouteDb newDb;
+    newDb.addUnicastRoute(RibUnicastEntry(addr1Cidr, {nh1}));
+    newDb.addUnicastRoute(RibUnicastEntry(toIPNetwork(addr2), {nh1, nh2}));
+    newDb.addUnicastRoute(RibUnicastEntry(toIPNetwork(addr3), {nh2}));
+    newDb.addMplsRoute(RibMplsEntry(1, {nh1}));
+    newDb.addMplsRoute(RibMplsEntry(2, {nh2}));
+
+    auto delta = oldDb.calculateUpdate(std::move(newDb));
+    EXPECT_EQ(2, delta.unicastRoutesToUpdate.size());
+    EXPECT_EQ(1, delta.unicastRoutesToUpdate.count(toIPNetwork(addr2)));
+    EXPECT_EQ(1, delta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+    EXPECT_TRUE(delta.unicastRoutesToDelete.empty());
+    EXPECT_EQ(1, delta.mplsRoutesToUpdate.size());
+    EXPECT_EQ(1, delta.mplsRoutesToUpdate.count(2));
+    EXPECT_TRUE(delta.mplsRoutesToDelete.empty());
+  }
+
+  // withdrawn routes, along with new ones of the same count
+  {
+    DecisionRouteDb newDb;
+    newDb.addUnicastRoute(RibUnicastEntry(addr1Cidr, {nh1}));
+    newDb.addUnicastRoute(RibUnicastEntry(toIPNetwork(addr3), {nh1}));
+    newDb.addMplsRoute(RibMplsEntry(1, {nh1}));
+    newDb.addMplsRoute(RibMplsEntry(3, {nh1}));
+
+    auto delta = oldDb.calculateUpdate(std::move(newDb));
+    EXPECT_EQ(1, delta.unicastRoutesToUpdate.size());
+    EXPECT_EQ(1, delta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+    EXPECT_THAT(
+        delta.unicastRoutesToDelete,
+        testing::ElementsAre(toIPNetwork(addr2)));
+    EXPECT_EQ(1, delta.mplsRoutesToUpdate.size());
+    EXPECT_EQ(1, delta.mplsRoutesToUpdate.count(3));
+    EXPECT_THAT(delta.mplsRoutesToDelete, testing::ElementsAre(2));
+  }
+}
+
+/**
+ * Verifies routes built from the same PrefixState entry are compared by
+ * pointer, while routes built from distinct entries are compared field-wise
+ */
+TEST(RibUnicastEntry, CompareBestPrefixEntry) {
+  const auto nh1 = createNextHop(toBinaryAddress("fe80::1"), "iface1");
+  const auto entry =
+      std::make_shared<const thrift::PrefixEntry>(createPrefixEntry(addr1));
+  const auto entryCopy = std::make_shared<const thrift::PrefixEntry>(*entry);
+
+  const RibUnicastEntry route(addr1Cidr, {nh1}, entry, kTestingAreaName);
+  EXPECT_EQ(entry, route.bestPrefixEntrySource);
+  EXPECT_EQ(*entry, route.bestPrefixEntry);
+
+  // same entry
+  EXPECT_EQ(route, RibUnicastEntry(addr1Cidr, {nh1}, entry, kTestingAreaName));
+
+  // same entry with different ucmp weight
+  EXPECT_NE(
+      route,
+      RibUnicastEntry(
+          addr1Cidr, {nh1}, entry, kTestingAreaName, false, 0, 10));
+
+  // distinct entries with equal content
+  EXPECT_EQ(
+      route, RibUnicastEntry(addr1Cidr, {nh1}, entryCopy, kTestingAreaName));
+  EXPECT_EQ(route, RibUnicastEntry(addr1Cidr, {nh1}, *entry, kTestingAreaName));
+
+  // distinct entries with different content
+  auto otherEntry = *entry;
+  otherEntry.tags_ref()->insert("TAG1");
+  EXPECT_NE(
+      route, RibUnicastEntry(addr1Cidr, {nh1}, otherEntry, kTestingAreaName));
+}
+
 //
 // Node-1 connects to 2 but 2 doesn't report bi-directionality
 // Node-2 and Node-3 are bi-directionally connected
@@ -5248,6 +5465,326 @@ TEST_F(DecisionTestFixture, BasicOperations) {
   EXPECT_TRUE(foundLabelRoute);
 }
 
+/**
+ * Nodes advertise adjacencies with per adjacency keys. Update, withdrawal and
+ * expiry of single adjacency key must be reflected in routes.
+ */
+TEST_F(DecisionTestFixture, PerAdjacencyKeys) {
+  auto createPerAdjValue = [&](const string& node,
+                               int64_t version,
+                               std::optional<thrift::Adjacency> adj,
+                               int32_t nodeId = 0) {
+    auto adjDb = createAdjDb(node, {}, nodeId);
+    adjDb.perAdjacencyKeys_ref() = true;
+    if (adj.has_value()) {
+      adjDb.adjacencies_ref()->emplace_back(std::move(*adj));
+    }
+    return createThriftValue(
+        version,
+        "originator-1",
+        writeThriftObjStr(adjDb, serializer),
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        0 /* hash */);
+  };
+  const auto key12 = getAdjacencyKey("1", "2", *adj12.ifName_ref());
+  const auto key21 = getAdjacencyKey("2", "1", *adj21.ifName_ref());
+
+  auto publication = createThriftPublication(
+      {{"adj:1", createPerAdjValue("1", 1, std::nullopt, 1)},
+       {"adj:2", createPerAdjValue("2", 1, std::nullopt, 2)},
+       {key12, createPerAdjValue("1", 1, adj12)},
+       {key21, createPerAdjValue("2", 1, adj21)},
+       createPrefixKeyValue("1", 1, addr1),
+       createPrefixKeyValue("2", 1, addr2)},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  auto routeDbDelta = recvRouteUpdates();
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(
+      toIPNetwork(addr2),
+      routeDbDelta.unicastRoutesToUpdate.begin()->second.prefix);
+
+  // Withdraw adjacency 2->1
+  publication = createThriftPublication(
+      {{key21, createPerAdjValue("2", 2, std::nullopt)}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+
+  // Re-advertise adjacency 2->1
+  publication = createThriftPublication(
+      {{key21, createPerAdjValue("2", 3, adj21)}}, {}, {}, {}, std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+
+  // Expire adjacency 1->2
+  publication = createThriftPublication({}, {key12}, {}, {}, std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+}
+
+/**
+ * Prefixes packed into bucket key of a node. Prefixes moved out of the bucket,
+ * and all prefixes of expired bucket, must be withdrawn.
+ */
+TEST_F(DecisionTestFixture, PrefixBucketKeys) {
+  const auto bucketKey = PrefixKey::getPrefixBucketKey("2", 0);
+
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue("1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue("2", 1, {adj21}, false, 2)},
+       createPrefixKeyValue("1", 1, addr1),
+       {bucketKey, createPrefixValue("2", 1, {addr2, addr3})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr2)));
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+
+  // Move addr3 out of the bucket
+  publication = createThriftPublication(
+      {{bucketKey, createPrefixValue("2", 2, {addr2})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr3), routeDbDelta.unicastRoutesToDelete.front());
+
+  // Expire the bucket
+  publication =
+      createThriftPublication({}, {bucketKey}, {}, {}, std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr2), routeDbDelta.unicastRoutesToDelete.front());
+}
+
+/**
+ * Number of bucket keys of a node changes. Prefixes moved to new bucket key
+ * must not be withdrawn when old bucket key expires.
+ */
+TEST_F(DecisionTestFixture, PrefixBucketKeysBucketCountChange) {
+  const auto oldBucketKey = PrefixKey::getPrefixBucketKey("2", 0);
+  const auto newBucketKey = PrefixKey::getPrefixBucketKey("2", 5);
+
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue("1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue("2", 1, {adj21}, false, 2)},
+       {oldBucketKey, createPrefixValue("2", 1, {addr2, addr3})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToUpdate.size());
+
+  // Prefixes are re-advertised with new bucket key, along with a new one
+  publication = createThriftPublication(
+      {{newBucketKey, createPrefixValue("2", 1, {addr2, addr3, addr4})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr4)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  // Old bucket key expires. Only prefix dropped from new bucket key is
+  // withdrawn.
+  publication = createThriftPublication(
+      {{newBucketKey, createPrefixValue("2", 2, {addr2, addr4})}},
+      {oldBucketKey},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr3), routeDbDelta.unicastRoutesToDelete.front());
+}
+
+/**
+ * Node switches from per prefix keys to bucket keys. Prefixes moved to bucket
+ * key must not be withdrawn when per prefix keys expire or are cleared.
+ */
+TEST_F(DecisionTestFixture, PrefixBucketKeysPerPrefixKeyExpiry) {
+  const auto bucketKey = PrefixKey::getPrefixBucketKey("2", 0);
+  const auto prefixKeyVal2 = createPrefixKeyValue("2", 1, addr2);
+  const auto prefixKeyVal3 = createPrefixKeyValue("2", 1, addr3);
+
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue("1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue("2", 1, {adj21}, false, 2)},
+       prefixKeyVal2,
+       prefixKeyVal3},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToUpdate.size());
+
+  // Prefixes are re-advertised with bucket key, along with a new one
+  publication = createThriftPublication(
+      {{bucketKey, createPrefixValue("2", 1, {addr2, addr3, addr4})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr4)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  // Per prefix key of addr2 is cleared and one of addr3 expires. Only prefix
+  // dropped from bucket key is withdrawn.
+  publication = createThriftPublication(
+      {createPrefixKeyValue("2", 2, addr2, kTestingAreaName, true),
+       {bucketKey, createPrefixValue("2", 2, {addr2, addr3})}},
+      {prefixKeyVal3.first},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr4), routeDbDelta.unicastRoutesToDelete.front());
+
+  // Prefixes advertised with bucket key only are withdrawn with it
+  publication =
+      createThriftPublication({}, {bucketKey}, {}, {}, std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToDelete.size());
+}
+
+class DecisionGracefulRestartHoldTestFixture : public DecisionTestFixture {
+  openr::thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = DecisionTestFixture::createConfig();
+    tConfig.decision_config_ref()->graceful_restart_hold_ms_ref() =
+        grHoldTime.count();
+    return tConfig;
+  }
+
+ protected:
+  const std::chrono::milliseconds grHoldTime{1000};
+};
+
+/**
+ * Node 3 gracefully restarts while its neighbor 2 keeps the adjacency flagged
+ * as restarting. Adjacency database of 3 must be held, so that neither its
+ * withdrawal nor re-advertisement changes routes. Without 3 coming back,
+ * held updates are applied once hold expires.
+ */
+TEST_F(DecisionGracefulRestartHoldTestFixture, HoldRestartingNode) {
+  auto adj23Restarting = adj23;
+  adj23Restarting.isRestarting_ref() = true;
+
+  // Topology 1 - 2 - 3
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue("1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue("2", 1, {adj21, adj23}, false, 2)},
+       {"adj:3", createAdjValue("3", 1, {adj32}, false, 3)},
+       createPrefixKeyValue("1", 1, addr1),
+       createPrefixKeyValue("2", 1, addr2),
+       createPrefixKeyValue("3", 1, addr3)},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToUpdate.size());
+
+  //
+  // Node 3 restarts and its adjacency database expires. Routes via 3 are
+  // kept.
+  //
+  publication = createThriftPublication(
+      {{"adj:2", createAdjValue("2", 2, {adj21, adj23Restarting}, false, 2)}},
+      {"adj:3"},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+
+  // wait for publication to be processed
+  /* sleep override */
+  std::this_thread::sleep_for(
+      debounceTimeoutMax + std::chrono::milliseconds(100));
+  EXPECT_EQ(0, routeUpdatesQueueReader.size());
+
+  //
+  // Node 3 comes back as it was and 2 clears restarting flag. Hold is
+  // released without any route change.
+  //
+  publication = createThriftPublication(
+      {{"adj:2", createAdjValue("2", 3, {adj21, adj23}, false, 2)},
+       {"adj:3", createAdjValue("3", 2, {adj32}, false, 3)}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  //
+  // Node 3 restarts again but never comes back. Its withdrawal is applied
+  // once hold expires.
+  //
+  publication = createThriftPublication(
+      {{"adj:2", createAdjValue("2", 4, {adj21, adj23Restarting}, false, 2)}},
+      {"adj:3"},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+
+  /* sleep override */
+  std::this_thread::sleep_for(
+      debounceTimeoutMax + std::chrono::milliseconds(100));
+  EXPECT_EQ(0, routeUpdatesQueueReader.size());
+
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr3), routeDbDelta.unicastRoutesToDelete.at(0));
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_EQ(2, counters.at("decision.gr_hold.started.sum"));
+  EXPECT_EQ(2, counters.at("decision.gr_hold.updates_held.sum"));
+  EXPECT_EQ(1, counters.at("decision.gr_hold.expired.sum"));
+}
+
 /**
  * Publish all types of update to Decision and expect that Decision emits
  * a full route database that includes all the routes as its first update.
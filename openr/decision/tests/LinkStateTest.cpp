@@ -203,6 +203,77 @@ TEST(LinkStateTest, BasicOperation) {
   EXPECT_THAT(state.linksFromNode(n3), UnorderedElementsAre(Pointee(l2)));
 }
 
+TEST(LinkStateTest, PerAdjacencyKeys) {
+  std::string n1 = "node1";
+  std::string n2 = "node2";
+  std::string n3 = "node3";
+  auto adj12 =
+      openr::createAdjacency(n2, "if2", "if1", "fe80::2", "10.0.0.2", 1, 1, 1);
+  auto adj13 =
+      openr::createAdjacency(n3, "if3", "if1", "fe80::3", "10.0.0.3", 1, 1, 1);
+  auto adj21 =
+      openr::createAdjacency(n1, "if1", "if2", "fe80::1", "10.0.0.1", 1, 1, 1);
+  auto adj31 =
+      openr::createAdjacency(n1, "if1", "if3", "fe80::1", "10.0.0.1", 1, 1, 1);
+
+  openr::Link l1(kTestingAreaName, n1, adj12, n2, adj21);
+  openr::Link l3(kTestingAreaName, n3, adj31, n1, adj13);
+
+  auto nodeDb1 = openr::createAdjDb(n1, {}, 1);
+  nodeDb1.perAdjacencyKeys_ref() = true;
+  auto nodeDb2 = openr::createAdjDb(n2, {}, 2);
+  nodeDb2.perAdjacencyKeys_ref() = true;
+
+  openr::LinkState state{kTestingAreaName};
+
+  // Adjacencies received before node key are applied along with it
+  EXPECT_FALSE(state.updateAdjacency(n1, n2, "if2", adj12).topologyChanged);
+  EXPECT_FALSE(state.updateAdjacency(n1, n3, "if3", adj13).topologyChanged);
+  EXPECT_FALSE(state.hasNode(n1));
+  EXPECT_FALSE(state.updateAdjacencyDatabase(nodeDb1, 0, 0).topologyChanged);
+  EXPECT_EQ(2, state.getAdjacencyDatabases().at(n1).get_adjacencies().size());
+
+  // Single adjacency brings up link
+  EXPECT_FALSE(state.updateAdjacencyDatabase(nodeDb2, 0, 0).topologyChanged);
+  auto update = state.updateAdjacency(n2, n1, "if1", adj21);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_EQ(1, update.addedLinks.size());
+  EXPECT_THAT(state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1)));
+  EXPECT_THAT(state.linksFromNode(n2), UnorderedElementsAre(Pointee(l1)));
+
+  // Attribute change of single adjacency
+  adj21.metric_ref() = 10;
+  update = state.updateAdjacency(n2, n1, "if1", adj21);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_TRUE(update.addedLinks.empty());
+  EXPECT_EQ(10, (*state.linksFromNode(n2).begin())->getMetricFromNode(n2));
+
+  // Node attributes change keeps adjacencies
+  nodeDb2.isOverloaded_ref() = true;
+  EXPECT_TRUE(state.updateAdjacencyDatabase(nodeDb2, 0, 0).topologyChanged);
+  EXPECT_TRUE(state.isNodeOverloaded(n2));
+  EXPECT_THAT(state.linksFromNode(n2), UnorderedElementsAre(Pointee(l1)));
+
+  // Adjacency not matching its key is ignored
+  EXPECT_FALSE(state.updateAdjacency(n2, n3, "if3", adj21).topologyChanged);
+  EXPECT_EQ(1, state.getAdjacencyDatabases().at(n2).get_adjacencies().size());
+
+  // Withdrawn adjacency brings down link
+  update = state.updateAdjacency(n2, n1, "if1", std::nullopt);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_THAT(state.linksFromNode(n1), testing::IsEmpty());
+  EXPECT_THAT(state.linksFromNode(n2), testing::IsEmpty());
+  EXPECT_TRUE(state.getAdjacencyDatabases().at(n2).get_adjacencies().empty());
+
+  // Per adjacency keys are not applied to node advertising full database
+  auto adjDb3 = openr::createAdjDb(n3, {adj31}, 3);
+  update = state.updateAdjacencyDatabase(adjDb3, 0, 0);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_FALSE(
+      state.updateAdjacency(n3, n1, "if1", std::nullopt).topologyChanged);
+  EXPECT_THAT(state.linksFromNode(n3), UnorderedElementsAre(Pointee(l3)));
+}
+
 TEST(LinkStateTest, pathAInPathB) {
   auto l1 =
       std::make_shared<openr::Link>(kTestingAreaName, "1", "1/2", "2", "2/1");
@@ -259,8 +259,7 @@ TEST(PrefixState, FilterReceivedRoutes) {
  * Test PrefixState::hasConflictingForwardingInfo
  */
 TEST(PrefixState, HasConflictingForwardingInfo) {
-  std::unordered_map<NodeAndArea, std::shared_ptr<thrift::PrefixEntry>>
-      prefixEntries;
+  PrefixEntries prefixEntries;
 
   thrift::PrefixEntry pIpSpf, pMplsSpf, pMplsKspf;
   pIpSpf.forwardingType_ref() = thrift::PrefixForwardingType::IP;
@@ -308,6 +307,50 @@ TEST(PrefixState, HasConflictingForwardingInfo) {
   EXPECT_FALSE(PrefixState::hasConflictingForwardingInfo(prefixEntries));
 }
 
+/**
+ * Verifies announcements of a prefix with identical attributes share the
+ * stored entry, while differing ones are kept apart
+ */
+TEST(PrefixState, ShareIdenticalEntries) {
+  PrefixState state;
+  auto prefixEntry = createPrefixEntry(toIpPrefix("10.0.0.0/8"));
+  const auto network = toIPNetwork(prefixEntry.get_prefix());
+  const PrefixKey k1("node1", network, "area1");
+  const PrefixKey k2("node2", network, "area1");
+  const PrefixKey k3("node3", network, "area2");
+
+  EXPECT_FALSE(state.updatePrefix(k1, prefixEntry).empty());
+  EXPECT_FALSE(state.updatePrefix(k2, prefixEntry).empty());
+  {
+    auto const& entries = state.prefixes().at(network);
+    ASSERT_EQ(2, entries.size());
+    EXPECT_EQ(
+        entries.at(k1.getNodeAndArea()), entries.at(k2.getNodeAndArea()));
+  }
+
+  // entry with different attributes gets its own instance
+  auto otherPrefixEntry = prefixEntry;
+  otherPrefixEntry.metrics_ref()->distance_ref() = 10;
+  EXPECT_FALSE(state.updatePrefix(k2, otherPrefixEntry).empty());
+  EXPECT_FALSE(state.updatePrefix(k3, otherPrefixEntry).empty());
+  {
+    auto const& entries = state.prefixes().at(network);
+    ASSERT_EQ(3, entries.size());
+    EXPECT_EQ(prefixEntry, *entries.at(k1.getNodeAndArea()));
+    EXPECT_EQ(otherPrefixEntry, *entries.at(k2.getNodeAndArea()));
+    EXPECT_EQ(
+        entries.at(k2.getNodeAndArea()), entries.at(k3.getNodeAndArea()));
+    EXPECT_NE(
+        entries.at(k1.getNodeAndArea()), entries.at(k2.getNodeAndArea()));
+  }
+
+  // withdrawing one announcer keeps shared entry of the other
+  EXPECT_FALSE(state.deletePrefix(k2).empty());
+  EXPECT_EQ(
+      otherPrefixEntry,
+      *state.prefixes().at(network).at(k3.getNodeAndArea()));
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -93,6 +93,87 @@ TEST(RibEntryTest, RibMplsEntry_filterNexthopsToUniqueAction) {
       std::unordered_set<thrift::NextHopThrift>({path1_3_1_php}));
 }
 
+TEST(RibEntryTest, InternedNextHops) {
+  const auto numInterned = InternedNextHops::getNumInterned();
+
+  // Empty next-hops are never interned
+  InternedNextHops empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(InternedNextHops(), empty);
+  EXPECT_EQ(numInterned, InternedNextHops::getNumInterned());
+
+  {
+    // Equal sets, irrespective of insertion order, share the same entry
+    InternedNextHops nexthops1({path1_2_1_swap, path1_3_1_swap});
+    InternedNextHops nexthops2({path1_3_1_swap, path1_2_1_swap});
+    EXPECT_EQ(nexthops1, nexthops2);
+    EXPECT_EQ(&nexthops1.get(), &nexthops2.get());
+    EXPECT_EQ(2, nexthops1.size());
+    EXPECT_EQ(1, nexthops1.count(path1_2_1_swap));
+    EXPECT_EQ(numInterned + 1, InternedNextHops::getNumInterned());
+
+    // Different set gets its own entry
+    InternedNextHops nexthops3({path1_2_1_swap});
+    EXPECT_NE(nexthops1, nexthops3);
+    EXPECT_EQ(numInterned + 2, InternedNextHops::getNumInterned());
+
+    // Routes with same next-hops share them
+    RibUnicastEntry route1(
+        folly::IPAddress::createNetwork("fc00::1/128"),
+        {path1_2_1_swap, path1_3_1_swap});
+    RibUnicastEntry route2(
+        folly::IPAddress::createNetwork("fc00::1/128"), nexthops2);
+    EXPECT_EQ(route1, route2);
+    EXPECT_EQ(&route1.nexthops.get(), &nexthops1.get());
+    EXPECT_EQ(numInterned + 2, InternedNextHops::getNumInterned());
+
+    // Re-assigning next-hops of a route doesn't affect others
+    route2.nexthops = {path1_2_1_swap};
+    EXPECT_NE(route1, route2);
+    EXPECT_EQ(nexthops3, route2.nexthops);
+    EXPECT_EQ(2, nexthops1.size());
+  }
+
+  // Entries are released with their last reference
+  EXPECT_EQ(numInterned, InternedNextHops::getNumInterned());
+}
+
+TEST(RibEntryTest, InternedNextHopsMovedFrom) {
+  const auto numInterned = InternedNextHops::getNumInterned();
+
+  {
+    // Moved-from handle reads as empty set
+    InternedNextHops nexthops1({path1_2_1_swap, path1_3_1_swap});
+    InternedNextHops nexthops2(std::move(nexthops1));
+    EXPECT_EQ(2, nexthops2.size());
+    EXPECT_TRUE(nexthops1.empty());
+    EXPECT_EQ(0, nexthops1.size());
+    EXPECT_EQ(nexthops1.begin(), nexthops1.end());
+    EXPECT_EQ(InternedNextHops(), nexthops1);
+    EXPECT_NE(nexthops1, nexthops2);
+
+    // Same with move assignment, and handle is usable after re-assignment
+    InternedNextHops nexthops3;
+    nexthops3 = std::move(nexthops2);
+    EXPECT_EQ(2, nexthops3.size());
+    EXPECT_TRUE(nexthops2.empty());
+    nexthops2 = {path1_2_1_swap};
+    EXPECT_EQ(1, nexthops2.size());
+
+    // Moved-from route remains readable
+    RibUnicastEntry route1(
+        folly::IPAddress::createNetwork("fc00::1/128"), nexthops3);
+    RibUnicastEntry route2(std::move(route1));
+    EXPECT_EQ(nexthops3, route2.nexthops);
+    EXPECT_TRUE(route1.nexthops.empty());
+    EXPECT_NE(route1, route2);
+    EXPECT_TRUE(route1.toThrift().nextHops_ref()->empty());
+  }
+
+  // Entries are released with their last reference
+  EXPECT_EQ(numInterned, InternedNextHops::getNumInterned());
+}
+
 } // namespace openr
 
 int
@@ -884,4 +884,59 @@ BM_DecisionFabricPrefixUpdates(
     }
   }
 }
+
+void
+BM_PrefixStateAnnouncements(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfPrefixes,
+    uint32_t numOfAnnouncers) {
+  auto suspender = folly::BenchmarkSuspender();
+  // Add boolean to control profiling memory for the 1st iteration
+  SystemMetrics sysMetrics;
+  bool record = true;
+
+  // Every prefix is announced by `numOfAnnouncers` FSWs with same attributes
+  PrefixGenerator prefixGenerator;
+  const auto prefixes =
+      prefixGenerator.ipv6PrefixGenerator(numOfPrefixes, kBitMaskLen);
+  std::vector<thrift::PrefixEntry> prefixEntries;
+  prefixEntries.reserve(prefixes.size());
+  for (const auto& prefix : prefixes) {
+    prefixEntries.emplace_back(createPrefixEntry(prefix));
+  }
+  std::vector<std::string> nodeNames;
+  for (uint32_t i = 0; i < numOfAnnouncers; i++) {
+    nodeNames.emplace_back(getNodeName(kFswMarker, i / 100, i % 100));
+  }
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto prefixState = std::make_unique<PrefixState>();
+    const auto memBefore = sysMetrics.getRSSMemBytes();
+
+    suspender.dismiss(); // Start measuring benchmark time
+    for (const auto& nodeName : nodeNames) {
+      for (const auto& prefixEntry : prefixEntries) {
+        prefixState->updatePrefix(
+            PrefixKey(
+                nodeName,
+                toIPNetwork(prefixEntry.get_prefix()),
+                kTestingAreaName),
+            prefixEntry);
+      }
+    }
+    suspender.rehire(); // Stop measuring time again
+
+    if (record) {
+      const auto memAfter = sysMetrics.getRSSMemBytes();
+      if (memBefore.has_value() and memAfter.has_value() and
+          memAfter.value() > memBefore.value()) {
+        counters["bytes_per_announcement"] =
+            (memAfter.value() - memBefore.value()) /
+            (numOfPrefixes * numOfAnnouncers);
+      }
+      record = false;
+    }
+  }
+}
 } // namespace openr
@@ -452,6 +452,15 @@ void BM_DecisionFabricPrefixUpdates(
     uint32_t numOfUpdatePrefixes,
     thrift::PrefixForwardingAlgorithm forwardingAlgorithm);
 
+//
+// Benchmark test for prefix state memory footprint.
+//
+void BM_PrefixStateAnnouncements(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfPrefixes,
+    uint32_t numOfAnnouncers);
+
 const auto SP_ECMP = thrift::PrefixForwardingAlgorithm::SP_ECMP;
 const auto KSP2_ED_ECMP = thrift::PrefixForwardingAlgorithm::KSP2_ED_ECMP;
 } // namespace openr
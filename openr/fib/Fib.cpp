@@ -83,7 +83,8 @@ Fib::Fib(
   addFiberTask(
       [this]() mutable noexcept { keepAliveTask(keepAliveStopSignal_); });
 
-  // Fiber to process route updates from Decision
+  // Fiber to process route updates from Decision. Updates that got queued up
+  // while Fib was busy programming are coalesced into a single net update.
   addFiberTask([q = std::move(routeUpdatesQueue), this]() mutable noexcept {
     while (true) {
       auto maybeThriftObj = q.get(); // perform read
@@ -92,7 +93,18 @@ Fib::Fib(
         break;
       }
       fb303::fbData->addStatValue("fib.process_route_db", 1, fb303::COUNT);
-      processDecisionRouteUpdate(std::move(maybeThriftObj).value());
+
+      std::vector<DecisionRouteUpdate> updates;
+      updates.emplace_back(std::move(maybeThriftObj).value());
+      while (q.size() > 0) {
+        auto maybePendingObj = q.get(); // non-blocking read
+        if (maybePendingObj.hasError()) {
+          break;
+        }
+        fb303::fbData->addStatValue("fib.process_route_db", 1, fb303::COUNT);
+        updates.emplace_back(std::move(maybePendingObj).value());
+      }
+      processDecisionRouteUpdate(coalesceRouteUpdates(std::move(updates)));
     }
   });
 
@@ -123,6 +135,9 @@ Fib::Fib(
       "fib.local_route_program_time_ms", fb303::AVG);
   fb303::fbData->addStatExportType("fib.num_of_route_updates", fb303::SUM);
   fb303::fbData->addStatExportType("fib.process_route_db", fb303::COUNT);
+  fb303::fbData->addStatExportType("fib.route_updates.coalesced", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "fib.route_updates.elided_routes", fb303::SUM);
   fb303::fbData->addStatExportType("fib.sync_fib_calls", fb303::COUNT);
   fb303::fbData->addStatExportType(
       "fib.thrift.failure.add_del_route", fb303::COUNT);
@@ -241,6 +256,31 @@ Fib::getPerfDb() {
   return sf;
 }
 
+folly::SemiFuture<std::unique_ptr<std::map<std::string, thrift::LatencyStats>>>
+Fib::getLatencyStats() {
+  folly::Promise<std::unique_ptr<std::map<std::string, thrift::LatencyStats>>>
+      p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([p = std::move(p), this]() mutable {
+    auto stats =
+        std::make_unique<std::map<std::string, thrift::LatencyStats>>();
+    for (auto const& [stage, histogram] : latencyStats_) {
+      const auto percentiles = histogram.getPercentiles();
+      thrift::LatencyStats stageStats;
+      stageStats.count_ref() = histogram.getCount();
+      stageStats.windowSize_ref() = histogram.getWindowSize();
+      stageStats.p50_ref() = percentiles.p50;
+      stageStats.p99_ref() = percentiles.p99;
+      stageStats.p999_ref() = percentiles.p999;
+      stageStats.max_ref() = percentiles.max;
+      stageStats.numErrors_ref() = histogram.getNumErrors();
+      stats->emplace(stage, std::move(stageStats));
+    }
+    p.setValue(std::move(stats));
+  });
+  return sf;
+}
+
 std::vector<thrift::UnicastRoute>
 Fib::getUnicastRoutesFiltered(std::vector<std::string> prefixes) {
   // return and send the vector<thrift::UnicastRoute>
@@ -459,9 +499,93 @@ Fib::RouteState::processFibUpdateError(
   }
 }
 
+DecisionRouteUpdate
+Fib::coalesceRouteUpdates(std::vector<DecisionRouteUpdate>&& updates) const {
+  CHECK(not updates.empty());
+  if (updates.size() == 1) {
+    return std::move(updates.front());
+  }
+
+  // Net change per prefix/label. `std::nullopt` represents deletion. Later
+  // updates overwrite the earlier ones.
+  std::unordered_map<folly::CIDRNetwork, std::optional<RibUnicastEntry>>
+      unicastRoutes;
+  std::unordered_map<int32_t, std::optional<RibMplsEntry>> mplsRoutes;
+
+  DecisionRouteUpdate coalesced;
+  size_t numRoutes{0};
+  for (auto& update : updates) {
+    numRoutes += update.size();
+    for (auto& [prefix, route] : update.unicastRoutesToUpdate) {
+      unicastRoutes.insert_or_assign(prefix, std::move(route));
+    }
+    for (auto const& prefix : update.unicastRoutesToDelete) {
+      unicastRoutes.insert_or_assign(prefix, std::nullopt);
+    }
+    for (auto& [label, route] : update.mplsRoutesToUpdate) {
+      mplsRoutes.insert_or_assign(label, std::move(route));
+    }
+    for (auto const& label : update.mplsRoutesToDelete) {
+      mplsRoutes.insert_or_assign(label, std::nullopt);
+    }
+
+    // Full sync in any of the updates makes the coalesced one full sync. Use
+    // the most recent perf events as convergence is based on latest data.
+    if (update.type == DecisionRouteUpdate::FULL_SYNC) {
+      coalesced.type = DecisionRouteUpdate::FULL_SYNC;
+    }
+    if (update.prefixType.has_value()) {
+      coalesced.prefixType = update.prefixType;
+    }
+    if (update.perfEvents.has_value()) {
+      coalesced.perfEvents = std::move(update.perfEvents);
+    }
+  }
+  // Queue wait is accounted from the oldest update
+  coalesced.enqueueTime = updates.front().enqueueTime;
+
+  // Build net update. Deletion of a route which is neither programmed nor
+  // pending for retry cancels out with its addition in this batch.
+  for (auto& [prefix, route] : unicastRoutes) {
+    if (route.has_value()) {
+      coalesced.addRouteToUpdate(std::move(route).value());
+    } else if (
+        routeState_.unicastRoutes.count(prefix) or
+        routeState_.dirtyPrefixes.count(prefix)) {
+      coalesced.unicastRoutesToDelete.emplace_back(prefix);
+    }
+  }
+  for (auto& [label, route] : mplsRoutes) {
+    if (route.has_value()) {
+      coalesced.addMplsRouteToUpdate(std::move(route).value());
+    } else if (
+        routeState_.mplsRoutes.count(label) or
+        routeState_.dirtyLabels.count(label)) {
+      coalesced.mplsRoutesToDelete.emplace_back(label);
+    }
+  }
+
+  const auto numElided = numRoutes - coalesced.size();
+  XLOG(INFO) << fmt::format(
+      "Coalesced {} route updates. Elided {} of {} route entries",
+      updates.size(),
+      numElided,
+      numRoutes);
+  fb303::fbData->addStatValue(
+      "fib.route_updates.coalesced", updates.size() - 1, fb303::SUM);
+  fb303::fbData->addStatValue(
+      "fib.route_updates.elided_routes", numElided, fb303::SUM);
+  return coalesced;
+}
+
 // Process new route updates received from Decision module.
 void
 Fib::processDecisionRouteUpdate(DecisionRouteUpdate&& routeUpdate) {
+  // Record the time this update spent in queue after Decision produced it
+  if (routeUpdate.enqueueTime.has_value()) {
+    recordLatency("queue_wait_ms", routeUpdate.enqueueTime.value());
+  }
+
   // Process state transition event
   transitionRouteState(RouteState::RIB_UPDATE);
 
@@ -560,6 +684,7 @@ Fib::printMplsRoutesAddUpdate(
 bool
 Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
   SCOPE_EXIT {
+    exportLatencyCounters(); // Export latencies recorded for this batch
     updateRoutesSemaphore_.signal(); // Release when this function returns
   };
   updateRoutesSemaphore_.wait();
@@ -625,10 +750,13 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
     if (dryrun_) {
       XLOG(INFO) << "Skipping deletion of unicast routes in dryrun ... ";
     } else {
+      const auto callStart = std::chrono::steady_clock::now();
       try {
         createFibClient(*getEvb(), socket_, client_, thriftPort_);
         client_->sync_deleteUnicastRoutes(kFibId_, unicastRoutesToDelete);
+        recordLatency("thrift.delete_unicast_routes_ms", callStart);
       } catch (std::exception& e) {
+        recordLatency("thrift.delete_unicast_routes_ms", callStart, true);
         success = false;
         client_.reset();
         fb303::fbData->addStatValue(
@@ -656,10 +784,13 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
     if (dryrun_) {
       XLOG(INFO) << "Skipping add/update of unicast routes in dryrun ... ";
     } else {
+      const auto callStart = std::chrono::steady_clock::now();
       try {
         createFibClient(*getEvb(), socket_, client_, thriftPort_);
         client_->sync_addUnicastRoutes(kFibId_, unicastRoutesToUpdate);
+        recordLatency("thrift.add_unicast_routes_ms", callStart);
       } catch (thrift::PlatformFibUpdateError const& fibUpdateError) {
+        recordLatency("thrift.add_unicast_routes_ms", callStart, true);
         success = false;
         logFibUpdateError(fibUpdateError);
         // Remove failed routes from fibRouteUpdates
@@ -667,6 +798,7 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
         // Mark failed routes as dirty in route state
         routeState_.processFibUpdateError(fibUpdateError, retryAt);
       } catch (std::exception const& e) {
+        recordLatency("thrift.add_unicast_routes_ms", callStart, true);
         success = false;
         client_.reset();
         fb303::fbData->addStatValue(
@@ -717,10 +849,13 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
     if (dryrun_) {
       XLOG(INFO) << "Skipping deletion of mpls routes in dryrun ... ";
     } else {
+      const auto callStart = std::chrono::steady_clock::now();
       try {
         createFibClient(*getEvb(), socket_, client_, thriftPort_);
         client_->sync_deleteMplsRoutes(kFibId_, mplsRoutesToDelete);
+        recordLatency("thrift.delete_mpls_routes_ms", callStart);
       } catch (std::exception const& e) {
+        recordLatency("thrift.delete_mpls_routes_ms", callStart, true);
         success = false;
         client_.reset();
         fb303::fbData->addStatValue(
@@ -748,10 +883,13 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
     if (dryrun_) {
       XLOG(INFO) << "Skipping add/update of mpls routes in dryrun ... ";
     } else {
+      const auto callStart = std::chrono::steady_clock::now();
       try {
         createFibClient(*getEvb(), socket_, client_, thriftPort_);
         client_->sync_addMplsRoutes(kFibId_, mplsRoutesToUpdate);
+        recordLatency("thrift.add_mpls_routes_ms", callStart);
       } catch (thrift::PlatformFibUpdateError const& fibUpdateError) {
+        recordLatency("thrift.add_mpls_routes_ms", callStart, true);
         success = false;
         logFibUpdateError(fibUpdateError);
         // Remove failed routes from fibRouteUpdates
@@ -759,6 +897,7 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
         // Mark failed routes as dirty in route state
         routeState_.processFibUpdateError(fibUpdateError, retryAt);
       } catch (std::exception const& e) {
+        recordLatency("thrift.add_mpls_routes_ms", callStart, true);
         success = false;
         client_.reset();
         fb303::fbData->addStatValue(
@@ -787,6 +926,7 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
       "It took {} ms to update routes in FIB", elapsedTime.count());
   fb303::fbData->addStatValue(
       "fib.route_programming.time_ms", elapsedTime.count(), fb303::AVG);
+  recordLatency("route_programming_ms", currentTime, not success);
   fb303::fbData->addStatValue(
       "fib.num_of_route_updates", routeUpdate.size(), fb303::SUM);
 
@@ -801,9 +941,38 @@ Fib::updateRoutes(DecisionRouteUpdate&& routeUpdate, bool useDeleteDelay) {
   return success;
 }
 
+void
+Fib::recordLatency(
+    const std::string& stage,
+    const std::chrono::steady_clock::time_point& startTime,
+    bool isError) {
+  const auto latencyMs = std::chrono::ceil<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - startTime)
+                             .count();
+  fb303::fbData->addStatValue(
+      fmt::format("fib.latency.{}", stage), latencyMs, fb303::AVG);
+
+  auto& histogram = latencyStats_[stage];
+  histogram.addValue(latencyMs);
+  if (isError) {
+    histogram.addError();
+  }
+  updatedLatencyStages_.insert(stage);
+}
+
+void
+Fib::exportLatencyCounters() {
+  for (auto const& stage : updatedLatencyStages_) {
+    latencyStats_.at(stage).exportCounters(
+        fmt::format("fib.latency.{}", stage));
+  }
+  updatedLatencyStages_.clear();
+}
+
 bool
 Fib::syncRoutes() {
   SCOPE_EXIT {
+    exportLatencyCounters(); // Export latencies recorded for this batch
     updateRoutesSemaphore_.signal(); // Release when this function returns
   };
   updateRoutesSemaphore_.wait();
@@ -832,16 +1001,20 @@ Fib::syncRoutes() {
   if (dryrun_) {
     XLOG(INFO) << "Skipping programming of unicast routes in dryrun ... ";
   } else {
+    const auto callStart = std::chrono::steady_clock::now();
     try {
       createFibClient(*getEvb(), socket_, client_, thriftPort_);
       client_->sync_syncFib(kFibId_, unicastRoutes);
+      recordLatency("thrift.sync_fib_ms", callStart);
     } catch (thrift::PlatformFibUpdateError const& fibUpdateError) {
+      recordLatency("thrift.sync_fib_ms", callStart, true);
       logFibUpdateError(fibUpdateError);
       // Remove failed routes from fibRouteUpdates
       fibRouteUpdates.processFibUpdateError(fibUpdateError);
       // Mark failed routes as dirty in route state
       routeState_.processFibUpdateError(fibUpdateError, retryAt);
     } catch (std::exception const& e) {
+      recordLatency("thrift.sync_fib_ms", callStart, true);
       client_.reset();
       fb303::fbData->addStatValue(
           "fib.thrift.failure.sync_fib", 1, fb303::COUNT);
@@ -860,16 +1033,20 @@ Fib::syncRoutes() {
     if (dryrun_) {
       XLOG(INFO) << "Skipping programming of mpls routes in dryrun ...";
     } else {
+      const auto callStart = std::chrono::steady_clock::now();
       try {
         createFibClient(*getEvb(), socket_, client_, thriftPort_);
         client_->sync_syncMplsFib(kFibId_, mplsRoutes);
+        recordLatency("thrift.sync_mpls_fib_ms", callStart);
       } catch (thrift::PlatformFibUpdateError const& fibUpdateError) {
+        recordLatency("thrift.sync_mpls_fib_ms", callStart, true);
         logFibUpdateError(fibUpdateError);
         // Remove failed routes from fibRouteUpdates
         fibRouteUpdates.processFibUpdateError(fibUpdateError);
         // Mark failed routes as dirty in route state
         routeState_.processFibUpdateError(fibUpdateError, retryAt);
       } catch (std::exception const& e) {
+        recordLatency("thrift.sync_mpls_fib_ms", callStart, true);
         client_.reset();
         fb303::fbData->addStatValue(
             "fib.thrift.failure.sync_fib", 1, fb303::COUNT);
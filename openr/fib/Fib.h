@@ -12,6 +12,7 @@
 #include <folly/io/async/AsyncTimeout.h>
 
 #include <openr/common/ExponentialBackoff.h>
+#include <openr/common/LatencyHistogram.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/config/Config.h>
 #include <openr/decision/RibEntry.h>
@@ -111,6 +112,15 @@ class Fib final : public OpenrEventBase {
    */
   folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>> getPerfDb();
 
+  /**
+   * Retrieve latency distribution (p50/p99/p999) of route programming stages,
+   * keyed by stage name. Includes the queueing delay of route updates from
+   * Decision and latency of each FibService thrift call.
+   */
+  folly::SemiFuture<
+      std::unique_ptr<std::map<std::string, thrift::LatencyStats>>>
+  getLatencyStats();
+
   /**
    * API to get reader for fibUpdatesQueue
    */
@@ -121,6 +131,16 @@ class Fib final : public OpenrEventBase {
   Fib(const Fib&) = delete;
   Fib& operator=(const Fib&) = delete;
 
+  /**
+   * Coalesce route updates, received from Decision in order, into a single
+   * update that results in the same FIB state. Repeated updates of a prefix
+   * or label keep only the last one, and addition followed by deletion of a
+   * route that is not programmed yet cancels out. This avoids programming
+   * intermediate states under route churn.
+   */
+  DecisionRouteUpdate coalesceRouteUpdates(
+      std::vector<DecisionRouteUpdate>&& updates) const;
+
   /**
    * Convert local perfDb_ into PerfDataBase
    */
@@ -193,6 +213,24 @@ class Fib final : public OpenrEventBase {
    */
   void updateGlobalCounters();
 
+  /**
+   * Record latency of route programming stage since `startTime`. Sample is
+   * reported as fb303 timeseries `fib.latency.<stage>` and as percentiles in
+   * the rolling histogram of the stage. `isError` additionally counts the
+   * failure of the stage.
+   */
+  void recordLatency(
+      const std::string& stage,
+      const std::chrono::steady_clock::time_point& startTime,
+      bool isError = false);
+
+  /**
+   * Export percentiles of stages with latency recorded since last export.
+   * Invoked once per batch of route programming, as computing percentiles
+   * sorts the window of samples.
+   */
+  void exportLatencyCounters();
+
   /**
    * Create, log, and publish Open/R convergence event through LogSampleQueue
    */
@@ -316,6 +354,12 @@ class Fib final : public OpenrEventBase {
   // Events to capture and indicate performance of protocol convergence.
   std::deque<thrift::PerfEvents> perfDb_;
 
+  // Latency distribution of route programming stages, keyed by stage name
+  std::unordered_map<std::string, LatencyHistogram> latencyStats_;
+
+  // Stages with latency recorded since percentiles were last exported
+  std::unordered_set<std::string> updatedLatencyStages_;
+
   // Create timestamp of recently logged perf event
   int64_t recentPerfEventCreateTs_{0};
 
@@ -5,7 +5,9 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/init/Init.h>
+#include <folly/synchronization/Baton.h>
 #include <glog/logging.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -27,6 +29,8 @@
 using namespace std;
 using namespace openr;
 
+namespace fb303 = facebook::fb303;
+
 using apache::thrift::ThriftServer;
 using apache::thrift::util::ScopedServerThread;
 
@@ -2000,6 +2004,102 @@ TEST_F(FibTestFixture, RouteProgrammingWithPersistentFailure) {
   }
 }
 
+/**
+ * Route updates queued up while Fib is busy must be coalesced into a single
+ * net update. Intermediate states must never be programmed.
+ */
+TEST_F(FibTestFixture, RouteUpdateCoalescing) {
+  fb303::fbData->resetAllData();
+  std::vector<thrift::UnicastRoute> routes;
+
+  //
+  // Initialize FIB to SYNCED state with Prefix1
+  //
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.addRouteToUpdate(
+        RibUnicastEntry(toIPNetwork(prefix1), {path1_2_1}));
+    routeUpdatesQueue.push(std::move(routeUpdate));
+    mockFibHandler_->waitForSyncFib();
+    mockFibHandler_->waitForSyncMplsFib();
+    EXPECT_EQ(1, fibRouteUpdatesQueueReader.get()->size());
+  }
+  const auto addRoutesCount = mockFibHandler_->getAddRoutesCount();
+  const auto addMplsRoutesCount = mockFibHandler_->getAddMplsRoutesCount();
+
+  //
+  // Block Fib event base, so that following updates queue up
+  //
+  folly::Baton<> fibBlocked;
+  folly::Baton<> fibUnblock;
+  fib_->runInEventBaseThread([&]() {
+    fibBlocked.post();
+    fibUnblock.wait();
+  });
+  fibBlocked.wait();
+
+  // 1) Add Prefix2, Prefix3 and Label1
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.addRouteToUpdate(
+        RibUnicastEntry(toIPNetwork(prefix2), {path1_2_1}));
+    routeUpdate.addRouteToUpdate(
+        RibUnicastEntry(toIPNetwork(prefix3), {path1_2_1}));
+    routeUpdate.addMplsRouteToUpdate(RibMplsEntry(label1, {mpls_path1_2_1}));
+    routeUpdatesQueue.push(std::move(routeUpdate));
+  }
+
+  // 2) Update Prefix2, withdraw Prefix3 and Label1 (cancels their addition)
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.addRouteToUpdate(
+        RibUnicastEntry(toIPNetwork(prefix2), {path1_2_2}));
+    routeUpdate.unicastRoutesToDelete.emplace_back(toIPNetwork(prefix3));
+    routeUpdate.mplsRoutesToDelete.emplace_back(label1);
+    routeUpdatesQueue.push(std::move(routeUpdate));
+  }
+
+  // 3) Update Prefix2 again and withdraw programmed Prefix1
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.addRouteToUpdate(
+        RibUnicastEntry(toIPNetwork(prefix2), {path1_2_3}));
+    routeUpdate.unicastRoutesToDelete.emplace_back(toIPNetwork(prefix1));
+    routeUpdatesQueue.push(std::move(routeUpdate));
+  }
+
+  fibUnblock.post();
+
+  //
+  // Verify only net change is programmed and published
+  //
+  mockFibHandler_->waitForUpdateUnicastRoutes();
+  auto publication = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_EQ(DecisionRouteUpdate::INCREMENTAL, publication.type);
+  EXPECT_EQ(2, publication.size());
+  ASSERT_EQ(1, publication.unicastRoutesToUpdate.count(toIPNetwork(prefix2)));
+  EXPECT_EQ(
+      RibUnicastEntry(toIPNetwork(prefix2), {path1_2_3}),
+      publication.unicastRoutesToUpdate.at(toIPNetwork(prefix2)));
+  ASSERT_EQ(1, publication.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(prefix1), publication.unicastRoutesToDelete.at(0));
+  EXPECT_TRUE(publication.mplsRoutesToUpdate.empty());
+  EXPECT_TRUE(publication.mplsRoutesToDelete.empty());
+
+  // Only Prefix2 is added to FIB and no MPLS route is touched
+  EXPECT_EQ(addRoutesCount + 1, mockFibHandler_->getAddRoutesCount());
+  EXPECT_EQ(addMplsRoutesCount, mockFibHandler_->getAddMplsRoutesCount());
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  for (auto const& route : routes) {
+    EXPECT_NE(prefix3, *route.dest_ref());
+  }
+
+  // 7 route entries received, 2 programmed
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_EQ(2, counters.at("fib.route_updates.coalesced.sum"));
+  EXPECT_EQ(5, counters.at("fib.route_updates.elided_routes.sum"));
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -181,11 +181,51 @@ struct DecisionConfig {
   /** Decision time to save rib policy  in frequent setRibPolicy requests
   (in milliseconds). */
   4: i32 save_rib_policy_max_ms = 60000;
+  /**
+   * If set, adjacency database of a node reported as restarting by its
+   * neighbors is frozen for up to given time (in milliseconds). Its updates
+   * are applied once neighbors report the node back or hold expires. This
+   * avoids route computation across the network on graceful restarts.
+   */
+  5: optional i32 graceful_restart_hold_ms;
 
   /** Knob to enable/disable BGP route programming. */
   101: bool enable_bgp_route_programming = true;
 }
 
+/**
+ * Penalty based flap dampening, modeled after BGP route flap dampening
+ * (RFC 2439). Every flap adds `penalty_per_flap` to the penalty of an
+ * interface or adjacency, which decays exponentially with `half_life_ms`. It
+ * is suppressed once penalty exceeds `suppress_threshold` and is reused once
+ * penalty decays below `reuse_threshold`. It is never suppressed for longer
+ * than `max_suppress_time_ms` after the last flap.
+ */
+struct FlapDampeningConfig {
+  1: i32 penalty_per_flap = 1000;
+  2: i32 suppress_threshold = 2000;
+  3: i32 reuse_threshold = 750;
+  4: i32 half_life_ms = 15000;
+  5: i32 max_suppress_time_ms = 60000;
+}
+
+/**
+ * Every change of RTT based metric of an adjacency is flooded through the
+ * network and triggers route computation on every node. To keep RTT noise
+ * from causing such churn, RTT is smoothed with exponentially weighted moving
+ * average, quantized into bands of `quantization_band_us`, and adjacency
+ * metric is updated at most once per `min_hold_time_ms`. RTT has to move at
+ * least one full band away from advertised value to change it.
+ */
+struct RttMetricSmoothingConfig {
+  /** Weight of new RTT sample in moving average, in percent (1-100) */
+  1: i32 ewma_weight_pct = 30;
+  /** Granularity of advertised RTT. Default is 1ms, i.e. 10 metric units */
+  2: i32 quantization_band_us = 1000;
+  /** Minimum time between two metric updates of an adjacency */
+  3: i32 min_hold_time_ms = 10000;
+}
+
 struct LinkMonitorConfig {
   /**
    * When link goes down after being stable/up for long time, then the backoff
@@ -223,6 +263,26 @@ struct LinkMonitorConfig {
   * Enable convergence performance measurement for adjacency updates.
   */
   7: bool enable_perf_measurement = true;
+
+  /**
+  * Advertise each adjacency with its own KvStore key instead of full adjacency
+  * database of the node. Change of a single adjacency then results in update
+  * of a single small key. All nodes in the network must support per adjacency
+  * keys before enabling.
+  */
+  8: bool enable_per_adjacency_keys = false;
+
+  /**
+  * Penalty based dampening of flapping interfaces and adjacencies. Disabled if
+  * not set. Applies on top of link-flap backoff.
+  */
+  9: optional FlapDampeningConfig flap_dampening_config;
+
+  /**
+  * Smoothing of RTT measurements before they are turned into adjacency
+  * metrics. Only effective with `use_rtt_metric`. Disabled if not set.
+  */
+  10: optional RttMetricSmoothingConfig rtt_metric_smoothing_config;
 }
 
 struct StepDetectorConfig {
@@ -233,6 +293,22 @@ struct StepDetectorConfig {
   5: i64 ads_threshold = 500;
 }
 
+/**
+ * BFD style fast liveness detection of Spark neighbors. Compact echo packets
+ * are exchanged with ESTABLISHED neighbors every `tx_interval_ms` from a
+ * dedicated thread. Neighbor is declared DOWN if no echo is received for
+ * `detect_multiplier` intervals advertised by the neighbor. Detection is armed
+ * only after first echo is received, hence it is safe to enable on one side.
+ */
+struct FastLivenessConfig {
+  /** How often to send echo packets to neighbors */
+  1: i32 tx_interval_ms = 30;
+  /** Number of missed echo packets to declare neighbor DOWN */
+  2: i32 detect_multiplier = 3;
+  /** UDP port for send/recv of echo packets */
+  3: i32 port = 6667;
+}
+
 struct SparkConfig {
   1: i32 neighbor_discovery_port = 6666;
   /** How often to send SparkHelloMsg to neighbors. */
@@ -260,6 +336,21 @@ struct SparkConfig {
   6: i32 graceful_restart_time_s = 30;
 
   7: StepDetectorConfig step_detector_conf;
+
+  /**
+   * If set, heartbeats for all interfaces are sent together with a single
+   * sendmmsg and the socket is drained with recvmmsg on every wakeup, instead
+   * of one syscall and timer event per packet. Useful for nodes with many
+   * interfaces.
+   */
+  8: bool enable_batched_io = false;
+
+  /**
+   * If set, detect neighbor failures in tens of milliseconds with fast
+   * liveness engine in addition to heartbeat hold timer.
+   */
+  9: bool enable_fast_liveness = false;
+  10: FastLivenessConfig fast_liveness_config;
 }
 
 struct WatchdogConfig {
@@ -925,6 +1016,24 @@ struct OpenrConfig {
    */
   61: bool enable_ucmp = false;
 
+  /**
+   * Number of netlink sockets used by the default FibService implementation
+   * (see enable_netlink_fib_handler) for programming routes. Each socket runs
+   * on its own thread. Routes are sharded across sockets by prefix (or
+   * top-label) hash, which retains ordering of updates for a given prefix.
+   */
+  62: i32 netlink_fib_handler_num_sockets = 1;
+
+  /**
+   * If set, PrefixManager packs advertised prefixes into this many
+   * PrefixDatabase keys per area instead of one key per prefix. Prefixes are
+   * assigned to buckets by stable hash of the prefix, hence change of a prefix
+   * only re-floods its bucket. This trades a bit of flooding bandwidth per
+   * change for much fewer keys to refresh TTL of and to parse in Decision.
+   * NOTE: all nodes in the network must support bucketed prefix keys.
+   */
+  63: optional i32 prefix_db_key_buckets;
+
   # vip thrift injection service
   90: optional bool enable_vip_service;
   91: optional vip_service_config.VipServiceConfig vip_service_config;
@@ -453,6 +453,15 @@ service OpenrCtrl extends fb303_core.BaseService {
 
   Types.PerfDatabase getPerfDb() throws (1: OpenrError error);
 
+  /**
+   * Get latency distribution of route programming stages in FIB, keyed by
+   * stage name e.g. `queue_wait_ms`, `thrift.add_unicast_routes_ms`. Values
+   * are in milliseconds.
+   */
+  map<string, Types.LatencyStats> getFibLatencyStats() throws (
+    1: OpenrError error,
+  );
+
   //
   // Decision APIs
   //
@@ -656,6 +665,13 @@ service OpenrCtrl extends fb303_core.BaseService {
    */
   Types.DumpLinksReply getInterfaces() throws (1: OpenrError error);
 
+  /**
+   * Get flap dampening state of interfaces and adjacencies
+   */
+  Types.DumpFlapDampeningReply getFlapDampeningStates() throws (
+    1: OpenrError error,
+  );
+
   /**
    * Get the current adjacencies information, only works for nodes with one
    * configured area. DEPRECATED, prefer
@@ -151,6 +151,13 @@ struct Adjacency {
    * adj for route computation.
    */
   12: bool adjOnlyUsedByOtherNode = false;
+
+  /**
+   * Set to true while neighbor is going through graceful restart, i.e. the
+   * adjacency is kept although neighbor is not reachable. Lets other nodes
+   * hold adjacency database of the restarting neighbor.
+   */
+  13: bool isRestarting = false;
 } (cpp.minimize_padding)
 
 /**
@@ -190,6 +197,15 @@ struct AdjacencyDatabase {
    * Area to which this adjacency database belongs.
    */
   6: string area;
+
+  /**
+   * Set if adjacencies of this node are advertised with per adjacency keys
+   * `adj:<thisNodeName>:<otherNodeName>:<ifName>` instead of `adjacencies`
+   * field of node key `adj:<thisNodeName>`. Value of a per adjacency key is
+   * AdjacencyDatabase with single entry in `adjacencies`, or no entry if
+   * adjacency is withdrawn.
+   */
+  7: bool perAdjacencyKeys = false;
 } (cpp.minimize_padding)
 
 /**
@@ -600,6 +616,35 @@ struct PerfDatabase {
   2: list<PerfEvents> eventInfo;
 } (cpp.minimize_padding)
 
+/**
+ * Latency distribution of a stage over a rolling window of most recent
+ * samples, e.g. route programming in FIB.
+ */
+struct LatencyStats {
+  /**
+   * Total number of samples recorded since start
+   */
+  1: i64 count;
+
+  /**
+   * Number of most recent samples over which percentiles are computed
+   */
+  2: i64 windowSize;
+
+  /**
+   * Percentiles and max of the samples in the window
+   */
+  3: i64 p50;
+  4: i64 p99;
+  5: i64 p999;
+  6: i64 max;
+
+  /**
+   * Total number of errors encountered in this stage since start
+   */
+  7: i64 numErrors;
+} (cpp.minimize_padding)
+
 /**
  * Details about an interface in Open/R
  */
@@ -652,6 +697,51 @@ struct DumpLinksReply {
   ) interfaceDetails;
 } (cpp.minimize_padding)
 
+/**
+ * Flap dampening state of an interface or an adjacency
+ */
+struct FlapDampeningState {
+  /**
+   * Current penalty after decay
+   */
+  1: i64 penalty;
+
+  /**
+   * Whether interface or adjacency is suppressed
+   */
+  2: bool isSuppressed;
+
+  /**
+   * Time in milliseconds until suppressed interface or adjacency is reused
+   */
+  3: i64 reuseInMs;
+
+  /**
+   * Total number of flaps and suppressions since dampening state was created
+   */
+  4: i64 numFlaps;
+  5: i64 numSuppressions;
+} (cpp.minimize_padding)
+
+/**
+ * Flap dampening state of an adjacency, identified by (neighbor-node,
+ * local-interface) tuple
+ */
+struct AdjacencyFlapDampeningState {
+  1: string nodeName;
+  2: string ifName;
+  3: FlapDampeningState state;
+}
+
+/**
+ * Flap dampening states of interfaces and adjacencies of this node. Only
+ * interfaces and adjacencies with non-forgotten flap history are reported.
+ */
+struct DumpFlapDampeningReply {
+  1: map<string, FlapDampeningState> interfaces;
+  2: list<AdjacencyFlapDampeningState> adjacencies;
+}
+
 /**
  * Set of attributes to uniquely identify an adjacency. It is identified by
  * (neighbor-node, local-interface) tuple.
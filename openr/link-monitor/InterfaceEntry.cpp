@@ -19,11 +19,15 @@ InterfaceEntry::InterfaceEntry(
     std::chrono::milliseconds const& initBackoff,
     std::chrono::milliseconds const& maxBackoff,
     AsyncThrottle& updateCallback,
-    folly::AsyncTimeout& updateTimeout)
+    folly::AsyncTimeout& updateTimeout,
+    std::optional<FlapDampener::Params> const& dampeningParams)
     : backoff_(initBackoff, maxBackoff),
       updateCallback_(updateCallback),
       updateTimeout_(updateTimeout) {
   CHECK(not ifName.empty());
+  if (dampeningParams.has_value()) {
+    dampener_.emplace(*dampeningParams);
+  }
   // other attributes will be updated via:
   //  - updateAttrs()
   //  - updateAddr()
@@ -42,6 +46,14 @@ InterfaceEntry::updateAttrs(int ifIndex, bool isUp) {
   if (wasUp != isUp and wasUp) {
     // Penalize backoff on transitioning to DOWN state
     backoff_.reportError();
+
+    // Accumulate dampening penalty
+    if (dampener_.has_value() and dampener_->reportFlap()) {
+      XLOG(INFO) << fmt::format(
+          "Interface {} is suppressed by dampening for {}ms",
+          info_.ifName,
+          dampener_->getTimeUntilReuse().count());
+    }
   }
 
   // Look for active to down transition
@@ -67,12 +79,19 @@ InterfaceEntry::isActive() {
   if (now - lastErrorTime > backoff_.getMaxBackoff()) {
     backoff_.reportSuccess();
   }
+  if (dampener_.has_value() and dampener_->isSuppressed()) {
+    return false;
+  }
   return backoff_.canTryNow();
 }
 
 std::chrono::milliseconds
 InterfaceEntry::getBackoffDuration() const {
-  return backoff_.getTimeRemainingUntilRetry();
+  auto duration = backoff_.getTimeRemainingUntilRetry();
+  if (dampener_.has_value()) {
+    duration = std::max(duration, dampener_->getTimeUntilReuse());
+  }
+  return duration;
 }
 
 bool
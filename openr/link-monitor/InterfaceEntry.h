@@ -7,10 +7,13 @@
 
 #pragma once
 
+#include <optional>
+
 #include <folly/io/async/AsyncTimeout.h>
 
 #include <openr/common/AsyncThrottle.h>
 #include <openr/common/ExponentialBackoff.h>
+#include <openr/common/FlapDampener.h>
 #include <openr/common/Types.h>
 
 namespace openr {
@@ -23,6 +26,8 @@ namespace openr {
  * - Any change will always trigger throttled callback
  * - Interface transition from Active to Inactive schedules immediate timeout
  *   for fast reactions to down events.
+ * - If dampening is enabled, UP to DOWN transitions are reported as flaps and
+ *   interface stays inactive while suppressed.
  */
 class InterfaceEntry final {
  public:
@@ -31,7 +36,9 @@ class InterfaceEntry final {
       std::chrono::milliseconds const& initBackoff,
       std::chrono::milliseconds const& maxBackoff,
       AsyncThrottle& updateCallback,
-      folly::AsyncTimeout& updateTimeout);
+      folly::AsyncTimeout& updateTimeout,
+      std::optional<FlapDampener::Params> const& dampeningParams =
+          std::nullopt);
 
   // Update attributes
   bool updateAttrs(int ifIndex, bool isUp);
@@ -40,12 +47,18 @@ class InterfaceEntry final {
   bool updateAddr(folly::CIDRNetwork const& ipNetwork, bool isValid);
 
   // Is interface active. Interface is active only when it is in UP state and
-  // it's not backed off
+  // it's neither backed off nor suppressed by dampening
   bool isActive();
 
-  // Get backoff time
+  // Get backoff time. Includes remaining suppression time if dampened.
   std::chrono::milliseconds getBackoffDuration() const;
 
+  // Flap dampening state if dampening is enabled
+  FlapDampener const* FOLLY_NULLABLE
+  getDampener() const {
+    return dampener_.has_value() ? &dampener_.value() : nullptr;
+  }
+
   // Used to check for updates if doing a re-sync
   bool
   operator==(const InterfaceEntry& interfaceEntry) {
@@ -90,6 +103,9 @@ class InterfaceEntry final {
   // Backoff variables
   ExponentialBackoff<std::chrono::milliseconds> backoff_;
 
+  // Penalty based flap dampening (optional)
+  std::optional<FlapDampener> dampener_;
+
   // Update callback
   AsyncThrottle& updateCallback_;
   folly::AsyncTimeout& updateTimeout_;
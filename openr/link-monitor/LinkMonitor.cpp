@@ -53,6 +53,49 @@ printLinkMonitorState(openr::thrift::LinkMonitorState const& state) {
   }
 }
 
+std::optional<openr::FlapDampener::Params>
+getFlapDampeningParams(openr::thrift::LinkMonitorConfig const& lmConf) {
+  const auto& dampConf = lmConf.flap_dampening_config_ref();
+  if (not dampConf.has_value()) {
+    return std::nullopt;
+  }
+
+  openr::FlapDampener::Params params;
+  params.penaltyPerFlap = *dampConf->penalty_per_flap_ref();
+  params.suppressThreshold = *dampConf->suppress_threshold_ref();
+  params.reuseThreshold = *dampConf->reuse_threshold_ref();
+  params.halfLife = std::chrono::milliseconds(*dampConf->half_life_ms_ref());
+  params.maxSuppressTime =
+      std::chrono::milliseconds(*dampConf->max_suppress_time_ms_ref());
+  return params;
+}
+
+std::optional<openr::MetricSmoother::Params>
+getRttSmoothingParams(openr::thrift::LinkMonitorConfig const& lmConf) {
+  const auto& smoothConf = lmConf.rtt_metric_smoothing_config_ref();
+  if (not lmConf.get_use_rtt_metric() or not smoothConf.has_value()) {
+    return std::nullopt;
+  }
+
+  openr::MetricSmoother::Params params;
+  params.ewmaWeightPct = *smoothConf->ewma_weight_pct_ref();
+  params.quantizationBand = *smoothConf->quantization_band_us_ref();
+  params.minHoldTime =
+      std::chrono::milliseconds(*smoothConf->min_hold_time_ms_ref());
+  return params;
+}
+
+openr::thrift::FlapDampeningState
+toThrift(openr::FlapDampener const& dampener) {
+  openr::thrift::FlapDampeningState state;
+  state.penalty_ref() = static_cast<int64_t>(dampener.getPenalty());
+  state.isSuppressed_ref() = dampener.isSuppressed();
+  state.reuseInMs_ref() = dampener.getTimeUntilReuse().count();
+  state.numFlaps_ref() = dampener.getNumFlaps();
+  state.numSuppressions_ref() = dampener.getNumSuppressions();
+  return state;
+}
+
 } // anonymous namespace
 
 namespace openr {
@@ -80,6 +123,12 @@ struct LinkMonitor::NetlinkEventProcessor {
 
   void
   operator()(fbnl::Rule&&) {}
+
+  void
+  operator()(fbnl::EventsDropped&& dropped) {
+    lm_.requestInterfaceSync(
+        fmt::format("{} netlink events dropped", dropped.count));
+  }
 };
 
 //
@@ -101,6 +150,12 @@ LinkMonitor::LinkMonitor(
     : nodeId_(config->getNodeName()),
       enablePerfMeasurement_(
           config->getLinkMonitorConfig().get_enable_perf_measurement()),
+      enablePerAdjacencyKeys_(
+          config->getLinkMonitorConfig().get_enable_per_adjacency_keys()),
+      advertiseRestartingAdjacencies_(config->getConfig()
+                                          .decision_config_ref()
+                                          ->graceful_restart_hold_ms_ref()
+                                          .has_value()),
       enableV4_(config->isV4Enabled()),
       enableSegmentRouting_(config->isSegmentRoutingEnabled()),
       enableNewGRBehavior_(config->isNewGRBehaviorEnabled()),
@@ -112,6 +167,10 @@ LinkMonitor::LinkMonitor(
           *config->getLinkMonitorConfig().linkflap_initial_backoff_ms_ref())),
       linkflapMaxBackoff_(std::chrono::milliseconds(
           *config->getLinkMonitorConfig().linkflap_max_backoff_ms_ref())),
+      flapDampeningParams_(
+          getFlapDampeningParams(config->getLinkMonitorConfig())),
+      rttSmoothingParams_(
+          getRttSmoothingParams(config->getLinkMonitorConfig())),
       areas_(config->getAreas()),
       enableOrderedAdjPublication_(
           config->getConfig().get_enable_ordered_adj_publication()),
@@ -158,6 +217,16 @@ LinkMonitor::LinkMonitor(
   advertiseIfaceAddrTimer_ = folly::AsyncTimeout::make(
       *getEvb(), [this]() noexcept { advertiseIfaceAddr(); });
 
+  // Create timer to re-advertise adjacencies once they are no longer
+  // suppressed by flap dampening
+  adjDampeningTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+    advertiseAdjacenciesThrottled_->operator()();
+  });
+
+  // Create timer to apply RTT metric updates deferred by hold time
+  rttMetricHoldTimer_ = folly::AsyncTimeout::make(
+      *getEvb(), [this]() noexcept { processPendingRttMetricUpdates(); });
+
   // Create config-store client
   XLOG(INFO) << "Loading link-monitor state";
   auto state =
@@ -251,7 +320,7 @@ LinkMonitor::LinkMonitor(
     }
   });
 
-  // Add fiber to process interfaceDb syning from netlink platform
+  // Add fiber to sync interfaceDb from netlink platform on demand
   addFiberTask([this]() mutable noexcept { syncInterfaceTask(); });
 
   // Initialize stats keys
@@ -260,14 +329,29 @@ LinkMonitor::LinkMonitor(
   fb303::fbData->addStatExportType(
       "link_monitor.advertise_adjacencies", fb303::SUM);
   fb303::fbData->addStatExportType("link_monitor.advertise_links", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.advertise_adjacencies.keys", fb303::SUM);
   fb303::fbData->addStatExportType(
       "link_monitor.sync_interface.failure", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.sync_interface.requested", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.dampening.adjacency_flaps", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.dampening.adjacency_suppressed", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.rtt_metric.updated", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.rtt_metric.suppressed", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.rtt_metric.deferred", fb303::SUM);
 }
 
 void
 LinkMonitor::stop() {
   // Send stop signal for internal fibers
-  syncInterfaceStopSignal_.post();
+  syncInterfaceStopped_ = true;
+  syncInterfaceSignal_.post();
   XLOG(INFO) << "Successfully posted stop signal for interface-syncing fiber";
 
   // Invoke stop method of super class
@@ -294,6 +378,14 @@ LinkMonitor::neighborUpEvent(
   const auto supportFloodOptimization = *info.enableFloodOptimization_ref();
   const auto onlyUsedByOtherNode = *info.adjOnlyUsedByOtherNode_ref();
 
+  // Smooth RTT measurements of this adjacency from now on
+  std::optional<MetricSmoother> rttSmoother;
+  int64_t advertisedRttUs = rttUs;
+  if (rttSmoothingParams_.has_value()) {
+    rttSmoother.emplace(*rttSmoothingParams_, rttUs);
+    advertisedRttUs = rttSmoother->getValue();
+  }
+
   // current unixtime
   auto now = std::chrono::system_clock::now();
   int64_t timestamp =
@@ -305,10 +397,10 @@ LinkMonitor::neighborUpEvent(
       localIfName /* local ifName neighbor discovered on */,
       toString(neighborAddrV6) /* nextHopV6 */,
       toString(neighborAddrV4) /* nextHopV4 */,
-      useRttMetric_ ? getRttMetric(rttUs) : 1 /* metric */,
+      useRttMetric_ ? getRttMetric(advertisedRttUs) : 1 /* metric */,
       enableSegmentRouting_ ? *info.label_ref() : 0 /* adjacency-label */,
       false /* overload bit */,
-      useRttMetric_ ? rttUs : 0 /* rtt */,
+      useRttMetric_ ? advertisedRttUs : 0 /* rtt */,
       timestamp,
       1 /* weight */,
       remoteIfName);
@@ -376,6 +468,7 @@ LinkMonitor::neighborUpEvent(
       std::move(newAdj),
       isRestarting,
       isGracefulRestart ? false : onlyUsedByOtherNode);
+  adjacencies_[adjId].rttSmoother = std::move(rttSmoother);
 
   // update kvstore peer
   updateKvStorePeerNeighborUp(area, adjId, adjacencies_[adjId]);
@@ -440,6 +533,23 @@ LinkMonitor::neighborDownEvent(const thrift::SparkNeighbor& info) {
   // remove such adjacencies
   adjacencies_.erase(adjValueIt);
 
+  // penalize adjacency for flapping
+  if (flapDampeningParams_.has_value()) {
+    auto& dampener =
+        adjDampeners_.try_emplace(adjId, *flapDampeningParams_).first->second;
+    fb303::fbData->addStatValue(
+        "link_monitor.dampening.adjacency_flaps", 1, fb303::SUM);
+    if (dampener.reportFlap()) {
+      XLOG(INFO) << fmt::format(
+          "Adjacency [{}, {}] is suppressed by dampening for {}ms",
+          remoteNodeName,
+          localIfName,
+          dampener.getTimeUntilReuse().count());
+      fb303::fbData->addStatValue(
+          "link_monitor.dampening.adjacency_suppressed", 1, fb303::SUM);
+    }
+  }
+
   // advertise adjacencies
   advertiseAdjacencies(area);
 }
@@ -468,6 +578,11 @@ LinkMonitor::neighborRestartingEvent(const thrift::SparkNeighbor& info) {
 
   // update KvStore Peer
   updateKvStorePeerNeighborDown(area, adjId, adjValueIt->second);
+
+  // let other nodes know that neighbor is restarting
+  if (advertiseRestartingAdjacencies_) {
+    advertiseAdjacenciesThrottled_->operator()();
+  }
 }
 
 void
@@ -475,18 +590,96 @@ LinkMonitor::neighborRttChangeEvent(const thrift::SparkNeighbor& info) {
   const auto& remoteNodeName = *info.nodeName_ref();
   const auto& localIfName = *info.localIfName_ref();
   const auto& rttUs = *info.rttUs_ref();
-  int32_t newRttMetric = getRttMetric(rttUs);
 
+  auto it = adjacencies_.find({remoteNodeName, localIfName});
+  if (it == adjacencies_.end()) {
+    return;
+  }
+
+  int64_t newRttUs = rttUs;
+  auto& rttSmoother = it->second.rttSmoother;
+  if (rttSmoother.has_value()) {
+    switch (rttSmoother->addSample(rttUs)) {
+    case MetricSmoother::Result::UPDATED:
+      fb303::fbData->addStatValue(
+          "link_monitor.rtt_metric.updated", 1, fb303::SUM);
+      newRttUs = rttSmoother->getValue();
+      break;
+    case MetricSmoother::Result::SUPPRESSED:
+      XLOG(DBG2) << "RTT change to " << rttUs << "us for neighbor "
+                 << remoteNodeName << " on interface: " << localIfName
+                 << " is within band. Skip metric update.";
+      fb303::fbData->addStatValue(
+          "link_monitor.rtt_metric.suppressed", 1, fb303::SUM);
+      return;
+    case MetricSmoother::Result::DEFERRED:
+      XLOG(DBG2) << "RTT change to " << rttUs << "us for neighbor "
+                 << remoteNodeName << " on interface: " << localIfName
+                 << " is deferred by hold time.";
+      fb303::fbData->addStatValue(
+          "link_monitor.rtt_metric.deferred", 1, fb303::SUM);
+      scheduleRttMetricHoldTimer(rttSmoother->getTimeUntilUpdate());
+      return;
+    }
+  }
+
+  int32_t newRttMetric = getRttMetric(newRttUs);
   XLOG(DBG1) << "Metric value changed for neighbor " << remoteNodeName
              << " on interface: " << localIfName << " to " << newRttMetric;
 
-  auto it = adjacencies_.find({remoteNodeName, localIfName});
-  if (it != adjacencies_.end()) {
-    auto& adj = it->second.adjacency;
-    adj.metric_ref() = newRttMetric;
-    adj.rtt_ref() = rttUs;
+  auto& adj = it->second.adjacency;
+  adj.metric_ref() = newRttMetric;
+  adj.rtt_ref() = newRttUs;
+  advertiseAdjacenciesThrottled_->operator()();
+}
+
+void
+LinkMonitor::processPendingRttMetricUpdates() {
+  std::optional<std::chrono::milliseconds> minHoldTime;
+  bool isUpdated{false};
+  for (auto& [adjKey, adjValue] : adjacencies_) {
+    auto& rttSmoother = adjValue.rttSmoother;
+    if (not rttSmoother.has_value() or not rttSmoother->hasPendingUpdate()) {
+      continue;
+    }
+
+    if (rttSmoother->applyPendingUpdate()) {
+      const auto newRttUs = rttSmoother->getValue();
+      XLOG(DBG1) << "Metric value changed for neighbor " << adjKey.first
+                 << " on interface: " << adjKey.second << " to "
+                 << getRttMetric(newRttUs) << " after hold time";
+      fb303::fbData->addStatValue(
+          "link_monitor.rtt_metric.updated", 1, fb303::SUM);
+      adjValue.adjacency.metric_ref() = getRttMetric(newRttUs);
+      adjValue.adjacency.rtt_ref() = newRttUs;
+      isUpdated = true;
+    } else if (rttSmoother->hasPendingUpdate()) {
+      const auto holdTime = rttSmoother->getTimeUntilUpdate();
+      minHoldTime = std::min(minHoldTime.value_or(holdTime), holdTime);
+    } else {
+      // RTT has settled back within band during hold time
+      fb303::fbData->addStatValue(
+          "link_monitor.rtt_metric.suppressed", 1, fb303::SUM);
+    }
+  }
+
+  if (isUpdated) {
     advertiseAdjacenciesThrottled_->operator()();
   }
+  if (minHoldTime.has_value()) {
+    scheduleRttMetricHoldTimer(*minHoldTime);
+  }
+}
+
+void
+LinkMonitor::scheduleRttMetricHoldTimer(std::chrono::milliseconds holdTime) {
+  const auto deadline = std::chrono::steady_clock::now() + holdTime;
+  if (rttMetricHoldTimer_->isScheduled() and
+      rttMetricHoldDeadline_ <= deadline) {
+    return;
+  }
+  rttMetricHoldTimer_->scheduleTimeout(holdTime);
+  rttMetricHoldDeadline_ = deadline;
 }
 
 void
@@ -672,12 +865,19 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
       adjDb.get_adjacencies().size(),
       area);
 
-  // Persist `adj:node_Id` key into KvStore
-  const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
-  std::string adjDbStr = writeThriftObjStr(adjDb, serializer_);
-  auto persistAdjacencyKeyVal =
-      PersistKeyValueRequest(AreaId{area}, keyName, adjDbStr);
-  kvRequestQueue_.push(std::move(persistAdjacencyKeyVal));
+  if (enablePerAdjacencyKeys_) {
+    advertisePerAdjacencyKeys(area, std::move(adjDb));
+  } else {
+    // Persist `adj:node_Id` key into KvStore
+    const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
+    std::string adjDbStr = writeThriftObjStr(adjDb, serializer_);
+    auto persistAdjacencyKeyVal =
+        PersistKeyValueRequest(AreaId{area}, keyName, adjDbStr);
+    kvRequestQueue_.push(std::move(persistAdjacencyKeyVal));
+  }
+
+  // Re-advertise once suppressed adjacencies can be reused
+  scheduleAdjDampeningTimer();
 
   // Config is most likely to have changed. Update it in `ConfigStore`
   configStore_->storeThriftObj(kConfigKey, state_); // not awaiting on result
@@ -692,6 +892,86 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
         "link_monitor.metric." + *adj.otherNodeName_ref(), *adj.metric_ref());
   }
 }
+
+void
+LinkMonitor::advertisePerAdjacencyKeys(
+    const std::string& area, thrift::AdjacencyDatabase&& adjDb) {
+  auto& advertisedAdjDb = advertisedAdjDbs_[area];
+
+  // Split adjacencies out of node's adjacency database
+  std::map<AdjacencyKey, thrift::Adjacency> adjacencies;
+  for (auto& adj : *adjDb.adjacencies_ref()) {
+    AdjacencyKey adjKey(*adj.otherNodeName_ref(), *adj.ifName_ref());
+    adjacencies.emplace(std::move(adjKey), std::move(adj));
+  }
+  adjDb.adjacencies_ref()->clear();
+  adjDb.perAdjacencyKeys_ref() = true;
+
+  // Value of per adjacency key, carrying none or single adjacency
+  auto makePerAdjacencyDb = [&]() {
+    thrift::AdjacencyDatabase perAdjDb;
+    perAdjDb.thisNodeName_ref() = nodeId_;
+    perAdjDb.area_ref() = area;
+    perAdjDb.perAdjacencyKeys_ref() = true;
+    if (adjDb.perfEvents_ref().has_value()) {
+      perAdjDb.perfEvents_ref() = *adjDb.perfEvents_ref();
+    }
+    return perAdjDb;
+  };
+
+  size_t numKeysUpdated{0};
+
+  // Withdraw adjacencies which are gone. Value without adjacency is
+  // advertised, and key expires afterwards.
+  for (const auto& [adjKey, _] : advertisedAdjDb.adjacencies) {
+    if (adjacencies.count(adjKey)) {
+      continue;
+    }
+    kvRequestQueue_.push(ClearKeyValueRequest(
+        AreaId{area},
+        getAdjacencyKey(nodeId_, adjKey.first, adjKey.second),
+        writeThriftObjStr(makePerAdjacencyDb(), serializer_),
+        true /* setValue */));
+    ++numKeysUpdated;
+  }
+
+  // Persist new or changed adjacencies
+  for (const auto& [adjKey, adj] : adjacencies) {
+    auto it = advertisedAdjDb.adjacencies.find(adjKey);
+    if (it != advertisedAdjDb.adjacencies.end() and it->second == adj) {
+      continue;
+    }
+    auto perAdjDb = makePerAdjacencyDb();
+    perAdjDb.adjacencies_ref()->emplace_back(adj);
+    kvRequestQueue_.push(PersistKeyValueRequest(
+        AreaId{area},
+        getAdjacencyKey(nodeId_, adjKey.first, adjKey.second),
+        writeThriftObjStr(perAdjDb, serializer_)));
+    ++numKeysUpdated;
+  }
+  advertisedAdjDb.adjacencies = std::move(adjacencies);
+
+  // Persist `adj:node_Id` key carrying node attributes, if changed
+  auto perfEvents = adjDb.perfEvents_ref().to_optional();
+  adjDb.perfEvents_ref().reset();
+  if (advertisedAdjDb.nodeAdjDb != adjDb) {
+    advertisedAdjDb.nodeAdjDb = adjDb;
+    if (perfEvents.has_value()) {
+      adjDb.perfEvents_ref() = std::move(*perfEvents);
+    }
+    kvRequestQueue_.push(PersistKeyValueRequest(
+        AreaId{area},
+        Constants::kAdjDbMarker.toString() + nodeId_,
+        writeThriftObjStr(adjDb, serializer_)));
+    ++numKeysUpdated;
+  }
+
+  XLOG(DBG1) << fmt::format(
+      "Updated {} adjacency keys in area: {}", numKeysUpdated, area);
+  fb303::fbData->addStatValue(
+      "link_monitor.advertise_adjacencies.keys", numKeysUpdated, fb303::SUM);
+}
+
 void
 LinkMonitor::advertiseAdjacencies() {
   // advertise to all areas. Once area configuration per link is implemented
@@ -729,7 +1009,13 @@ LinkMonitor::advertiseInterfaces() {
 
   // Create interface database
   InterfaceDatabase ifDb;
+  int64_t numSuppressed{0};
   for (auto& [_, interface] : interfaces_) {
+    const auto dampener = interface.getDampener();
+    if (dampener and dampener->isSuppressed()) {
+      ++numSuppressed;
+    }
+
     // Perform regex match
     if (not anyAreaShouldDiscoverOnIface(interface.getIfName())) {
       continue;
@@ -746,6 +1032,11 @@ LinkMonitor::advertiseInterfaces() {
 
   // publish via replicate queue
   interfaceUpdatesQueue_.push(std::move(ifDb));
+
+  if (flapDampeningParams_.has_value()) {
+    fb303::fbData->setCounter(
+        "link_monitor.dampening.suppressed_interfaces", numSuppressed);
+  }
 }
 
 void
@@ -904,6 +1195,42 @@ LinkMonitor::shouldSkipAdjAnnouncement(
   return false;
 }
 
+bool
+LinkMonitor::isAdjacencySuppressed(const AdjacencyKey& adjKey) const {
+  auto it = adjDampeners_.find(adjKey);
+  return it != adjDampeners_.end() and it->second.isSuppressed();
+}
+
+void
+LinkMonitor::scheduleAdjDampeningTimer() {
+  if (not flapDampeningParams_.has_value()) {
+    return;
+  }
+
+  std::optional<std::chrono::milliseconds> minReuseTime;
+  int64_t numSuppressed{0};
+  for (auto it = adjDampeners_.begin(); it != adjDampeners_.end();) {
+    auto& [adjKey, dampener] = *it;
+    if (dampener.canForget()) {
+      it = adjDampeners_.erase(it);
+      continue;
+    }
+    // Only adjacencies which are up need to be re-advertised
+    if (dampener.isSuppressed() and adjacencies_.count(adjKey)) {
+      ++numSuppressed;
+      const auto reuseTime = dampener.getTimeUntilReuse();
+      minReuseTime = std::min(minReuseTime.value_or(reuseTime), reuseTime);
+    }
+    ++it;
+  }
+
+  fb303::fbData->setCounter(
+      "link_monitor.dampening.suppressed_adjacencies", numSuppressed);
+  if (minReuseTime.has_value()) {
+    adjDampeningTimer_->scheduleTimeout(*minReuseTime);
+  }
+}
+
 thrift::AdjacencyDatabase
 LinkMonitor::buildAdjacencyDatabase(const std::string& area) {
   // prepare adjacency database
@@ -938,6 +1265,14 @@ LinkMonitor::buildAdjacencyDatabase(const std::string& area) {
       continue;
     }
 
+    if (isAdjacencySuppressed(adjKey)) {
+      XLOG(DBG1) << fmt::format(
+          "Skip announcement of adjKey: [{}, {}] suppressed by dampening.",
+          adjKey.first,
+          adjKey.second);
+      continue;
+    }
+
     // NOTE: copy on purpose
     auto adj = folly::copy(adjValue.adjacency);
 
@@ -961,6 +1296,10 @@ LinkMonitor::buildAdjacencyDatabase(const std::string& area) {
     // set flag to indicate if adjacency will ONLY be used by other node
     adj.adjOnlyUsedByOtherNode_ref() = adjValue.onlyUsedByOtherNode;
 
+    // set flag to indicate if neighbor is gracefully restarting
+    adj.isRestarting_ref() =
+        advertiseRestartingAdjacencies_ and adjValue.isRestarting;
+
     adjDb.adjacencies_ref()->emplace_back(std::move(adj));
   }
 
@@ -998,35 +1337,66 @@ LinkMonitor::getOrCreateInterfaceEntry(const std::string& ifName) {
           linkflapInitBackoff_,
           linkflapMaxBackoff_,
           *advertiseIfaceAddrThrottled_,
-          *advertiseIfaceAddrTimer_));
+          *advertiseIfaceAddrTimer_,
+          flapDampeningParams_));
 
   return &(res.first->second);
 }
 
+void
+LinkMonitor::requestInterfaceSync(const std::string& reason) {
+  XLOG(INFO) << fmt::format(
+      "[Interface Sync] Requesting interfaceDb sync. Reason: {}", reason);
+  fb303::fbData->addStatValue(
+      "link_monitor.sync_interface.requested", 1, fb303::SUM);
+
+  ++numSyncInterfaceRequested_;
+  syncInterfaceSignal_.post();
+}
+
 void
 LinkMonitor::syncInterfaceTask() noexcept {
   XLOG(INFO) << "[Interface Sync] Starting interface syncing fiber task";
 
   // ATTN: use initial timeoff as the default value to wait for
-  // small amount of time when thread starts before syncing
-  std::chrono::milliseconds timeout{expBackoff_.getInitialBackoff()};
+  // small amount of time when thread starts before syncing. Afterwards, wait
+  // for sync request unless retrying failed sync.
+  std::optional<std::chrono::milliseconds> timeout{
+      expBackoff_.getInitialBackoff()};
 
   while (true) { // Break when stop signal is ready
     // Sleep before next check
-    if (syncInterfaceStopSignal_.try_wait_for(timeout)) {
-      break; // Baton was posted
+    if (timeout.has_value()) {
+      syncInterfaceSignal_.try_wait_for(*timeout);
     } else {
-      syncInterfaceStopSignal_.reset(); // Baton experienced timeout
+      syncInterfaceSignal_.wait();
+    }
+    syncInterfaceSignal_.reset();
+    if (syncInterfaceStopped_) {
+      break;
+    }
+
+    // Nothing to do if no sync is pending. Interface state is kept up to date
+    // by netlink events.
+    const auto numSyncRequested = numSyncInterfaceRequested_;
+    if (numSyncRequested == numSyncInterfaceDone_) {
+      timeout = std::nullopt;
+      continue;
+    }
+
+    // Respect backoff of failed sync, if woken up by new request
+    if (not expBackoff_.canTryNow()) {
+      timeout = expBackoff_.getTimeRemainingUntilRetry();
+      continue;
     }
 
     auto success = syncInterfaces();
     if (success) {
       expBackoff_.reportSuccess();
-      timeout = std::chrono::milliseconds(Constants::kPlatformSyncInterval);
+      numSyncInterfaceDone_ = numSyncRequested;
+      timeout = std::nullopt;
 
-      XLOG(DBG2) << fmt::format(
-          "[Interface Sync] Successfully synced interfaceDb. Schedule next sync in {}ms",
-          timeout.count());
+      XLOG(DBG2) << "[Interface Sync] Successfully synced interfaceDb.";
     } else {
       // Apply exponential backoff and schedule next run
       expBackoff_.reportError();
@@ -1037,7 +1407,7 @@ LinkMonitor::syncInterfaceTask() noexcept {
 
       XLOG(ERR) << fmt::format(
           "[Interface Sync] Failed to sync interfaceDb, apply exp backoff and retry in {}ms",
-          timeout.count());
+          timeout->count());
     }
   } // while
 
@@ -1159,6 +1529,10 @@ LinkMonitor::processAddressEvent(fbnl::IfAddress&& addr) {
   if (it == ifIndexToName_.end()) {
     XLOG(ERR)
         << fmt::format("Address event for unknown iface index: {}", ifIndex);
+
+    // Link event for this interface must have been missed
+    requestInterfaceSync(
+        fmt::format("address event for unknown iface index {}", ifIndex));
     return;
   }
 
@@ -1474,6 +1848,34 @@ LinkMonitor::semifuture_getInterfaces() {
   return sf;
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::DumpFlapDampeningReply>>
+LinkMonitor::semifuture_getFlapDampeningStates() {
+  folly::Promise<std::unique_ptr<thrift::DumpFlapDampeningReply>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([this, p = std::move(p)]() mutable {
+    thrift::DumpFlapDampeningReply reply;
+    for (auto const& [ifName, interface] : interfaces_) {
+      const auto dampener = interface.getDampener();
+      if (dampener and not dampener->canForget()) {
+        reply.interfaces_ref()->emplace(ifName, toThrift(*dampener));
+      }
+    }
+    for (auto const& [adjKey, dampener] : adjDampeners_) {
+      if (dampener.canForget()) {
+        continue;
+      }
+      thrift::AdjacencyFlapDampeningState adjState;
+      adjState.nodeName_ref() = adjKey.first;
+      adjState.ifName_ref() = adjKey.second;
+      adjState.state_ref() = toThrift(dampener);
+      reply.adjacencies_ref()->emplace_back(std::move(adjState));
+    }
+    p.setValue(
+        std::make_unique<thrift::DumpFlapDampeningReply>(std::move(reply)));
+  });
+  return sf;
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdjacencyDatabase>>>
 LinkMonitor::semifuture_getAdjacencies(thrift::AdjacenciesFilter filter) {
   XLOG(DBG2) << "Dump adj requested, reply with " << adjacencies_.size()
@@ -14,6 +14,8 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/AsyncThrottle.h>
+#include <openr/common/FlapDampener.h>
+#include <openr/common/MetricSmoother.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/common/Types.h>
 #include <openr/config-store/PersistentStore.h>
@@ -36,6 +38,8 @@ struct AdjacencyValue {
   thrift::Adjacency adjacency;
   bool isRestarting{false};
   bool onlyUsedByOtherNode{false};
+  // Smoothing of measured RTT, if RTT metric smoothing is enabled
+  std::optional<MetricSmoother> rttSmoother;
 
   AdjacencyValue() {}
   AdjacencyValue(
@@ -142,6 +146,7 @@ class LinkMonitor final : public OpenrEventBase {
    * - Dump interface/link information
    * - Dump adjacency database information
    * - Dump links information from netlinkProtocolSocket
+   * - Dump flap dampening state of interfaces and adjacencies
    */
   folly::SemiFuture<folly::Unit> semifuture_setNodeOverload(bool isOverloaded);
   folly::SemiFuture<folly::Unit> semifuture_setInterfaceOverload(
@@ -157,6 +162,8 @@ class LinkMonitor final : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdjacencyDatabase>>>
   semifuture_getAdjacencies(thrift::AdjacenciesFilter filter = {});
   folly::SemiFuture<InterfaceDatabase> semifuture_getAllLinks();
+  folly::SemiFuture<std::unique_ptr<thrift::DumpFlapDampeningReply>>
+  semifuture_getFlapDampeningStates();
 
  private:
   // make no-copy
@@ -187,8 +194,11 @@ class LinkMonitor final : public OpenrEventBase {
    * [Netlink Platform]
    *
    * LinkMonitor maintains multiple fiber tasks to:
-   *  1) retrieve interface from netlink for initial/periodic interface sync;
-   *  2) process LINK/ADDR event updates from platform
+   *  1) process LINK/ADDR event updates from platform;
+   *  2) retrieve interface from netlink for initial interface sync, and
+   *     re-sync only if event stream is known to have lost events, i.e.
+   *     netlink reported ENOBUFS or an event is inconsistent with state built
+   *     from previous events.
    */
 
   // visitor dispatcher class we use to parse messages for further processing
@@ -197,6 +207,9 @@ class LinkMonitor final : public OpenrEventBase {
   void processLinkEvent(fbnl::Link&& link);
   void processAddressEvent(fbnl::IfAddress&& addr);
 
+  // Schedule full interface sync from netlink
+  void requestInterfaceSync(const std::string& reason);
+
   void syncInterfaceTask() noexcept;
   bool syncInterfaces();
 
@@ -240,6 +253,16 @@ class LinkMonitor final : public OpenrEventBase {
   void advertiseAdjacencies(const std::string& area);
   void advertiseAdjacencies(); // Advertise my adjacencies_ in to all areas
 
+  /*
+   * [Kvstore] Advertise adjacency database with per adjacency keys
+   *
+   * Only adjacencies changed since last advertisement in the area are
+   * persisted, and removed ones are withdrawn. Node key carries node attributes
+   * only and is updated on their change.
+   */
+  void advertisePerAdjacencyKeys(
+      const std::string& area, thrift::AdjacencyDatabase&& adjDb);
+
   /*
    * [Spark/Fib] Advertise interfaces_ over interfaceUpdatesQueue_ to Spark/Fib
    *
@@ -278,6 +301,21 @@ class LinkMonitor final : public OpenrEventBase {
   bool shouldSkipAdjAnnouncement(
       const AdjacencyKey& adjKey, const AdjacencyValue& adjVal);
 
+  // Is adjacency suppressed by flap dampening
+  bool isAdjacencySuppressed(const AdjacencyKey& adjKey) const;
+
+  // Forget decayed adjacency dampening state and schedule re-advertisement of
+  // adjacencies at the end of their suppression
+  void scheduleAdjDampeningTimer();
+
+  // Apply RTT metric updates deferred by smoothing hold time, and schedule
+  // timer for the ones still pending
+  void processPendingRttMetricUpdates();
+
+  // Schedule timer for RTT metric updates deferred by smoothing hold time,
+  // unless it is already scheduled to fire earlier
+  void scheduleRttMetricHoldTimer(std::chrono::milliseconds holdTime);
+
   // build AdjacencyDatabase
   thrift::AdjacencyDatabase buildAdjacencyDatabase(const std::string& area);
 
@@ -324,6 +362,11 @@ class LinkMonitor final : public OpenrEventBase {
   const std::string nodeId_;
   // enable performance measurement
   const bool enablePerfMeasurement_{false};
+  // advertise adjacencies with per adjacency keys
+  const bool enablePerAdjacencyKeys_{false};
+  // advertise restarting flag of adjacencies so that other nodes can hold
+  // adjacency database of gracefully restarting neighbors
+  const bool advertiseRestartingAdjacencies_{false};
   // enable v4
   bool enableV4_{false};
   // enable segment routing
@@ -341,6 +384,10 @@ class LinkMonitor final : public OpenrEventBase {
   // link flap back offs
   std::chrono::milliseconds linkflapInitBackoff_;
   std::chrono::milliseconds linkflapMaxBackoff_;
+  // flap dampening of interfaces and adjacencies. Disabled if not set.
+  const std::optional<FlapDampener::Params> flapDampeningParams_;
+  // smoothing of RTT based metric. Disabled if not set.
+  const std::optional<MetricSmoother::Params> rttSmoothingParams_;
 
   std::unordered_map<std::string, AreaConfiguration> const areas_;
 
@@ -381,6 +428,20 @@ class LinkMonitor final : public OpenrEventBase {
   // (we use the "min" interface) for tcp connection
   std::unordered_map<AdjacencyKey, AdjacencyValue> adjacencies_;
 
+  // Adjacency database last advertised with per adjacency keys
+  struct AdvertisedAdjacencyDb {
+    // Value of node key, without perf events
+    std::optional<thrift::AdjacencyDatabase> nodeAdjDb;
+    // Value of per adjacency keys
+    std::map<AdjacencyKey, thrift::Adjacency> adjacencies;
+  };
+  std::unordered_map<std::string /* area */, AdvertisedAdjacencyDb>
+      advertisedAdjDbs_;
+
+  // Flap dampening state of adjacencies. Entry is created on first adjacency
+  // down event and is removed once its flap history is forgotten.
+  std::unordered_map<AdjacencyKey, FlapDampener> adjDampeners_;
+
   // Previously announced KvStore peers
   std::unordered_map<
       std::string /* area */,
@@ -406,6 +467,13 @@ class LinkMonitor final : public OpenrEventBase {
   // Timer for processing interfaces which are in backoff states
   std::unique_ptr<folly::AsyncTimeout> advertiseIfaceAddrTimer_;
 
+  // Timer to re-advertise adjacencies once their dampening suppression ends
+  std::unique_ptr<folly::AsyncTimeout> adjDampeningTimer_;
+
+  // Timer to apply RTT metric updates deferred by smoothing hold time
+  std::unique_ptr<folly::AsyncTimeout> rttMetricHoldTimer_;
+  std::chrono::steady_clock::time_point rttMetricHoldDeadline_;
+
   // Exp backoff for resyncing InterfaceDb from netlink
   ExponentialBackoff<std::chrono::milliseconds> expBackoff_;
 
@@ -422,8 +490,15 @@ class LinkMonitor final : public OpenrEventBase {
   // initialization procedure.
   bool initialNeighborsReceived_{false};
 
-  // Stop signal for fiber to periodically dump interface info from platform
-  folly::fibers::Baton syncInterfaceStopSignal_;
+  // Signal for fiber to dump interface info from platform, posted on sync
+  // request and on stop
+  folly::fibers::Baton syncInterfaceSignal_;
+  std::atomic<bool> syncInterfaceStopped_{false};
+
+  // Number of interface syncs requested so far, and the number of requests
+  // fulfilled by last successful sync. Sync is pending if they differ.
+  uint64_t numSyncInterfaceRequested_{1}; // initial sync
+  uint64_t numSyncInterfaceDone_{0};
 }; // LinkMonitor
 
 } // namespace openr
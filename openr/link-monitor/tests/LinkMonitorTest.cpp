@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/Subprocess.h>
 #include <folly/init/Init.h>
 #include <folly/io/async/EventBase.h>
@@ -2363,6 +2364,135 @@ TEST_F(LinkMonitorTestFixture, GetAllLinks) {
       *link.networks.begin());
 }
 
+// Lost netlink events must trigger resync of interfaceDb from platform
+TEST_F(LinkMonitorTestFixture, ResyncOnEventsDropped) {
+  const std::string linkX = kTestVethNamePrefix + "X";
+
+  EXPECT_EQ(
+      0,
+      nlSock
+          ->addLink(fbnl::utils::createLink(
+              kTestVethIfIndex[0], linkX, false /* is up */))
+          .get());
+  recvAndReplyIfUpdate();
+  EXPECT_NO_THROW({
+    auto res = collateIfUpdates(sparkIfDb);
+    EXPECT_EQ(0, res.at(linkX).isUpCount);
+    EXPECT_EQ(1, res.at(linkX).isDownCount);
+  });
+
+  // Link goes UP while events are lost
+  nlSock->setEventsDropped(true);
+  EXPECT_EQ(
+      0,
+      nlSock
+          ->addLink(fbnl::utils::createLink(
+              kTestVethIfIndex[0], linkX, true /* is up */))
+          .get());
+  nlSock->setEventsDropped(false);
+
+  // Resync reports link as UP
+  recvAndReplyIfUpdate();
+  EXPECT_NO_THROW({
+    auto res = collateIfUpdates(sparkIfDb);
+    EXPECT_EQ(1, res.at(linkX).isUpCount);
+    EXPECT_EQ(0, res.at(linkX).isDownCount);
+  });
+
+  auto counters = facebook::fb303::fbData->getCounters();
+  EXPECT_LE(1, counters.at("link_monitor.sync_interface.requested.sum"));
+}
+
+class PerAdjacencyKeysTestFixture : public LinkMonitorTestFixture {
+ public:
+  thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = LinkMonitorTestFixture::createConfig();
+
+    // override LM config
+    tConfig.link_monitor_config_ref()->enable_per_adjacency_keys_ref() = true;
+
+    return tConfig;
+  }
+
+  // wait until adjacency database of key in KvStore matches predicate
+  thrift::AdjacencyDatabase
+  waitForAdjDb(
+      std::string const& key,
+      std::function<bool(thrift::AdjacencyDatabase const&)> predicate) {
+    while (true) {
+      auto value = kvStoreWrapper->getKey(kTestingAreaName, key);
+      if (value.has_value() and value->value_ref().has_value()) {
+        auto adjDb = readThriftObjStr<thrift::AdjacencyDatabase>(
+            value->value_ref().value(), serializer);
+        if (predicate(adjDb)) {
+          return adjDb;
+        }
+      }
+      /* sleep override */
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+};
+
+// Adjacency change must only update its own key
+TEST_F(PerAdjacencyKeysTestFixture, AdvertiseSingleAdjacency) {
+  const std::string nodeKey = "adj:node-1";
+  const auto adjKey = getAdjacencyKey("node-1", "node-2", if_2_1);
+  const int linkMetric = 123;
+
+  nlEventsInjector->sendLinkEvent(if_2_1, 100, true);
+  recvAndReplyIfUpdate();
+
+  // neighbor up and kvstore peer initial sync
+  {
+    auto neighborEvent = NeighborEvent(NeighborEventType::NEIGHBOR_UP, nb2);
+    neighborUpdatesQueue.push(NeighborEvents({std::move(neighborEvent)}));
+    auto peerEvent = peerUpdatesQueue.getReader().get();
+    ASSERT_TRUE(peerEvent.hasValue());
+    kvStoreEventsQueue.push(
+        KvStoreSyncEvent(*nb2.nodeName_ref(), kTestingAreaName));
+  }
+
+  // adjacency is advertised with its own key
+  auto adjDb = waitForAdjDb(adjKey, [](auto const& db) {
+    return db.get_adjacencies().size() == 1;
+  });
+  EXPECT_TRUE(*adjDb.perAdjacencyKeys_ref());
+  EXPECT_EQ("node-1", *adjDb.thisNodeName_ref());
+  EXPECT_EQ("node-2", *adjDb.adjacencies_ref()->at(0).otherNodeName_ref());
+  EXPECT_EQ(if_2_1, *adjDb.adjacencies_ref()->at(0).ifName_ref());
+
+  // node key carries node attributes only
+  auto nodeDb = waitForAdjDb(
+      nodeKey, [](auto const& db) { return *db.perAdjacencyKeys_ref(); });
+  EXPECT_TRUE(nodeDb.get_adjacencies().empty());
+  const auto nodeKeyVersion =
+      *kvStoreWrapper->getKey(kTestingAreaName, nodeKey)->version_ref();
+
+  // link metric change updates adjacency key only
+  linkMonitor->semifuture_setLinkMetric(if_2_1, linkMetric).get();
+  waitForAdjDb(adjKey, [&](auto const& db) {
+    return db.get_adjacencies().size() == 1 and
+        *db.adjacencies_ref()->at(0).metric_ref() == linkMetric;
+  });
+  EXPECT_EQ(
+      nodeKeyVersion,
+      *kvStoreWrapper->getKey(kTestingAreaName, nodeKey)->version_ref());
+
+  // node overload updates node key
+  linkMonitor->semifuture_setNodeOverload(true).get();
+  waitForAdjDb(nodeKey, [](auto const& db) { return *db.isOverloaded_ref(); });
+
+  // neighbor down withdraws adjacency key
+  {
+    auto neighborEvent = NeighborEvent(NeighborEventType::NEIGHBOR_DOWN, nb2);
+    neighborUpdatesQueue.push(NeighborEvents({std::move(neighborEvent)}));
+  }
+  waitForAdjDb(
+      adjKey, [](auto const& db) { return db.get_adjacencies().empty(); });
+}
+
 class InitializationTestFixture : public LinkMonitorTestFixture {
  public:
   thrift::OpenrConfig
@@ -5,7 +5,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <atomic>
+
 #include <fb303/ServiceData.h>
+#include <fmt/core.h>
 #include <folly/logging/xlog.h>
 
 #include <openr/nl/NetlinkProtocolSocket.h>
@@ -15,14 +18,25 @@ namespace fb303 = facebook::fb303;
 
 namespace openr::fbnl {
 
+namespace {
+
+// Index of the next created socket, to distinguish counters of sockets
+std::atomic<size_t> nextSocketIndex{0};
+
+} // namespace
+
 NetlinkProtocolSocket::NetlinkProtocolSocket(
     folly::EventBase* evb,
     messaging::ReplicateQueue<NetlinkEvent>& netlinkEventsQ,
-    bool enableIPv6RouteReplaceSemantics)
+    bool enableIPv6RouteReplaceSemantics,
+    bool subscribeEvents)
     : EventHandler(evb),
       evb_(evb),
       netlinkEventsQueue_(netlinkEventsQ),
-      enableIPv6RouteReplaceSemantics_(enableIPv6RouteReplaceSemantics) {
+      enableIPv6RouteReplaceSemantics_(enableIPv6RouteReplaceSemantics),
+      subscribeEvents_(subscribeEvents),
+      ackLatencyCounterKey_(fmt::format(
+          "netlink.requests.latency_us.{}", nextSocketIndex.fetch_add(1))) {
   // We expect ctrl-evb not be running. Attaching and scheduling
   // of timers is not thread safe.
   CHECK_NOTNULL(evb_);
@@ -53,6 +67,9 @@ NetlinkProtocolSocket::NetlinkProtocolSocket(
     close(nlSock_);
     init();
 
+    // Events sent by kernel while socket got re-created are lost
+    publishEventsDropped();
+
     // Resume sending netlink messages if any queued
     sendNetlinkMessage();
   });
@@ -127,10 +144,12 @@ NetlinkProtocolSocket::init() {
   saddr.nl_pid = 0; // We let kernel assign the port-ID
   /* We can subscribe to different Netlink mutlicast groups for specific types
    * of events: link, IPv4/IPv6 address and neighbor. */
-  saddr.nl_groups = RTMGRP_LINK // listen for link events
-      | RTMGRP_IPV4_IFADDR // listen for IPv4 address events
-      | RTMGRP_IPV6_IFADDR // listen for IPv6 address events
-      | RTMGRP_NEIGH; // listen for Neighbor (ARP) events
+  if (subscribeEvents_) {
+    saddr.nl_groups = RTMGRP_LINK // listen for link events
+        | RTMGRP_IPV4_IFADDR // listen for IPv4 address events
+        | RTMGRP_IPV6_IFADDR // listen for IPv6 address events
+        | RTMGRP_NEIGH; // listen for Neighbor (ARP) events
+  }
 
   if (bind(nlSock_, (struct sockaddr*)&saddr, sizeof(saddr)) != 0) {
     XLOG(FATAL) << "Failed to bind netlink socket: " << folly::errnoStr(errno);
@@ -172,6 +191,11 @@ NetlinkProtocolSocket::processAck(uint32_t ack, int status) {
     XLOG(ERR) << "Netlink request error for seq=" << ack
               << ", retval=" << status;
     fbData->addStatValue("netlink.requests.error", 1, fb303::SUM);
+    fbData->addStatValue(
+        fmt::format("netlink.requests.error.{}", std::abs(status)),
+        1,
+        fb303::SUM);
+    ackLatency_.addError();
   } else {
     fbData->addStatValue("netlink.requests.success", 1, fb303::SUM);
   }
@@ -183,6 +207,10 @@ NetlinkProtocolSocket::processAck(uint32_t ack, int status) {
         std::chrono::steady_clock::now() - it->second->getCreateTs());
     fbData->addStatValue(
         "netlink.requests.latency_ms", requestLatency.count(), fb303::AVG);
+    ackLatency_.addValue(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - it->second->getCreateTs())
+            .count());
 
     // Set return status on promise
     it->second->setReturnStatus(status);
@@ -192,9 +220,11 @@ NetlinkProtocolSocket::processAck(uint32_t ack, int status) {
     fbData->addStatValue("netlink.errors", 1, fb303::SUM);
   }
 
-  // Cancel timer if there are no more expected responses
+  // Cancel timer if there are no more expected responses. Also export latency
+  // percentiles once per batch of acknowledged requests.
   if (nlSeqNumMap_.empty()) {
     nlMessageTimer_->cancelTimeout();
+    ackLatency_.exportCounters(ackLatencyCounterKey_);
   } else {
     // Extend timer and wait for next ack
     nlMessageTimer_->scheduleTimeout(kNlRequestAckTimeout);
@@ -443,6 +473,13 @@ NetlinkProtocolSocket::recvNetlinkMessage() {
     if (errno == EINTR || errno == EAGAIN) {
       return;
     }
+    if (errno == ENOBUFS) {
+      // Kernel couldn't deliver notifications as receive buffer overflowed
+      XLOG(WARNING) << "Netlink socket receive buffer overflowed. "
+                    << "Notifications are lost.";
+      publishEventsDropped();
+      return;
+    }
     XLOG(ERR) << "Error in netlink socket receive: " << bytesRead
               << " err: " << folly::errnoStr(std::abs(errno));
     fbData->addStatValue("netlink.errors", 1, fb303::SUM);
@@ -453,6 +490,15 @@ NetlinkProtocolSocket::recvNetlinkMessage() {
   processMessage(recvMsg, static_cast<uint32_t>(bytesRead));
 }
 
+void
+NetlinkProtocolSocket::publishEventsDropped() {
+  if (not subscribeEvents_) {
+    return;
+  }
+  fbData->addStatValue("netlink.notifications.dropped", 1, fb303::SUM);
+  netlinkEventsQueue_.push(EventsDropped{++numEventsDropped_});
+}
+
 folly::SemiFuture<folly::Unit>
 NetlinkProtocolSocket::collectReturnStatus(
     std::vector<folly::SemiFuture<int>>&& futures,
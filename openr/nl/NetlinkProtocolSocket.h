@@ -14,6 +14,7 @@
 #include <folly/io/async/EventHandler.h>
 #include <folly/io/async/NotificationQueue.h>
 
+#include <openr/common/LatencyHistogram.h>
 #include <openr/messaging/ReplicateQueue.h>
 #include <openr/nl/NetlinkAddrMessage.h>
 #include <openr/nl/NetlinkLinkMessage.h>
@@ -25,9 +26,22 @@
 
 namespace openr::fbnl {
 
-// Netlink event as union of LINK/ADDR/NEIGH/RULE event
-using NetlinkEvent =
-    std::variant<fbnl::Link, fbnl::IfAddress, fbnl::Neighbor, fbnl::Rule>;
+// Published when LINK/ADDR/NEIGH/RULE notifications may have been lost, e.g.
+// kernel failed to deliver them due to socket receive buffer overflow
+// (ENOBUFS) or socket got re-created. State built from events must be re-synced
+// with a full dump.
+struct EventsDropped {
+  // Number of times events got dropped on the socket, including this one
+  uint64_t count{0};
+};
+
+// Netlink event as union of LINK/ADDR/NEIGH/RULE event, and drop notification
+using NetlinkEvent = std::variant<
+    fbnl::Link,
+    fbnl::IfAddress,
+    fbnl::Neighbor,
+    fbnl::Rule,
+    fbnl::EventsDropped>;
 
 // Receive socket buffer for netlink socket
 constexpr uint32_t kNetlinkSockRecvBuf{1 * 1024 * 1024};
@@ -89,6 +103,13 @@ constexpr std::chrono::milliseconds kNlRequestAckTimeout{1000};
  *   netlink.requests.success : Request that completed successfully
  *   netlink.requests.error : Request with non zero return code
  *   netlink.requests.latency_ms : Average latency of netlink request
+ *   netlink.requests.latency_us.<socket>.{p50,p99,p999,max} : Percentiles of
+ *     ACK latency over recent requests of the socket. `<socket>` is index of
+ *     the socket in order of creation within the process. Exported whenever
+ *     all in-flight requests of the socket are acknowledged
+ *   netlink.requests.latency_us.<socket>.errors : Requests with non zero
+ *     return code
+ *   netlink.requests.error.<errno> : Request errors broken down by errno
  *   netlink.bytes.rx : Bytes received over netlink socket
  *   netlink.bytes.tx : Bytes sent over netlink socket
  *   netlink.notifications.link : Received link notifications
@@ -98,10 +119,16 @@ constexpr std::chrono::milliseconds kNlRequestAckTimeout{1000};
  */
 class NetlinkProtocolSocket : public folly::EventHandler {
  public:
+  /**
+   * `subscribeEvents` controls membership of LINK/ADDR/NEIGH multicast groups.
+   * It can be disabled for sockets which are only used for programming routes,
+   * in which case no events are published to `netlinkEventsQ`.
+   */
   explicit NetlinkProtocolSocket(
       folly::EventBase* evb,
       messaging::ReplicateQueue<NetlinkEvent>& netlinkEventsQ,
-      bool enableIPv6RouteReplaceSemantics = false);
+      bool enableIPv6RouteReplaceSemantics = false,
+      bool subscribeEvents = true);
 
   virtual ~NetlinkProtocolSocket();
 
@@ -260,6 +287,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   void processMessage(
       const std::array<char, kMaxNlPayloadSize>& rxMsg, uint32_t bytesRead);
 
+  // Notify subscribers that events may have been lost
+  void publishEventsDropped();
+
   // Process ack message. Set return status on pending requests in nlSeqNumMap_
   // Resume sending messages from queue_ if any pending
   void processAck(uint32_t ack, int status);
@@ -282,6 +312,12 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Use new IPv6 route replace semantics. See documentation for addRoute(...)
   const bool enableIPv6RouteReplaceSemantics_{false};
 
+  // Subscribe to LINK/ADDR/NEIGH multicast groups on socket initialization
+  const bool subscribeEvents_{true};
+
+  // Number of times events got dropped on the socket
+  uint64_t numEventsDropped_{0};
+
   // Netlink socket fd. Created when class is constructed. Re-created on timeout
   // when no response is received for any of our pending requests.
   int nlSock_{-1};
@@ -321,6 +357,13 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   std::unordered_map<uint32_t, std::shared_ptr<NetlinkMessageBase>>
       nlSeqNumMap_;
 
+  // Distribution of request ACK latency (in microseconds) and errors
+  LatencyHistogram ackLatency_;
+
+  // Counter key of `ackLatency_`. Sockets of a pool are served by different
+  // threads, hence every socket exports its own histogram under unique key.
+  const std::string ackLatencyCounterKey_;
+
   // Timer to help keep track of timeout of messages sent to kernel. It also
   // ensures the aliveness of the netlink socket-fd. Timer is
   // - Started when a new message is sent
@@ -19,6 +19,10 @@
 
 DEFINE_int32(
     fib_thrift_port, 60100, "Thrift server port for the NetlinkFibHandler");
+DEFINE_int32(
+    num_route_sockets,
+    1,
+    "Number of netlink sockets (and threads) used for programming routes");
 
 using openr::NetlinkFibHandler;
 
@@ -48,8 +52,30 @@ main(int argc, char** argv) {
   }));
   nlEvb->waitUntilRunning();
 
+  // Additional sockets for route programming. Each runs in its own thread
+  std::vector<std::unique_ptr<folly::EventBase>> nlRouteEvbs;
+  std::vector<std::unique_ptr<openr::fbnl::NetlinkProtocolSocket>> nlRouteSocks;
+  std::vector<openr::fbnl::NetlinkProtocolSocket*> routeSocks;
+  for (int32_t i = 1; i < FLAGS_num_route_sockets; ++i) {
+    auto evb = std::make_unique<folly::EventBase>();
+    auto sock = std::make_unique<openr::fbnl::NetlinkProtocolSocket>(
+        evb.get(),
+        netlinkEventsQueue,
+        false /* enableIPv6RouteReplaceSemantics */,
+        false /* subscribeEvents */);
+    allThreads.emplace_back(std::thread([evb = evb.get()]() {
+      folly::setThreadName("NetlinkRouteEvl");
+      evb->loopForever();
+    }));
+    evb->waitUntilRunning();
+    routeSocks.emplace_back(sock.get());
+    nlRouteSocks.emplace_back(std::move(sock));
+    nlRouteEvbs.emplace_back(std::move(evb));
+  }
+
   apache::thrift::ThriftServer linuxFibAgentServer;
-  auto fibHandler = std::make_shared<NetlinkFibHandler>(nlSock.get());
+  auto fibHandler =
+      std::make_shared<NetlinkFibHandler>(nlSock.get(), routeSocks);
 
   // start FibService thread
   auto fibThriftThread = std::thread([fibHandler, &linuxFibAgentServer]() {
@@ -75,6 +101,9 @@ main(int argc, char** argv) {
 
   // Stop eventbase
   nlEvb->terminateLoopSoon();
+  for (auto& evb : nlRouteEvbs) {
+    evb->terminateLoopSoon();
+  }
 
   // Stop thrift server
   linuxFibAgentServer.stop();
@@ -85,6 +114,8 @@ main(int argc, char** argv) {
   }
 
   fibHandler.reset();
+  nlRouteSocks.clear();
+  nlRouteEvbs.clear();
   nlSock.reset();
   nlEvb.reset();
 
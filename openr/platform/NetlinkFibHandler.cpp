@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/Format.h>
 #include <folly/gen/Base.h>
 #include <folly/logging/xlog.h>
@@ -14,6 +15,8 @@
 #include <openr/if/gen-cpp2/Platform_constants.h>
 #include <openr/platform/NetlinkFibHandler.h>
 
+namespace fb303 = facebook::fb303;
+
 namespace openr {
 
 namespace {
@@ -33,15 +36,111 @@ createSemiFutureWithClientIdError() {
   return std::move(sf);
 }
 
+/**
+ * Canonical comparison of a desired nexthop against the one dumped from the
+ * kernel. Kernel always reports the outgoing interface, while the desired
+ * nexthop may leave it unspecified. Weight 0 and 1 are equivalent.
+ */
+bool
+isSameNextHop(const fbnl::NextHop& desired, const fbnl::NextHop& existing) {
+  if (desired.getIfIndex().has_value() and
+      desired.getIfIndex() != existing.getIfIndex()) {
+    return false;
+  }
+  return desired.getGateway() == existing.getGateway() and
+      std::max(desired.getWeight(), uint8_t(1)) ==
+      std::max(existing.getWeight(), uint8_t(1)) and
+      desired.getLabelAction() == existing.getLabelAction() and
+      desired.getSwapLabel() == existing.getSwapLabel() and
+      desired.getPushLabels() == existing.getPushLabels();
+}
+
+/**
+ * Canonical comparison of a desired route against the one dumped from the
+ * kernel. Only attributes which Open/R programs are compared. Attributes
+ * filled in by kernel (e.g. flags, scope) are ignored.
+ */
+bool
+isSameRoute(const fbnl::Route& desired, const fbnl::Route& existing) {
+  if (desired.getType() != existing.getType() or
+      desired.getPriority() != existing.getPriority() or
+      desired.getNextHops().size() != existing.getNextHops().size()) {
+    return false;
+  }
+
+  // Fast path: every nexthop has exact match in the existing set
+  const auto& existingNextHops = existing.getNextHops();
+  if (std::all_of(
+          desired.getNextHops().begin(),
+          desired.getNextHops().end(),
+          [&existingNextHops](const fbnl::NextHop& nh) {
+            return existingNextHops.count(nh) > 0;
+          })) {
+    return true;
+  }
+
+  // Slow path: pair every desired nexthop with a distinct existing nexthop
+  std::vector<const fbnl::NextHop*> unmatched;
+  unmatched.reserve(existingNextHops.size());
+  for (const auto& nh : existingNextHops) {
+    unmatched.emplace_back(&nh);
+  }
+  for (const auto& nh : desired.getNextHops()) {
+    auto it = std::find_if(
+        unmatched.begin(), unmatched.end(), [&nh](const fbnl::NextHop* other) {
+          return isSameNextHop(nh, *other);
+        });
+    if (it == unmatched.end()) {
+      return false;
+    }
+    unmatched.erase(it);
+  }
+  return true;
+}
+
+/**
+ * Report the outcome of a sync operation via fb303 counters
+ */
+void
+logSyncStats(
+    const std::string& prefix,
+    size_t numAdded,
+    size_t numUpdated,
+    size_t numDeleted,
+    size_t numSkipped) {
+  fb303::fbData->addStatValue(prefix + ".routes_added", numAdded, fb303::SUM);
+  fb303::fbData->addStatValue(
+      prefix + ".routes_updated", numUpdated, fb303::SUM);
+  fb303::fbData->addStatValue(
+      prefix + ".routes_deleted", numDeleted, fb303::SUM);
+  fb303::fbData->addStatValue(
+      prefix + ".routes_skipped", numSkipped, fb303::SUM);
+  XLOG(INFO) << "[" << prefix << "] Added " << numAdded << ", updated "
+             << numUpdated << ", deleted " << numDeleted << ", skipped "
+             << numSkipped << " routes";
+}
+
 } // namespace
 
 NetlinkFibHandler::NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock)
+    : NetlinkFibHandler(nlSock, {}) {}
+
+NetlinkFibHandler::NetlinkFibHandler(
+    fbnl::NetlinkProtocolSocket* nlSock,
+    const std::vector<fbnl::NetlinkProtocolSocket*>& routeSocks)
     : facebook::fb303::BaseService("openr"),
       nlSock_(nlSock),
       startTime_(std::chrono::duration_cast<std::chrono::seconds>(
                      std::chrono::system_clock::now().time_since_epoch())
                      .count()) {
   CHECK_NOTNULL(nlSock);
+  routeSocks_.emplace_back(nlSock);
+  for (auto routeSock : routeSocks) {
+    CHECK_NOTNULL(routeSock);
+    routeSocks_.emplace_back(routeSock);
+  }
+  XLOG(INFO) << "Programming routes with " << routeSocks_.size()
+             << " netlink socket(s)";
 }
 
 NetlinkFibHandler::~NetlinkFibHandler() {}
@@ -109,7 +208,9 @@ NetlinkFibHandler::semifuture_addUnicastRoutes(
   // Add routes and return a collected semifuture
   std::vector<folly::SemiFuture<int>> result;
   for (auto& route : *routes) {
-    result.emplace_back(nlSock_->addRoute(buildRoute(route, protocol.value())));
+    auto nlRoute = buildRoute(route, protocol.value());
+    auto nlSock = getRouteSocket(nlRoute.getDestination());
+    result.emplace_back(nlSock->addRoute(nlRoute));
   }
   return fbnl::NetlinkProtocolSocket::collectReturnStatus(
       std::move(result), {EEXIST});
@@ -132,7 +233,8 @@ NetlinkFibHandler::semifuture_deleteUnicastRoutes(
     fbnl::RouteBuilder rtBuilder;
     rtBuilder.setDestination(toIPNetwork(prefix));
     rtBuilder.setProtocolId(protocol.value());
-    result.emplace_back(nlSock_->deleteRoute(rtBuilder.build()));
+    auto nlSock = getRouteSocket(rtBuilder.getDestination());
+    result.emplace_back(nlSock->deleteRoute(rtBuilder.build()));
   }
   return fbnl::NetlinkProtocolSocket::collectReturnStatus(
       std::move(result), {ESRCH});
@@ -152,8 +254,9 @@ NetlinkFibHandler::semifuture_addMplsRoutes(
   // Add routes and return a collected semifuture
   std::vector<folly::SemiFuture<int>> result;
   for (auto& route : *routes) {
+    auto nlSock = getRouteSocket(static_cast<uint32_t>(*route.topLabel_ref()));
     result.emplace_back(
-        nlSock_->addRoute(buildMplsRoute(route, protocol.value())));
+        nlSock->addRoute(buildMplsRoute(route, protocol.value())));
   }
   return fbnl::NetlinkProtocolSocket::collectReturnStatus(
       std::move(result), {EEXIST});
@@ -176,7 +279,8 @@ NetlinkFibHandler::semifuture_deleteMplsRoutes(
     fbnl::RouteBuilder rtBuilder;
     rtBuilder.setMplsLabel(topLabel);
     rtBuilder.setProtocolId(protocol.value());
-    result.emplace_back(nlSock_->deleteRoute(rtBuilder.build()));
+    auto nlSock = getRouteSocket(static_cast<uint32_t>(topLabel));
+    result.emplace_back(nlSock->deleteRoute(rtBuilder.build()));
   }
   return fbnl::NetlinkProtocolSocket::collectReturnStatus(
       std::move(result), {ESRCH});
@@ -224,39 +328,48 @@ NetlinkFibHandler::semifuture_syncFib(
     }
   }
 
-  // Go over the new routes. Add or update
-  std::unordered_set<folly::CIDRNetwork> newPrefixes;
+  // Go over the new routes. Add or update only the ones that differ from
+  // kernel state. Matching entries are erased from `existingRoutes` so that
+  // whatever remains afterwards is stale.
+  size_t numAdded{0}, numUpdated{0}, numSkipped{0};
   for (auto& route : *unicastRoutes) {
     const auto network = toIPNetwork(*route.dest_ref());
-    newPrefixes.insert(network);
     auto nlRoute = buildRoute(route, protocol.value());
     auto it = existingRoutes.find(network);
-    if (it != existingRoutes.end() and it->second == nlRoute) {
-      // Existing route is same as the one we're trying to add. SKIP
-      continue;
-    }
     if (it != existingRoutes.end()) {
-      XLOG(INFO) << "Updating unicast-route "
-                 << "\n[OLD] " << it->second.str() << "\n[NEW] "
-                 << nlRoute.str();
+      const bool isSame = isSameRoute(nlRoute, it->second);
+      if (not isSame) {
+        XLOG(INFO) << "Updating unicast-route "
+                   << "\n[OLD] " << it->second.str() << "\n[NEW] "
+                   << nlRoute.str();
+      }
+      existingRoutes.erase(it);
+      if (isSame) {
+        // Existing route is same as the one we're trying to add. SKIP
+        ++numSkipped;
+        continue;
+      }
+      ++numUpdated;
     } else {
       XLOG(INFO) << "Adding unicast-route \n[NEW]" << nlRoute.str();
+      ++numAdded;
     }
     // Add new route or replace existing one
-    result.emplace_back(nlSock_->addRoute(nlRoute));
+    result.emplace_back(getRouteSocket(network)->addRoute(nlRoute));
   }
 
-  // Go over the old routes to remove stale ones
+  // Remaining old routes are stale. Remove them
   for (auto& [prefix, nlRoute] : existingRoutes) {
-    if (newPrefixes.count(prefix)) {
-      // not a stale route
-      continue;
-    }
-    // Delete stale route
     XLOG(INFO) << "Deleting unicast-route "
                << folly::IPAddress::networkToString(prefix);
-    result.emplace_back(nlSock_->deleteRoute(nlRoute));
+    result.emplace_back(getRouteSocket(prefix)->deleteRoute(nlRoute));
   }
+  logSyncStats(
+      "fibhandler.sync_fib",
+      numAdded,
+      numUpdated,
+      existingRoutes.size(),
+      numSkipped);
 
   // Return collected result
   // NOTE: We're ignoring EEXIST error code. ESRCH error code must not be
@@ -292,38 +405,49 @@ NetlinkFibHandler::semifuture_syncMplsFib(
     existingRoutes.emplace(topLabel, std::move(route));
   }
 
-  // Go over the new routes. Add or update
-  std::unordered_set<uint32_t> newLabels;
+  // Go over the new routes. Add or update only the ones that differ from
+  // kernel state. Matching entries are erased from `existingRoutes` so that
+  // whatever remains afterwards is stale.
+  size_t numAdded{0}, numUpdated{0}, numSkipped{0};
   for (auto& route : *mplsRoutes) {
     const auto label = *route.topLabel_ref();
-    newLabels.insert(label);
     auto nlRoute = buildMplsRoute(route, protocol.value());
     auto it = existingRoutes.find(label);
-    if (it != existingRoutes.end() and it->second == nlRoute) {
-      // Existing route is same as the one we're trying to add. SKIP
-      continue;
-    }
     if (it != existingRoutes.end()) {
-      XLOG(INFO) << "Updating mpls-route "
-                 << "\n[OLD] " << it->second.str() << "\n[NEW] "
-                 << nlRoute.str();
+      const bool isSame = isSameRoute(nlRoute, it->second);
+      if (not isSame) {
+        XLOG(INFO) << "Updating mpls-route "
+                   << "\n[OLD] " << it->second.str() << "\n[NEW] "
+                   << nlRoute.str();
+      }
+      existingRoutes.erase(it);
+      if (isSame) {
+        // Existing route is same as the one we're trying to add. SKIP
+        ++numSkipped;
+        continue;
+      }
+      ++numUpdated;
     } else {
       XLOG(INFO) << "Adding mpls-route \n[NEW]" << nlRoute.str();
+      ++numAdded;
     }
     // Add new route or replace existing one
-    result.emplace_back(nlSock_->addRoute(nlRoute));
+    result.emplace_back(
+        getRouteSocket(static_cast<uint32_t>(label))->addRoute(nlRoute));
   }
 
-  // Go over the old routes to remove stale ones
+  // Remaining old routes are stale. Remove them
   for (auto& [topLabel, nlRoute] : existingRoutes) {
-    if (newLabels.count(topLabel)) {
-      // not a stale route
-      continue;
-    }
-    // Delete stale route
     XLOG(INFO) << "Deleting mpls-route " << *nlRoute.getMplsLabel();
-    result.emplace_back(nlSock_->deleteRoute(nlRoute));
+    result.emplace_back(
+        getRouteSocket(static_cast<uint32_t>(topLabel))->deleteRoute(nlRoute));
   }
+  logSyncStats(
+      "fibhandler.sync_mpls_fib",
+      numAdded,
+      numUpdated,
+      existingRoutes.size(),
+      numSkipped);
 
   // Return collected result
   return fbnl::NetlinkProtocolSocket::collectReturnStatus(
@@ -547,6 +671,20 @@ NetlinkFibHandler::buildMplsRoute(
   return rtBuilder.setValid(true).build();
 }
 
+fbnl::NetlinkProtocolSocket*
+NetlinkFibHandler::getRouteSocket(const folly::CIDRNetwork& prefix) {
+  if (routeSocks_.size() == 1) {
+    return nlSock_;
+  }
+  return routeSocks_.at(
+      std::hash<folly::CIDRNetwork>()(prefix) % routeSocks_.size());
+}
+
+fbnl::NetlinkProtocolSocket*
+NetlinkFibHandler::getRouteSocket(uint32_t topLabel) {
+  return routeSocks_.at(topLabel % routeSocks_.size());
+}
+
 std::optional<int>
 NetlinkFibHandler::getIfIndex(const std::string& ifName) {
   // Lambda function to lookup ifName in cache
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <fb303/BaseService.h>
+#include <fb303/ServiceData.h>
 #include <folly/Expected.h>
 #include <folly/futures/Future.h>
 #include <folly/io/async/AsyncSocket.h>
@@ -27,16 +28,35 @@ namespace openr {
  * - Translates netlink representation of routes to thrift for get* queries
  * - All APIs exposed are asynchronous. Sync API retries the existing routing
  *   state in synchronous way and program changes asynchrnously.
+ * - Sync APIs diff the desired routes against kernel state and only issue
+ *   add/replace/delete for routes that differ. Unchanged routes are skipped.
+ * - Route add/delete requests can optionally be sharded across a pool of
+ *   netlink sockets, each with its own event base, to parallelize programming.
+ *   Sharding is based on prefix (or top-label) hash, hence all requests for a
+ *   given prefix go through the same socket and preserve their order.
  */
 class NetlinkFibHandler : public thrift::FibServiceSvIf,
                           public facebook::fb303::BaseService {
  public:
   explicit NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock);
+
+  /**
+   * `nlSock` is used for querying links and routes from kernel. Route
+   * programming is sharded across `nlSock` and `routeSocks`.
+   */
+  NetlinkFibHandler(
+      fbnl::NetlinkProtocolSocket* nlSock,
+      const std::vector<fbnl::NetlinkProtocolSocket*>& routeSocks);
   ~NetlinkFibHandler() override;
 
+  /**
+   * Export fb303 counters of this process. Among others, these include
+   * - fibhandler.sync_fib.routes_{added,updated,deleted,skipped}
+   * - fibhandler.sync_mpls_fib.routes_{added,updated,deleted,skipped}
+   */
   void
-  getCounters(std::map<std::string, int64_t>& /* counters */) override {
-    // No counters. Return empty
+  getCounters(std::map<std::string, int64_t>& counters) override {
+    facebook::fb303::fbData->getCounters(counters);
   }
 
   folly::SemiFuture<folly::Unit> semifuture_addUnicastRoute(
@@ -164,9 +184,19 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf,
    */
   std::optional<int> getLoopbackIfIndex();
 
+  /**
+   * Get the socket to be used for programming route of given prefix or
+   * top-label. Same key always maps to the same socket.
+   */
+  fbnl::NetlinkProtocolSocket* getRouteSocket(const folly::CIDRNetwork& prefix);
+  fbnl::NetlinkProtocolSocket* getRouteSocket(uint32_t topLabel);
+
   // Used to interact with Linux kernel routing table
   fbnl::NetlinkProtocolSocket* nlSock_{nullptr};
 
+  // Pool of sockets for programming routes. First one is always `nlSock_`
+  std::vector<fbnl::NetlinkProtocolSocket*> routeSocks_;
+
  private:
   /**
    * Disable copy & assignment operators
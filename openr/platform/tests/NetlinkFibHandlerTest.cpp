@@ -10,6 +10,7 @@
 #include <chrono>
 #include <stdexcept>
 
+#include <fb303/ServiceData.h>
 #include <folly/Format.h>
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
@@ -28,6 +29,8 @@
 
 using namespace openr;
 
+namespace fb303 = facebook::fb303;
+
 namespace {
 
 std::string_view kPrefixV4 = "192.168.{}.{}/32";
@@ -224,6 +227,74 @@ TEST(NetlinkFibHandler, getRoutesWithInvalidClient) {
       fbnl::NlException);
 }
 
+//
+// Route programming sharded across multiple netlink sockets. Verify that
+// every route is programmed exactly once and that delete of route lands on
+// the socket where it was added.
+//
+TEST(NetlinkFibHandler, RouteSocketSharding) {
+  const int16_t kClientId = 786;
+  const uint8_t kProtocol = 99;
+  folly::EventBase evb;
+  fbnl::MockNetlinkProtocolSocket nlSock(&evb);
+  fbnl::MockNetlinkProtocolSocket routeSock1(&evb);
+  fbnl::MockNetlinkProtocolSocket routeSock2(&evb);
+  const std::vector<fbnl::MockNetlinkProtocolSocket*> allSocks{
+      &nlSock, &routeSock1, &routeSock2};
+  for (size_t i = 0; i < kInterfaces.size(); ++i) {
+    ASSERT_EQ(
+        0,
+        nlSock.addLink(fbnl::utils::createLink(i + 1, kInterfaces.at(i)))
+            .get());
+  }
+  NetlinkFibHandler handler(&nlSock, {&routeSock1, &routeSock2});
+
+  auto numRoutes = [&](fbnl::MockNetlinkProtocolSocket* sock) {
+    return sock->getIPv6Routes(kProtocol).get().value().size() +
+        sock->getMplsRoutes(kProtocol).get().value().size();
+  };
+
+  // Add routes and verify that they're distributed across all sockets
+  auto rts = createUnicastRoutes(100, false /* isV4 */);
+  handler
+      .semifuture_addUnicastRoutes(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  auto mplsRts = createMplsRoutes(
+      100, false, createMplsAction(thrift::MplsActionCode::SWAP, 10));
+  handler
+      .semifuture_addMplsRoutes(
+          kClientId, std::make_unique<std::vector<thrift::MplsRoute>>(mplsRts))
+      .get();
+  size_t total{0};
+  for (auto sock : allSocks) {
+    EXPECT_LT(0, numRoutes(sock));
+    total += numRoutes(sock);
+  }
+  EXPECT_EQ(200, total);
+
+  // Delete all routes and verify that every socket is empty
+  std::vector<thrift::IpPrefix> prefixes;
+  for (auto const& rt : rts) {
+    prefixes.emplace_back(*rt.dest_ref());
+  }
+  handler
+      .semifuture_deleteUnicastRoutes(
+          kClientId, std::make_unique<std::vector<thrift::IpPrefix>>(prefixes))
+      .get();
+  std::vector<int32_t> labels;
+  for (auto const& rt : mplsRts) {
+    labels.emplace_back(*rt.topLabel_ref());
+  }
+  handler
+      .semifuture_deleteMplsRoutes(
+          kClientId, std::make_unique<std::vector<int32_t>>(labels))
+      .get();
+  for (auto sock : allSocks) {
+    EXPECT_EQ(0, numRoutes(sock));
+  }
+}
+
 //
 // Test correctness of route add, update, and remove
 //
@@ -413,6 +484,61 @@ TEST_P(FibHandlerFixture, UnicastSync) {
   EXPECT_EQ(rts, *routes);
 }
 
+//
+// Test that SyncFib only programs the difference against kernel state
+//
+// syncFib with [r1, r2, r3, r4] routes - ensure all gets added
+// syncFib with same routes again - ensure all are skipped
+// syncFib with [r1, r2', r3] - ensure one update, one delete and two skips
+//
+TEST_P(FibHandlerFixture, UnicastSyncDiff) {
+  const int16_t kClientId = 786;
+  const bool isV4 = GetParam();
+
+  auto getCounter = [](const std::string& name) -> int64_t {
+    auto counters = fb303::fbData->getCounters();
+    auto it = counters.find("fibhandler.sync_fib." + name + ".sum");
+    return it != counters.end() ? it->second : 0;
+  };
+
+  auto rts = createUnicastRoutes(4, isV4);
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  auto added = getCounter("routes_added");
+  auto updated = getCounter("routes_updated");
+  auto deleted = getCounter("routes_deleted");
+  auto skipped = getCounter("routes_skipped");
+
+  // Sync same routes again. Nothing must be programmed
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  EXPECT_EQ(added, getCounter("routes_added"));
+  EXPECT_EQ(updated, getCounter("routes_updated"));
+  EXPECT_EQ(deleted, getCounter("routes_deleted"));
+  EXPECT_EQ(skipped + 4, getCounter("routes_skipped"));
+
+  // Update one route and remove another one
+  rts.pop_back();
+  rts.at(1).nextHops_ref() = createNextHops(kInterfaces.size() + 1, isV4);
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  EXPECT_EQ(added, getCounter("routes_added"));
+  EXPECT_EQ(updated + 1, getCounter("routes_updated"));
+  EXPECT_EQ(deleted + 1, getCounter("routes_deleted"));
+  EXPECT_EQ(skipped + 6, getCounter("routes_skipped"));
+
+  auto routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  ASSERT_EQ(3, routes->size());
+  sortNextHops(*routes);
+  EXPECT_EQ(rts, *routes);
+}
+
 //
 // Test correctness of multiple client support. Incrementally add and remove
 // route for same prefix1 from client1 and client2. Verify that addition or
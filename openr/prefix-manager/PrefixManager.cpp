@@ -6,6 +6,7 @@
  */
 
 #include <fb303/ServiceData.h>
+#include <folly/Conv.h>
 #include <folly/IPAddress.h>
 #include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
@@ -49,6 +50,10 @@ PrefixManager::PrefixManager(
           config->getConfig().get_prefer_openr_originated_routes()) {
   CHECK(config);
 
+  if (auto buckets = config->getConfig().prefix_db_key_buckets_ref()) {
+    prefixDbKeyBuckets_ = *buckets;
+  }
+
   // Always add RIB type prefixes, since Fib routes updates are always expected
   // in OpenR initialization procedure.
   uninitializedPrefixTypes_.emplace(thrift::PrefixType::RIB);
@@ -201,6 +206,37 @@ PrefixManager::PrefixManager(
         syncPrefixesByTypeImpl(
             update.type, update.prefixes, dstAreas, update.policyName);
         break;
+      case PrefixEventType::STAGE_PREFIXES_BY_TYPE:
+        stagePrefixesByTypeImpl(
+            update.type,
+            std::move(update.prefixes),
+            dstAreas,
+            update.policyName);
+        break;
+      case PrefixEventType::COMMIT_PREFIXES_BY_TYPE: {
+        stagePrefixesByTypeImpl(
+            update.type,
+            std::move(update.prefixes),
+            dstAreas,
+            update.policyName);
+        const auto numPrefixes = commitPrefixesByTypeImpl(update.type);
+
+        if (uninitializedPrefixTypes_.erase(update.type)) {
+          // Received initial prefixes of certain type in OpenR initialization
+          // process.
+          XLOG(INFO) << fmt::format(
+              "[Initialization] Received {} prefixes of type {}.",
+              numPrefixes,
+              apache::thrift::util::enumNameSafe<thrift::PrefixType>(
+                  update.type));
+          sendStaticUnicastRoutes(update.type);
+          triggerInitialPrefixDbSync();
+        }
+        break;
+      }
+      case PrefixEventType::ABORT_STAGED_PREFIXES_BY_TYPE:
+        abortStagedPrefixesByTypeImpl(update.type);
+        break;
       default:
         XLOG(ERR) << "Unknown command received. "
                   << static_cast<int>(update.eventType);
@@ -284,6 +320,10 @@ PrefixManager::processPublication(thrift::Publication&& thriftPub) {
     try {
       const auto prefixDb = readThriftObjStr<thrift::PrefixDatabase>(
           *val.get_value(), serializer_);
+      if (PrefixKey::isPrefixBucketKey(keyStr)) {
+        processPrefixBucketPublication(area, keyStr, prefixDb);
+        continue;
+      }
       if (prefixDb.prefixEntries()->size() != 1) {
         LOG(WARNING) << "Skip processing unexpected number of prefix entries";
         continue;
@@ -295,6 +335,17 @@ PrefixManager::processPublication(thrift::Publication&& thriftPub) {
         auto const& thisNodeName = prefixDb.get_thisNodeName();
         auto const& network = toIPNetwork(tPrefixEntry.get_prefix());
 
+        // Prefixes are packed into bucket keys, hence per prefix key of self
+        // is stale, e.g. left by previous incarnation. Clear it.
+        if (prefixDbKeyBuckets_ and thisNodeName == nodeId_) {
+          XLOG(DBG1) << fmt::format(
+              "[Prefix Update]: Area: {}, stale {} updated inside KvStore",
+              area,
+              keyStr);
+          clearPrefixKey(area, keyStr, network);
+          continue;
+        }
+
         // Skip none-self advertised prefixes or already persisted keys.
         if (thisNodeName != nodeId_ or advertiseStatus_.count(network) > 0) {
           continue;
@@ -319,6 +370,39 @@ PrefixManager::processPublication(thrift::Publication&& thriftPub) {
   } // for
 }
 
+void
+PrefixManager::processPrefixBucketPublication(
+    const std::string& area,
+    const std::string& keyStr,
+    const thrift::PrefixDatabase& prefixDb) {
+  // Skip none-self advertised or already withdrawn buckets.
+  if (prefixDb.get_thisNodeName() != nodeId_ or prefixDb.get_deletePrefix()) {
+    return;
+  }
+
+  const auto bucket =
+      folly::tryTo<size_t>(keyStr.substr(keyStr.rfind(":#") + 2));
+  if (bucket.hasError()) {
+    XLOG(ERR) << "Skip processing invalid prefix bucket key " << keyStr;
+    return;
+  }
+
+  // Bucket unknown to this instance, e.g. advertised by previous incarnation
+  // or with different number of buckets, gets cleared in next sync.
+  if (prefixDbKeyBuckets_) {
+    const auto areaIt = prefixDbBuckets_.find(area);
+    if (areaIt != prefixDbBuckets_.end() and areaIt->second.count(*bucket)) {
+      return;
+    }
+  }
+  XLOG(DBG1) << fmt::format(
+      "[Prefix Update]: Area: {}, stale {} updated inside KvStore",
+      area,
+      keyStr);
+  dirtyPrefixDbBuckets_[area].emplace(*bucket);
+  syncKvStoreThrottled_->operator()();
+}
+
 PrefixManager::~PrefixManager() {
   // - If EventBase is stopped or it is within the evb thread, run immediately;
   // - Otherwise, will wait the EventBase to run;
@@ -380,6 +464,7 @@ PrefixManager::buildOriginatedPrefixes(
     }
 
     // ATTN: upon initialization, no supporting routes
+    originatedPrefixTrie_.insert(network, folly::unit);
     originatedPrefixDb_.emplace(
         network,
         OriginatedRoute(
@@ -532,15 +617,25 @@ PrefixManager::addKvStoreKeyHelper(const PrefixEntry& entry) {
       postPolicyTPrefixEntry = tPrefixEntry;
     }
 
-    const auto prefixKeyStr =
-        PrefixKey(nodeId_, entry.network, toArea).getPrefixKeyV2();
-    auto prefixDb = createPrefixDb(nodeId_, {*postPolicyTPrefixEntry}, toArea);
-    auto prefixDbStr = writeThriftObjStr(std::move(prefixDb), serializer_);
-
-    // advertise key to `KvStore`
-    auto persistPrefixKeyVal =
-        PersistKeyValueRequest(AreaId{toArea}, prefixKeyStr, prefixDbStr);
-    kvRequestQueue_.push(std::move(persistPrefixKeyVal));
+    if (prefixDbKeyBuckets_) {
+      // bucket key is written to `KvStore` in flushPrefixDbBuckets()
+      const auto bucket =
+          PrefixKey::getPrefixBucket(entry.network, *prefixDbKeyBuckets_);
+      prefixDbBuckets_[toArea][bucket].insert_or_assign(
+          entry.network, *postPolicyTPrefixEntry);
+      dirtyPrefixDbBuckets_[toArea].emplace(bucket);
+    } else {
+      const auto prefixKeyStr =
+          PrefixKey(nodeId_, entry.network, toArea).getPrefixKeyV2();
+      auto prefixDb =
+          createPrefixDb(nodeId_, {*postPolicyTPrefixEntry}, toArea);
+      auto prefixDbStr = writeThriftObjStr(std::move(prefixDb), serializer_);
+
+      // advertise key to `KvStore`
+      auto persistPrefixKeyVal =
+          PersistKeyValueRequest(AreaId{toArea}, prefixKeyStr, prefixDbStr);
+      kvRequestQueue_.push(std::move(persistPrefixKeyVal));
+    }
 
     fb303::fbData->addStatValue(
         "prefix_manager.route_advertisements", 1, fb303::SUM);
@@ -577,31 +672,99 @@ void
 PrefixManager::deleteKvStoreKeyHelper(
     const folly::CIDRNetwork& prefix,
     const std::unordered_set<std::string>& deletedArea) {
+  for (const auto& area : deletedArea) {
+    if (prefixDbKeyBuckets_) {
+      // bucket key is re-written or cleared in flushPrefixDbBuckets()
+      const auto bucket =
+          PrefixKey::getPrefixBucket(prefix, *prefixDbKeyBuckets_);
+      prefixDbBuckets_[area][bucket].erase(prefix);
+      dirtyPrefixDbBuckets_[area].emplace(bucket);
+
+      XLOG(DBG1) << "[Prefix Withdraw] "
+                 << "Area: " << area << ", "
+                 << folly::IPAddress::networkToString(prefix);
+      fb303::fbData->addStatValue(
+          "prefix_manager.route_withdraws", 1, fb303::SUM);
+      continue;
+    }
+
+    clearPrefixKey(
+        area, PrefixKey(nodeId_, prefix, area).getPrefixKeyV2(), prefix);
+    fb303::fbData->addStatValue(
+        "prefix_manager.route_withdraws", 1, fb303::SUM);
+  }
+}
+
+void
+PrefixManager::clearPrefixKey(
+    const std::string& area,
+    const std::string& prefixKeyStr,
+    const folly::CIDRNetwork& prefix) {
   // Prepare thrift::PrefixDatabase object for deletion
   thrift::PrefixDatabase deletedPrefixDb;
   deletedPrefixDb.thisNodeName_ref() = nodeId_;
   deletedPrefixDb.deletePrefix_ref() = true;
+  thrift::PrefixEntry entry;
+  entry.prefix_ref() = toIpPrefix(prefix);
+  deletedPrefixDb.prefixEntries_ref() = {entry};
+  deletedPrefixDb.area_ref() = area;
+
+  // Remove prefix from KvStore and flood deletion by setting deleted value.
+  auto unsetPrefixRequest = ClearKeyValueRequest(
+      AreaId{area},
+      prefixKeyStr,
+      writeThriftObjStr(std::move(deletedPrefixDb), serializer_),
+      true);
+  kvRequestQueue_.push(std::move(unsetPrefixRequest));
+
+  XLOG(DBG1) << "[Prefix Withdraw] "
+             << "Area: " << area << ", " << toString(*entry.prefix_ref());
+}
 
-  for (const auto& area : deletedArea) {
-    const auto prefixKeyStr = PrefixKey(nodeId_, prefix, area).getPrefixKeyV2();
-    thrift::PrefixEntry entry;
-    entry.prefix_ref() = toIpPrefix(prefix);
-    deletedPrefixDb.prefixEntries_ref() = {entry};
-    deletedPrefixDb.area_ref() = area;
-
-    // Remove prefix from KvStore and flood deletion by setting deleted value.
-    auto unsetPrefixRequest = ClearKeyValueRequest(
-        AreaId{area},
-        prefixKeyStr,
-        writeThriftObjStr(std::move(deletedPrefixDb), serializer_),
-        true);
-    kvRequestQueue_.push(std::move(unsetPrefixRequest));
-
-    XLOG(DBG1) << "[Prefix Withdraw] "
-               << "Area: " << area << ", " << toString(*entry.prefix_ref());
+void
+PrefixManager::flushPrefixDbBuckets() {
+  for (auto& [area, buckets] : dirtyPrefixDbBuckets_) {
+    auto& areaBuckets = prefixDbBuckets_[area];
+    for (const auto bucket : buckets) {
+      const auto bucketKeyStr = PrefixKey::getPrefixBucketKey(nodeId_, bucket);
+      auto bucketIt = areaBuckets.find(bucket);
+      if (bucketIt == areaBuckets.end() or bucketIt->second.empty()) {
+        // Remove emptied bucket from KvStore and flood deletion
+        thrift::PrefixDatabase deletedPrefixDb;
+        deletedPrefixDb.thisNodeName_ref() = nodeId_;
+        deletedPrefixDb.deletePrefix_ref() = true;
+        deletedPrefixDb.area_ref() = area;
+        kvRequestQueue_.push(ClearKeyValueRequest(
+            AreaId{area},
+            bucketKeyStr,
+            writeThriftObjStr(std::move(deletedPrefixDb), serializer_),
+            true));
+        if (bucketIt != areaBuckets.end()) {
+          areaBuckets.erase(bucketIt);
+        }
+        XLOG(DBG1) << "[Prefix Bucket Withdraw] "
+                   << "Area: " << area << ", Key: " << bucketKeyStr;
+        continue;
+      }
+
+      std::vector<thrift::PrefixEntry> entries;
+      entries.reserve(bucketIt->second.size());
+      for (const auto& [_, tPrefixEntry] : bucketIt->second) {
+        entries.emplace_back(tPrefixEntry);
+      }
+      auto prefixDb = createPrefixDb(nodeId_, entries, area);
+      kvRequestQueue_.push(PersistKeyValueRequest(
+          AreaId{area},
+          bucketKeyStr,
+          writeThriftObjStr(std::move(prefixDb), serializer_)));
+      XLOG(DBG1) << "[Prefix Bucket Advertisement] "
+                 << "Area: " << area << ", Key: " << bucketKeyStr << ", "
+                 << bucketIt->second.size() << " prefixes";
+    }
     fb303::fbData->addStatValue(
-        "prefix_manager.route_withdraws", 1, fb303::SUM);
+        "prefix_manager.prefix_bucket_updates", buckets.size(), fb303::SUM);
   }
+  dirtyPrefixDbBuckets_.clear();
 }
 
 void
@@ -676,29 +839,80 @@ getBestPrefixEntry(
 
 } // namespace
 
+void
+PrefixManager::updatePrefixLabelIndex(const folly::CIDRNetwork& prefix) {
+  // Remove stale references
+  auto it = prefixToLabels_.find(prefix);
+  if (it != prefixToLabels_.end()) {
+    for (const auto& label : it->second) {
+      auto labelIt = labelToPrefixes_.find(label);
+      if (labelIt != labelToPrefixes_.end()) {
+        labelIt->second.erase(prefix);
+        if (labelIt->second.empty()) {
+          labelToPrefixes_.erase(labelIt);
+        }
+      }
+    }
+    prefixToLabels_.erase(it);
+  }
+
+  // Readiness of both best and advertised entry depends on its label
+  std::vector<int32_t> labels;
+  auto prefixIt = prefixMap_.find(prefix);
+  if (prefixIt != prefixMap_.end()) {
+    const auto& [_, bestEntry] =
+        getBestPrefixEntry(prefixIt->second, preferOpenrOriginatedRoutes_);
+    if (auto labelRef = bestEntry.tPrefixEntry->prependLabel_ref()) {
+      labels.emplace_back(*labelRef);
+    }
+  }
+  auto advertisedIt = advertisedPrefixEntries_.find(prefix);
+  if (advertisedIt != advertisedPrefixEntries_.end()) {
+    if (auto labelRef = advertisedIt->second.tPrefixEntry->prependLabel_ref()) {
+      labels.emplace_back(*labelRef);
+    }
+  }
+  if (labels.empty()) {
+    return;
+  }
+  for (const auto& label : labels) {
+    labelToPrefixes_[label].emplace(prefix);
+  }
+  prefixToLabels_.emplace(prefix, std::move(labels));
+}
+
 void
 PrefixManager::syncKvStore() {
   XLOG(DBG1) << "[KvStore Sync] Syncing " << pendingUpdates_.size()
              << " pending updates.";
   DecisionRouteUpdate routeUpdatesForDecision;
   DecisionRouteUpdate routeUpdatesForBgp;
-  size_t receivedPrefixCnt = 0;
   size_t syncedPrefixCnt = 0;
-  size_t awaitingPrefixCnt = 0;
 
-  // Withdraw prefixes that no longer exist.
-  for (auto const& prefix : pendingUpdates_.getChangedPrefixes()) {
-    auto it = prefixMap_.find(prefix);
-    if (it == prefixMap_.end()) {
-      // Delete prefixes that do not exist in prefixMap_.
-      deletePrefixKeysInKvStore(prefix, routeUpdatesForDecision);
-      advertisedPrefixEntries_.erase(prefix);
-      ++syncedPrefixCnt;
+  // Only changed prefixes and prefixes referring to changed labels need to be
+  // revisited. Rest of prefixMap_ is in sync with KvStore already.
+  auto dirtyPrefixes = pendingUpdates_.getChangedPrefixes();
+  for (const auto& label : pendingUpdates_.getChangedLabels()) {
+    auto it = labelToPrefixes_.find(label);
+    if (it != labelToPrefixes_.end()) {
+      dirtyPrefixes.insert(it->second.begin(), it->second.end());
     }
   }
 
-  for (const auto& [prefix, prefixEntries] : prefixMap_) {
-    receivedPrefixCnt += prefixEntries.size();
+  for (const auto& prefix : dirtyPrefixes) {
+    auto prefixIt = prefixMap_.find(prefix);
+    if (prefixIt == prefixMap_.end()) {
+      // Withdraw prefixes that no longer exist.
+      if (pendingUpdates_.hasPrefix(prefix)) {
+        deletePrefixKeysInKvStore(prefix, routeUpdatesForDecision);
+        advertisedPrefixEntries_.erase(prefix);
+        awaitingPrefixes_.erase(prefix);
+        updatePrefixLabelIndex(prefix);
+        ++syncedPrefixCnt;
+      }
+      continue;
+    }
+    const auto& prefixEntries = prefixIt->second;
 
     // Check if prefix is updated and ready to be advertised.
     auto [_, bestEntry] =
@@ -721,6 +935,8 @@ PrefixManager::syncKvStore() {
           folly::IPAddress::networkToString(prefix));
       updatePrefixKeysInKvStore(prefix, bestEntry);
       advertisedPrefixEntries_[prefix] = bestEntry;
+      awaitingPrefixes_.erase(prefix);
+      updatePrefixLabelIndex(prefix);
       ++syncedPrefixCnt;
       continue;
     } else if (readyToBeAdvertised) {
@@ -730,7 +946,7 @@ PrefixManager::syncKvStore() {
     }
 
     // The prefix is awaiting to be advertised.
-    ++awaitingPrefixCnt;
+    awaitingPrefixes_.emplace(prefix);
 
     // Check if previously advertised prefix is no longer ready to be
     // advertised.
@@ -744,8 +960,12 @@ PrefixManager::syncKvStore() {
       advertisedPrefixEntries_.erase(prefix);
       ++syncedPrefixCnt;
     }
+    updatePrefixLabelIndex(prefix);
   } // for
 
+  // Write prefix buckets modified by this round of syncing.
+  flushPrefixDbBuckets();
+
   // Reset pendingUpdates_ since all pending updates are processed.
   pendingUpdates_.clear();
 
@@ -768,17 +988,17 @@ PrefixManager::syncKvStore() {
   XLOG(DBG1) << fmt::format(
       "[KvStore Sync] Updated {} prefixes in KvStore; {} more awaiting FIB-ACK.",
       syncedPrefixCnt,
-      awaitingPrefixCnt);
+      awaitingPrefixes_.size());
 
   // Update flat counters
   fb303::fbData->setCounter(
-      "prefix_manager.received_prefixes", receivedPrefixCnt);
+      "prefix_manager.received_prefixes", numPrefixEntries_);
   // TODO: report per-area advertised prefixes if openr is running in
   // multi-areas.
   fb303::fbData->setCounter(
       "prefix_manager.advertised_prefixes", advertisedPrefixEntries_.size());
   fb303::fbData->setCounter(
-      "prefix_manager.awaiting_prefixes", awaitingPrefixCnt);
+      "prefix_manager.awaiting_prefixes", awaitingPrefixes_.size());
 }
 
 folly::SemiFuture<bool>
@@ -1234,7 +1454,8 @@ PrefixManager::applyOriginationPolicy(
   // Store them before applying origination policy for future debugging purpose
   storeOriginatedPrefixes(prefixEntries, policyName);
   std::vector<PrefixEntry> postOriginationPrefixes = {};
-  for (auto prefix : prefixEntries) {
+  postOriginationPrefixes.reserve(prefixEntries.size());
+  for (const auto& prefix : prefixEntries) {
     auto [postPolicyTPrefixEntry, _] = policyManager_->applyPolicy(
         policyName,
         prefix.tPrefixEntry,
@@ -1249,7 +1470,7 @@ PrefixManager::applyOriginationPolicy(
       postOriginationPrefixes.emplace_back(
           std::move(postPolicyTPrefixEntry),
           std::move(dstAreasCp),
-          std::move(prefix.nexthops));
+          prefix.nexthops);
     } else {
       XLOG(DBG1) << fmt::format(
           "Not processing prefixes {} : denied by origination policy {}",
@@ -1324,6 +1545,8 @@ PrefixManager::advertisePrefixesImpl(
       }
       // Case 2: update existing `PrefixEntry`
       it->second = entry;
+    } else {
+      ++numPrefixEntries_;
     }
     // Case 3: store pendingUpdate for batch processing
     pendingUpdates_.addPrefixChange(prefixCidr);
@@ -1359,6 +1582,7 @@ PrefixManager::withdrawPrefixesImpl(
     // ONLY populate changed collection when successfully erased key
     if (typeIt != prefixMap_.end() and typeIt->second.erase(type)) {
       updated = true;
+      --numPrefixEntries_;
       // store pendingUpdate for batch processing
       pendingUpdates_.addPrefixChange(prefixCidr);
       // clean up data structure
@@ -1396,6 +1620,7 @@ PrefixManager::withdrawPrefixEntriesImpl(
     // ONLY populate changed collection when successfully erased key
     if (typeIt != prefixMap_.end() and typeIt->second.erase(type)) {
       updated = true;
+      --numPrefixEntries_;
       // store pendingUpdate for batch processing
       pendingUpdates_.addPrefixChange(prefixEntry.network);
       // clean up data structure
@@ -1459,6 +1684,105 @@ PrefixManager::withdrawPrefixesByTypeImpl(thrift::PrefixType type) {
   return withdrawPrefixesImpl(toRemove);
 }
 
+void
+PrefixManager::stagePrefixesByTypeImpl(
+    thrift::PrefixType type,
+    std::vector<thrift::PrefixEntry>&& tPrefixEntries,
+    const std::unordered_set<std::string>& dstAreas,
+    const std::optional<std::string>& policyName) {
+  if (tPrefixEntries.empty()) {
+    return;
+  }
+
+  auto& staged = stagedPrefixes_[type];
+  for (auto& tPrefixEntry : tPrefixEntries) {
+    CHECK(type == *tPrefixEntry.type_ref());
+    auto dstAreasCp = dstAreas;
+    PrefixEntry prefixEntry(
+        std::make_shared<thrift::PrefixEntry>(std::move(tPrefixEntry)),
+        std::move(dstAreasCp));
+    auto network = prefixEntry.network;
+    staged.insert_or_assign(
+        std::move(network), std::make_pair(std::move(prefixEntry), policyName));
+  }
+  XLOG(DBG2) << fmt::format(
+      "[Prefix Event] Staged {} prefixes of type {}, {} in total",
+      tPrefixEntries.size(),
+      toString(type),
+      staged.size());
+}
+
+size_t
+PrefixManager::commitPrefixesByTypeImpl(thrift::PrefixType type) {
+  std::unordered_map<
+      folly::CIDRNetwork,
+      std::pair<PrefixEntry, std::optional<std::string>>>
+      staged;
+  auto stagedIt = stagedPrefixes_.find(type);
+  if (stagedIt != stagedPrefixes_.end()) {
+    staged = std::move(stagedIt->second);
+    stagedPrefixes_.erase(stagedIt);
+  }
+  XLOG(INFO) << fmt::format(
+      "[Prefix Event] Committing {} staged prefixes of type {}",
+      staged.size(),
+      toString(type));
+
+  // Apply origination policy now, as prefixes take effect. Prefixes are
+  // grouped by policy to apply each policy once.
+  std::vector<PrefixEntry> toAddOrUpdate;
+  std::unordered_map<std::string, std::vector<PrefixEntry>> policyToPrefixes;
+  toAddOrUpdate.reserve(staged.size());
+  for (auto& [_, prefixEntryPolicyPair] : staged) {
+    auto& [prefixEntry, policyName] = prefixEntryPolicyPair;
+    if (policyName) {
+      policyToPrefixes[*policyName].emplace_back(std::move(prefixEntry));
+    } else {
+      toAddOrUpdate.emplace_back(std::move(prefixEntry));
+    }
+  }
+  for (auto const& [policyName, prefixEntries] : policyToPrefixes) {
+    for (auto& prefixEntry :
+         applyOriginationPolicy(prefixEntries, policyName)) {
+      toAddOrUpdate.emplace_back(std::move(prefixEntry));
+    }
+  }
+
+  // Withdraw prefixes of the type which are not committed
+  std::unordered_set<folly::CIDRNetwork> committed;
+  for (auto const& prefixEntry : toAddOrUpdate) {
+    committed.emplace(prefixEntry.network);
+  }
+  std::vector<thrift::PrefixEntry> toRemove;
+  for (auto const& [prefix, typeToPrefixes] : prefixMap_) {
+    auto it = typeToPrefixes.find(type);
+    if (it != typeToPrefixes.end() and not committed.count(prefix)) {
+      toRemove.emplace_back(*it->second.tPrefixEntry);
+    }
+  }
+
+  // Both are applied within single pending updates batch, hence KvStore sees
+  // the final set of prefixes only
+  advertisePrefixesImpl(toAddOrUpdate);
+  withdrawPrefixesImpl(toRemove);
+  return toAddOrUpdate.size();
+}
+
+size_t
+PrefixManager::abortStagedPrefixesByTypeImpl(thrift::PrefixType type) {
+  size_t numPrefixes{0};
+  auto stagedIt = stagedPrefixes_.find(type);
+  if (stagedIt != stagedPrefixes_.end()) {
+    numPrefixes = stagedIt->second.size();
+    stagedPrefixes_.erase(stagedIt);
+  }
+  XLOG(INFO) << fmt::format(
+      "[Prefix Event] Discarded {} staged prefixes of type {}",
+      numPrefixes,
+      toString(type));
+  return numPrefixes;
+}
+
 void
 PrefixManager::aggregatesToAdvertise(const folly::CIDRNetwork& prefix) {
   // ATTN: ignore attribute-ONLY update for existing RIB entries
@@ -1469,24 +1793,20 @@ PrefixManager::aggregatesToAdvertise(const folly::CIDRNetwork& prefix) {
     return;
   }
 
-  for (auto& [network, route] : originatedPrefixDb_) {
-    // folly::CIDRNetwork.first -> IPAddress
-    // folly::CIDRNetwork.second -> cidr length
-    if (not prefix.first.inSubnet(network.first, network.second)) {
-      continue;
-    }
-
-    XLOG(DBG1) << "[Route Origination] Adding supporting route "
-               << folly::IPAddress::networkToString(prefix)
-               << " for originated route "
-               << folly::IPAddress::networkToString(network);
+  // walk OriginatedPrefixes whose subnet contains the prefix address
+  originatedPrefixTrie_.forEachCovering(
+      prefix.first, [&](const folly::CIDRNetwork& network, folly::Unit&) {
+        XLOG(DBG1) << "[Route Origination] Adding supporting route "
+                   << folly::IPAddress::networkToString(prefix)
+                   << " for originated route "
+                   << folly::IPAddress::networkToString(network);
 
-    // reverse mapping: RIB prefixEntry -> OriginatedPrefixes
-    ribPrefixIt->second.emplace_back(network);
+        // reverse mapping: RIB prefixEntry -> OriginatedPrefixes
+        ribPrefixIt->second.emplace_back(network);
 
-    // mapping: OriginatedPrefix -> RIB prefixEntries
-    route.supportingRoutes.emplace(prefix);
-  }
+        // mapping: OriginatedPrefix -> RIB prefixEntries
+        originatedPrefixDb_.at(network).supportingRoutes.emplace(prefix);
+      });
 }
 
 void
@@ -1531,7 +1851,7 @@ PrefixManager::processOriginatedPrefixes() {
           allAreaIds());
       if (route.originatedPrefix.install_to_fib_ref().has_value() &&
           *route.originatedPrefix.install_to_fib_ref()) {
-        advertisedPrefixes.back().nexthops = route.unicastEntry.nexthops;
+        advertisedPrefixes.back().nexthops = route.unicastEntry.nexthops.get();
       }
       XLOG(INFO) << "[Route Origination] Advertising originated route "
                  << folly::IPAddress::networkToString(network);
@@ -1671,6 +1991,9 @@ PrefixManager::redistributePrefixesAcrossAreas(
 
   std::vector<PrefixEntry> advertisedPrefixes{};
   std::vector<thrift::PrefixEntry> withdrawnPrefixes{};
+  const bool redistribute = areaToPolicy_.size() > 1;
+  size_t numRecomputed{0};
+  size_t numSkipped{0};
 
   // ATTN: Routes imported from local BGP won't show up inside
   // `fibRouteUpdate`. However, local-originated static route
@@ -1694,6 +2017,37 @@ PrefixManager::redistributePrefixesAcrossAreas(
       }
     }
 
+    // Populate areas to redistribute the route into
+    auto dstAreas = allAreaIds();
+    for (const auto& nh : route.nexthops) {
+      if (nh.area_ref().has_value()) {
+        dstAreas.erase(*nh.area_ref());
+      }
+    }
+
+    // Skip route whose best entry, best area, igp cost and destination areas
+    // are all the same as last time, e.g. in full-table update after
+    // reconnect. Its redistributed entry and area policy results still hold.
+    if (redistribute) {
+      auto redistributedIt = redistributedRoutes_.find(prefix);
+      auto prefixIt = prefixMap_.find(prefix);
+      if (redistributedIt != redistributedRoutes_.end() and
+          redistributedIt->second.bestPrefixEntry == prefixEntry and
+          redistributedIt->second.bestArea == route.bestArea and
+          redistributedIt->second.igpCost == route.igpCost and
+          redistributedIt->second.dstAreas == dstAreas and
+          prefixIt != prefixMap_.end() and
+          prefixIt->second.count(thrift::PrefixType::RIB)) {
+        ++numSkipped;
+        continue;
+      }
+      redistributedRoutes_.insert_or_assign(
+          prefix,
+          RedistributedRoute{
+              prefixEntry, route.bestArea, dstAreas, route.igpCost});
+      ++numRecomputed;
+    }
+
     // Update interested mutable transitive attributes.
     //
     // For OpenR route representation, referring to
@@ -1719,12 +2073,6 @@ PrefixManager::redistributePrefixesAcrossAreas(
     resetNonTransitiveAttrs(prefixEntry);
 
     // Populate routes to be advertised to KvStore
-    auto dstAreas = allAreaIds();
-    for (const auto& nh : route.nexthops) {
-      if (nh.area_ref().has_value()) {
-        dstAreas.erase(*nh.area_ref());
-      }
-    }
     advertisedPrefixes.emplace_back(
         std::make_shared<thrift::PrefixEntry>(std::move(prefixEntry)),
         std::move(dstAreas),
@@ -1745,6 +2093,7 @@ PrefixManager::redistributePrefixesAcrossAreas(
     }
 
     // Routes to be withdrawn via KvStore
+    redistributedRoutes_.erase(prefix);
     withdrawnPrefixes.emplace_back(
         createPrefixEntry(toIpPrefix(prefix), thrift::PrefixType::RIB));
 
@@ -1758,9 +2107,14 @@ PrefixManager::redistributePrefixesAcrossAreas(
   // Redisrtibute RIB route ONLY when there are multiple `areaId` configured .
   // We want to keep processFibRouteUpdates() running as dynamic
   // configuration could add/remove areas.
-  if (areaToPolicy_.size() > 1) {
+  if (redistribute) {
     advertisePrefixesImpl(advertisedPrefixes);
     withdrawPrefixesImpl(withdrawnPrefixes);
+
+    fb303::fbData->addStatValue(
+        "prefix_manager.redistribution_recomputed", numRecomputed, fb303::SUM);
+    fb303::fbData->addStatValue(
+        "prefix_manager.redistribution_skipped", numSkipped, fb303::SUM);
   }
 
   // ignore mpls updates
@@ -7,12 +7,15 @@
 
 #pragma once
 
+#include <map>
+
 #include <folly/IPAddress.h>
 #include <folly/futures/Future.h>
 #include <folly/gen/Base.h>
 
 #include <openr/common/AsyncThrottle.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/PrefixTrie.h>
 #include <openr/common/Types.h>
 #include <openr/common/Util.h>
 #include <openr/config/Config.h>
@@ -51,6 +54,11 @@ class PrefixManagerPendingUpdates {
     return changedPrefixes_.count(prefix) > 0;
   }
 
+  const std::unordered_set<int32_t>&
+  getChangedLabels() {
+    return changedLabels_;
+  }
+
   bool
   hasLabel(const int32_t label) {
     return changedLabels_.count(label) > 0;
@@ -215,6 +223,12 @@ class PrefixManager final : public OpenrEventBase {
   // Process thrift publication from KvStore.
   void processPublication(thrift::Publication&& thriftPub);
 
+  // Process own prefix bucket key seen in KvStore. Stale bucket is cleared.
+  void processPrefixBucketPublication(
+      const std::string& area,
+      const std::string& keyStr,
+      const thrift::PrefixDatabase& prefixDb);
+
   /*
    * Private helpers to update `prefixMap_`
    *
@@ -240,6 +254,27 @@ class PrefixManager final : public OpenrEventBase {
       const std::vector<thrift::PrefixEntry>& tPrefixEntries);
   bool withdrawPrefixEntriesImpl(const std::vector<PrefixEntry>& prefixEntries);
   bool withdrawPrefixesByTypeImpl(thrift::PrefixType type);
+
+  /*
+   * Stage prefixes of the type for commitPrefixesByTypeImpl(). Staged prefixes
+   * take no effect, nor their origination policy is applied, until commit.
+   */
+  void stagePrefixesByTypeImpl(
+      thrift::PrefixType type,
+      std::vector<thrift::PrefixEntry>&& tPrefixEntries,
+      const std::unordered_set<std::string>& dstAreas,
+      const std::optional<std::string>& policyName);
+
+  /*
+   * Replace prefixes of the type with staged ones. Return number of committed
+   * prefixes.
+   */
+  size_t commitPrefixesByTypeImpl(thrift::PrefixType type);
+
+  /*
+   * Discard staged prefixes of the type. Return number of discarded prefixes.
+   */
+  size_t abortStagedPrefixesByTypeImpl(thrift::PrefixType type);
   bool syncPrefixesByTypeImpl(
       thrift::PrefixType type,
       const std::vector<thrift::PrefixEntry>& tPrefixEntries,
@@ -270,6 +305,9 @@ class PrefixManager final : public OpenrEventBase {
    */
   void syncKvStore();
 
+  // Re-index MPLS labels referred by best and advertised entry of the prefix
+  void updatePrefixLabelIndex(const folly::CIDRNetwork& prefix);
+
   // Update KvStore keys of one prefix entry.
   void updatePrefixKeysInKvStore(
       const folly::CIDRNetwork& prefix, const PrefixEntry& prefixEntry);
@@ -288,6 +326,18 @@ class PrefixManager final : public OpenrEventBase {
       const folly::CIDRNetwork& prefix,
       const std::unordered_set<std::string>& deletedArea);
 
+  // Clear per prefix key of the prefix from KvStore and flood deletion
+  void clearPrefixKey(
+      const std::string& area,
+      const std::string& prefixKeyStr,
+      const folly::CIDRNetwork& prefix);
+
+  /*
+   * Write modified prefix buckets to KvStore, or clear emptied and stale
+   * ones. See OpenrConfig::prefix_db_key_buckets.
+   */
+  void flushPrefixDbBuckets();
+
   /*
    * Send static unicast routes for prefix entries of certain type in OpenR
    * initialization process.
@@ -410,9 +460,45 @@ class PrefixManager final : public OpenrEventBase {
       folly::CIDRNetwork,
       std::unordered_map<thrift::PrefixType, PrefixEntry>>
       prefixMap_;
+  // Prefixes staged by STAGE_PREFIXES_BY_TYPE events, along with their
+  // origination policy, awaiting COMMIT_PREFIXES_BY_TYPE event of the type.
+  std::unordered_map<
+      thrift::PrefixType,
+      std::unordered_map<
+          folly::CIDRNetwork,
+          std::pair<PrefixEntry, std::optional<std::string>>>>
+      stagedPrefixes_;
+
+  /*
+   * Fib routes redistributed across areas, with inputs of redistribution as
+   * received from Fib. Route with unchanged inputs is not redistributed again.
+   */
+  struct RedistributedRoute {
+    thrift::PrefixEntry bestPrefixEntry;
+    std::string bestArea;
+    std::unordered_set<std::string> dstAreas;
+    unsigned int igpCost{0};
+  };
+  std::unordered_map<folly::CIDRNetwork, RedistributedRoute>
+      redistributedRoutes_;
+
   // Advertised prefixes in KvStore and associated best PrefixEntry.
   std::unordered_map<folly::CIDRNetwork, PrefixEntry> advertisedPrefixEntries_;
 
+  // Number of entries across all prefixes in prefixMap_
+  size_t numPrefixEntries_{0};
+
+  // Prefixes whose best PrefixEntry is not ready to be advertised yet
+  std::unordered_set<folly::CIDRNetwork> awaitingPrefixes_;
+
+  // MPLS label -> prefixes whose best or advertised PrefixEntry prepends it,
+  // and the reverse mapping. Lets syncKvStore() revisit only prefixes affected
+  // by programmed label changes instead of scanning whole prefixMap_.
+  std::unordered_map<int32_t, std::unordered_set<folly::CIDRNetwork>>
+      labelToPrefixes_;
+  std::unordered_map<folly::CIDRNetwork, std::vector<int32_t>>
+      prefixToLabels_;
+
   // For prefixes came from PrefixEvent with an origination policy,
   // store the pre-policy version in originatedPrefixMap_.
   // Used in thrift request getAdvertisedRoutesWithOriginationPolicy().
@@ -518,6 +604,26 @@ class PrefixManager final : public OpenrEventBase {
    */
   bool preferOpenrOriginatedRoutes_{false};
 
+  /*
+   * Number of PrefixDatabase keys per area prefixes are packed into.
+   * Unset means one key per prefix.
+   * Turned on via thrift::OpenrConfig::prefix_db_key_buckets
+   */
+  std::optional<size_t> prefixDbKeyBuckets_;
+
+  // Post-policy prefix entries advertised per area and bucket. Ordered to
+  // serialize same bucket content always the same way.
+  std::unordered_map<
+      std::string /* area */,
+      std::unordered_map<
+          size_t /* bucket */,
+          std::map<folly::CIDRNetwork, thrift::PrefixEntry>>>
+      prefixDbBuckets_;
+
+  // Buckets modified since last flush, per area
+  std::unordered_map<std::string /* area */, std::unordered_set<size_t>>
+      dirtyPrefixDbBuckets_;
+
   /*
    * prefixes to be originated from prefix-manager
    * ATTN: to support quick information retrieval, cache the mapping:
@@ -526,6 +632,13 @@ class PrefixManager final : public OpenrEventBase {
    */
   std::unordered_map<folly::CIDRNetwork, OriginatedRoute> originatedPrefixDb_;
 
+  /*
+   * Trie index of `originatedPrefixDb_`. Lets FIB prefixEntry find all its
+   * covering OriginatedPrefixes with single walk instead of checking every
+   * OriginatedPrefix.
+   */
+  PrefixTrie<folly::Unit> originatedPrefixTrie_;
+
   /*
    * prefixes received from OpenR/Fib.
    * ATTN: to avoid loop through ALL entries inside `originatedPrefixes`,
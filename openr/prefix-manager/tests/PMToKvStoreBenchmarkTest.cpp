@@ -91,6 +91,11 @@ class PMToKvStoreBMTestFixture {
     return prefixGenerator_;
   }
 
+  void
+  pushPrefixEvent(PrefixEvent&& event) {
+    prefixUpdatesQueue_.push(std::move(event));
+  }
+
   void
   checkPrefixesInKvStore(uint32_t num) {
     while (true) {
@@ -298,6 +303,68 @@ BM_PrefixManagerWithdrawPrefixes(
   }
 }
 
+/*
+ * Benchmark test for bulk prefix ingestion: The time measured includes prefix
+ * manager processing time and kvstore processing time.
+ * Test setup:
+ *  - Generate `numOfPrefixes` and split them into chunks of `chunkSize`
+ * Benchmark:
+ *  - Stream chunks with STAGE_PREFIXES_BY_TYPE events followed by a single
+ * COMMIT_PREFIXES_BY_TYPE, and wait for all prefixes announced by KvStore
+ */
+static void
+BM_PrefixManagerStagedAdvertisePrefixes(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfPrefixes,
+    uint32_t chunkSize) {
+  // Spawn suspender object to NOT calculating setup time into benchmark
+  auto suspender = folly::BenchmarkSuspender();
+  uint64_t totalUs{0};
+
+  const std::string nodeId{"node-1"};
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto testFixture = std::make_unique<PMToKvStoreBMTestFixture>(nodeId);
+
+    // Generate `numOfPrefixes` and split them into chunks
+    auto prefixes =
+        generatePrefixEntries(testFixture->getPrefixGenerator(), numOfPrefixes);
+    std::vector<std::vector<thrift::PrefixEntry>> chunks;
+    for (size_t start = 0; start < prefixes.size(); start += chunkSize) {
+      const auto end = std::min(prefixes.size(), start + chunkSize);
+      chunks.emplace_back(
+          std::make_move_iterator(prefixes.begin() + start),
+          std::make_move_iterator(prefixes.begin() + end));
+    }
+
+    // Start measuring benchmark time
+    suspender.dismiss();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for (auto& chunk : chunks) {
+      testFixture->pushPrefixEvent(PrefixEvent(
+          PrefixEventType::STAGE_PREFIXES_BY_TYPE,
+          thrift::PrefixType::DEFAULT,
+          std::move(chunk)));
+    }
+    testFixture->pushPrefixEvent(PrefixEvent(
+        PrefixEventType::COMMIT_PREFIXES_BY_TYPE, thrift::PrefixType::DEFAULT));
+    testFixture->checkThriftPublication(numOfPrefixes, false);
+
+    totalUs += std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - startTime)
+                   .count();
+
+    // Stop measuring benchmark time
+    suspender.rehire();
+  }
+
+  if (totalUs > 0) {
+    counters["prefixes_per_sec"] =
+        static_cast<uint64_t>(numOfPrefixes) * iters * 1000000 / totalUs;
+  }
+}
+
 /*
  * Benchmark test for prefixes flap: The time measured includes prefix
  * manager processing time and kvstore processing time.
@@ -553,6 +620,30 @@ BENCHMARK_COUNTERS_NAME_PARAM(
     BM_PrefixManagerWithdrawPrefixes, counters, 100000_10000, 100000, 10000);
 BENCHMARK_COUNTERS_NAME_PARAM(
     BM_PrefixManagerWithdrawPrefixes, counters, 100000_100000, 100000, 100000);
+/*
+ * @first integer: number of prefixes to stream into PrefixManager
+ * @second integer: number of prefixes per chunk
+ */
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixManagerStagedAdvertisePrefixes, counters, 10000_1000, 10000, 1000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixManagerStagedAdvertisePrefixes,
+    counters,
+    100000_1000,
+    100000,
+    1000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixManagerStagedAdvertisePrefixes,
+    counters,
+    100000_10000,
+    100000,
+    10000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_PrefixManagerStagedAdvertisePrefixes,
+    counters,
+    1000000_10000,
+    1000000,
+    10000);
 /*
  * @first integer: number of prefixes existing inside PrefixManager
  * @second integer: number of prefixes to flap
@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <ctime>
+
 #include <openr/tests/utils/Utils.h>
 
 #include <folly/Benchmark.h>
@@ -138,6 +140,16 @@ class PrefixManagerBenchmarkTestFixture {
     }
   }
 
+  // CPU time consumed by PrefixManager thread so far
+  std::chrono::microseconds
+  getPrefixManagerCpuTime() {
+    struct timespec ts {};
+    prefixManager_->getEvb()->runInEventBaseThreadAndWait(
+        [&ts]() { clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts); });
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+  }
+
   fbzmq::Context context_;
 
   // Queue for publishing entries to PrefixManager
@@ -235,6 +247,61 @@ BM_AdvertiseWithKvRequestQueue(
   }
 }
 
+/*
+ * Benchmark test for incremental sync of single prefix advertisements. Wall
+ * time is dominated by KvStore sync throttling, hence CPU time spent by
+ * PrefixManager per advertisement is reported as counter. It should stay flat
+ * regardless of number of existing prefixes.
+ * Test setup:
+ *  - Generate `numOfExistingPrefixes` and inject them into prefix manager
+ * Benchmark:
+ *  - Advertise `numOfUpdates` prefixes one by one, waiting for KeyValRequest
+ *    of each before advertising the next one
+ */
+static void
+BM_AdvertiseSinglePrefixCpuTime(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfExistingPrefixes,
+    uint32_t numOfUpdates) {
+  auto suspender = folly::BenchmarkSuspender();
+
+  const std::string nodeId{"node-1"};
+  std::chrono::microseconds totalCpuTime{0};
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto testFixture =
+        std::make_unique<PrefixManagerBenchmarkTestFixture>(nodeId, 1);
+    auto kvRequestReaderQ = testFixture->kvRequestQueue_.getReader();
+
+    auto prefixes = generatePrefixEntries(
+        testFixture->getPrefixGenerator(), numOfExistingPrefixes);
+    testFixture->prefixUpdatesQueue_.push(PrefixEvent(
+        PrefixEventType::ADD_PREFIXES, thrift::PrefixType::BGP, prefixes));
+    testFixture->checkKeyValRequest(numOfExistingPrefixes, kvRequestReaderQ);
+
+    // Generate all prefixes upfront to not account generation time
+    auto prefixesToAdvertise = generatePrefixEntries(
+        testFixture->getPrefixGenerator(), numOfUpdates);
+    const auto cpuTimeBefore = testFixture->getPrefixManagerCpuTime();
+
+    suspender.dismiss();
+    for (uint32_t j = 0; j < numOfUpdates; ++j) {
+      testFixture->prefixUpdatesQueue_.push(PrefixEvent(
+          PrefixEventType::ADD_PREFIXES,
+          thrift::PrefixType::BGP,
+          {prefixesToAdvertise.at(j)}));
+      testFixture->checkKeyValRequest(
+          numOfExistingPrefixes + j + 1, kvRequestReaderQ);
+    }
+    suspender.rehire();
+
+    totalCpuTime += testFixture->getPrefixManagerCpuTime() - cpuTimeBefore;
+  }
+
+  counters["cpu_time_per_update(us)"] =
+      totalCpuTime.count() / (iters * numOfUpdates);
+}
+
 /*
  * Benchmark test for Prefix Withdrawals: The time measured includes prefix
  * manager processing time and pushes KeyValRequests into kvRequestQueue.
@@ -500,6 +567,15 @@ BENCHMARK_COUNTERS_PARAM(
 BENCHMARK_COUNTERS_PARAM(
     BM_AdvertiseWithKvRequestQueue, counters, 100000, 100000);
 
+/*
+ * @first integer: number of prefixes existing inside PrefixManager
+ * @second integer: number of single prefix advertisements
+ */
+
+BENCHMARK_COUNTERS_PARAM(BM_AdvertiseSinglePrefixCpuTime, counters, 1000, 10);
+BENCHMARK_COUNTERS_PARAM(BM_AdvertiseSinglePrefixCpuTime, counters, 10000, 10);
+BENCHMARK_COUNTERS_PARAM(BM_AdvertiseSinglePrefixCpuTime, counters, 100000, 10);
+
 /*
  * @first integer: number of prefixes existing inside PrefixManager
  * @second integer: number of prefixes to withdraw
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/IPAddress.h>
 #include <folly/init/Init.h>
 #include <glog/logging.h>
@@ -30,6 +31,8 @@ using namespace openr;
 
 using apache::thrift::CompactSerializer;
 
+namespace fb303 = facebook::fb303;
+
 namespace {
 
 const std::chrono::milliseconds kRouteUpdateTimeout =
@@ -743,6 +746,63 @@ TEST_F(PrefixManagerTestFixture, PrefixKeySubscription) {
   evb.run();
 }
 
+class PrefixManagerBucketTestFixture : public PrefixManagerTestFixture {
+ public:
+  virtual thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = PrefixManagerTestFixture::createConfig();
+    tConfig.prefix_db_key_buckets_ref() = 1;
+    return tConfig;
+  }
+
+  // Receive publication of the only bucket key
+  thrift::PrefixDatabase
+  recvPrefixBucket() {
+    auto pub = kvStoreWrapper->recvPublication();
+    EXPECT_EQ(1, pub.keyVals_ref()->size());
+    const auto& [key, val] = *pub.keyVals_ref()->begin();
+    EXPECT_EQ(PrefixKey::getPrefixBucketKey(nodeId_, 0), key);
+    return readThriftObjStr<thrift::PrefixDatabase>(
+        *val.value_ref(), serializer);
+  }
+};
+
+/**
+ * Prefixes are packed into bucket key. Withdrawal re-writes the bucket, and
+ * emptied bucket is cleared.
+ */
+TEST_F(PrefixManagerBucketTestFixture, PrefixBucketKeys) {
+  // advertise prefixes in single bucket key
+  {
+    prefixManager->advertisePrefixes({prefixEntry1, prefixEntry3, prefixEntry5})
+        .get();
+    auto prefixDb = recvPrefixBucket();
+    EXPECT_FALSE(*prefixDb.deletePrefix_ref());
+    EXPECT_THAT(
+        *prefixDb.prefixEntries_ref(),
+        testing::UnorderedElementsAre(
+            prefixEntry1, prefixEntry3, prefixEntry5));
+  }
+
+  // withdraw prefix re-writes the bucket
+  {
+    prefixManager->withdrawPrefixes({prefixEntry3}).get();
+    auto prefixDb = recvPrefixBucket();
+    EXPECT_FALSE(*prefixDb.deletePrefix_ref());
+    EXPECT_THAT(
+        *prefixDb.prefixEntries_ref(),
+        testing::UnorderedElementsAre(prefixEntry1, prefixEntry5));
+  }
+
+  // withdraw remaining prefixes clears the bucket
+  {
+    prefixManager->withdrawPrefixes({prefixEntry1, prefixEntry5}).get();
+    auto prefixDb = recvPrefixBucket();
+    EXPECT_TRUE(*prefixDb.deletePrefix_ref());
+    EXPECT_TRUE(prefixDb.prefixEntries_ref()->empty());
+  }
+}
+
 class PrefixManagerSmallTtlTestFixture : public PrefixManagerTestFixture {
  public:
   virtual thrift::OpenrConfig
@@ -1066,6 +1126,166 @@ TEST_F(PrefixManagerTestFixture, PrefixUpdatesQueue) {
   }
 }
 
+/**
+ * Prefixes streamed with STAGE_PREFIXES_BY_TYPE events must not be advertised
+ * until COMMIT_PREFIXES_BY_TYPE, which replaces prefixes of the type at once.
+ */
+TEST_F(PrefixManagerTestFixture, StagedPrefixUpdatesQueue) {
+  const auto prefixEntry8Bgp =
+      createPrefixEntry(addr8, thrift::PrefixType::BGP);
+
+  // Existing BGP prefix
+  {
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::ADD_PREFIXES,
+        thrift::PrefixType::BGP,
+        {prefixEntry7}));
+    auto pub = kvStoreWrapper->recvPublication();
+    EXPECT_EQ(1, pub.keyVals_ref()->size());
+  }
+
+  // Stream new BGP prefixes in chunks. Prefix of other type added after
+  // chunks is the only one advertised.
+  {
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::STAGE_PREFIXES_BY_TYPE,
+        thrift::PrefixType::BGP,
+        {prefixEntry1Bgp}));
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::STAGE_PREFIXES_BY_TYPE,
+        thrift::PrefixType::BGP,
+        {prefixEntry8Bgp}));
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::ADD_PREFIXES,
+        thrift::PrefixType::DEFAULT,
+        {prefixEntry3}));
+
+    auto pub = kvStoreWrapper->recvPublication();
+    EXPECT_EQ(1, pub.keyVals_ref()->size());
+
+    auto prefixes = prefixManager->getPrefixes().get();
+    EXPECT_THAT(
+        *prefixes, testing::UnorderedElementsAre(prefixEntry7, prefixEntry3));
+  }
+
+  // Commit withdraws `prefixEntry7` and advertises staged prefixes
+  {
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::COMMIT_PREFIXES_BY_TYPE, thrift::PrefixType::BGP));
+
+    size_t numKeys{0};
+    while (numKeys < 3) {
+      numKeys += kvStoreWrapper->recvPublication().keyVals_ref()->size();
+    }
+    EXPECT_EQ(3, numKeys);
+
+    auto prefixes = prefixManager->getPrefixes().get();
+    EXPECT_THAT(
+        *prefixes,
+        testing::UnorderedElementsAre(
+            prefixEntry3, prefixEntry1Bgp, prefixEntry8Bgp));
+  }
+}
+
+class PrefixManagerOriginationPolicyTestFixture
+    : public PrefixManagerTestFixture {
+ public:
+  virtual thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = PrefixManagerTestFixture::createConfig();
+    tConfig.area_policies_ref() =
+        neteng::config::routing_policy::PolicyConfig();
+    return tConfig;
+  }
+
+  // Get originated prefixes, before origination policy is applied
+  std::vector<thrift::AdvertisedRoute>
+  getOriginatedRoutes() {
+    return *prefixManager
+                ->getAdvertisedRoutesWithOriginationPolicy(
+                    thrift::RouteFilterType::PREFILTER_ADVERTISED,
+                    thrift::AdvertisedRouteFilter())
+                .get();
+  }
+
+ protected:
+  const std::string policyName_{"origination-policy"};
+};
+
+/**
+ * Staged prefixes, along with their origination policy, take no effect until
+ * commit. Aborted ones never do.
+ */
+TEST_F(
+    PrefixManagerOriginationPolicyTestFixture, StagedPrefixesWithPolicyAbort) {
+  // Staged prefix is neither advertised nor reported as originated
+  {
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::STAGE_PREFIXES_BY_TYPE,
+        thrift::PrefixType::BGP,
+        {prefixEntry1Bgp},
+        {},
+        policyName_));
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::ADD_PREFIXES,
+        thrift::PrefixType::DEFAULT,
+        {prefixEntry3}));
+
+    auto pub = kvStoreWrapper->recvPublication();
+    EXPECT_EQ(1, pub.keyVals_ref()->size());
+
+    auto prefixes = prefixManager->getPrefixes().get();
+    EXPECT_THAT(*prefixes, testing::UnorderedElementsAre(prefixEntry3));
+    EXPECT_TRUE(getOriginatedRoutes().empty());
+  }
+
+  // Aborted prefix is not committed. Prefix added after commit is the only
+  // one advertised.
+  {
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::ABORT_STAGED_PREFIXES_BY_TYPE,
+        thrift::PrefixType::BGP));
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::COMMIT_PREFIXES_BY_TYPE, thrift::PrefixType::BGP));
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::ADD_PREFIXES,
+        thrift::PrefixType::DEFAULT,
+        {prefixEntry5}));
+
+    auto pub = kvStoreWrapper->recvPublication();
+    EXPECT_EQ(1, pub.keyVals_ref()->size());
+
+    auto prefixes = prefixManager->getPrefixes().get();
+    EXPECT_THAT(
+        *prefixes, testing::UnorderedElementsAre(prefixEntry3, prefixEntry5));
+    EXPECT_TRUE(getOriginatedRoutes().empty());
+  }
+
+  // Committed prefix is advertised and reported as originated
+  {
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::STAGE_PREFIXES_BY_TYPE,
+        thrift::PrefixType::BGP,
+        {prefixEntry1Bgp},
+        {},
+        policyName_));
+    prefixUpdatesQueue.push(PrefixEvent(
+        PrefixEventType::COMMIT_PREFIXES_BY_TYPE, thrift::PrefixType::BGP));
+
+    auto pub = kvStoreWrapper->recvPublication();
+    EXPECT_EQ(1, pub.keyVals_ref()->size());
+
+    auto prefixes = prefixManager->getPrefixes().get();
+    EXPECT_THAT(
+        *prefixes,
+        testing::UnorderedElementsAre(
+            prefixEntry3, prefixEntry5, prefixEntry1Bgp));
+    auto routes = getOriginatedRoutes();
+    ASSERT_EQ(1, routes.size());
+    EXPECT_EQ(prefixEntry1Bgp, *routes.at(0).route_ref());
+  }
+}
+
 /**
  * Validate PrefixManager does not advertise prefixes with prepend labels to
  * KvStore, until receiving from Fib that associated label routes are already
@@ -1083,7 +1303,6 @@ TEST_F(PrefixManagerTestFixture, PrefixUpdatesQueue) {
  *    labels in PrefixManager. Only prefixes with newly programmed label routes
  *    will be advertised.
  */
-
 TEST_F(PrefixManagerTestFixture, FibAckForPrefixesWithMultiLabels) {
   int scheduleAt{0};
   auto prefixDbMarker = Constants::kPrefixDbMarker.toString() + nodeId_;
@@ -1693,6 +1912,63 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteUpdates) {
   }
 }
 
+/**
+ * Test cross-AREA route redistribution skips routes which are unchanged since
+ * last Fib update, e.g. in full-table update after reconnect.
+ */
+TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteUnchangedUpdates) {
+  fb303::fbData->resetAllData();
+  const auto areaStrA{"A"};
+
+  auto path1_2_1 = createNextHop(
+      toBinaryAddress(folly::IPAddress("fe80::2")),
+      std::string("iface_1_2_1"),
+      1);
+  path1_2_1.area_ref() = areaStrA;
+
+  const auto unicast1A = RibUnicastEntry(
+      toIPNetwork(addr1), {path1_2_1}, prefixEntry1, areaStrA, false);
+  const auto unicast3A = RibUnicastEntry(
+      toIPNetwork(addr3), {path1_2_1}, prefixEntry3, areaStrA, false);
+
+  std::map<std::pair<std::string, std::string>, thrift::PrefixEntry> got,
+      gotDeleted;
+
+  // 1. Redistribute prefix1 into {B, C}
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.addRouteToUpdate(unicast1A);
+    fibRouteUpdatesQueue.push(std::move(routeUpdate));
+
+    readPublication(kvStoreWrapper->recvPublication(), got, gotDeleted);
+    readPublication(kvStoreWrapper->recvPublication(), got, gotDeleted);
+    EXPECT_EQ(2, got.size());
+    EXPECT_EQ(0, gotDeleted.size());
+  }
+
+  // 2. Full-table update with unchanged prefix1 and new prefix3. Only prefix3
+  // is redistributed.
+  {
+    got.clear();
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.addRouteToUpdate(unicast1A);
+    routeUpdate.addRouteToUpdate(unicast3A);
+    fibRouteUpdatesQueue.push(std::move(routeUpdate));
+
+    readPublication(kvStoreWrapper->recvPublication(), got, gotDeleted);
+    readPublication(kvStoreWrapper->recvPublication(), got, gotDeleted);
+    EXPECT_EQ(2, got.size());
+    for (const auto& [_, prefixEntry] : got) {
+      EXPECT_EQ(addr3, *prefixEntry.prefix_ref());
+    }
+    EXPECT_EQ(0, gotDeleted.size());
+
+    auto counters = fb303::fbData->getCounters();
+    EXPECT_EQ(2, counters.at("prefix_manager.redistribution_recomputed.sum"));
+    EXPECT_EQ(1, counters.at("prefix_manager.redistribution_skipped.sum"));
+  }
+}
+
 /**
  * Test cross-AREA route redistribution for Decision RIB routes with:
  *  - nexthop updates
@@ -1768,7 +2044,7 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
   // 2. add C into ecmp group, ecmp areas = [A, B, C], best area = A
   //    => C receive withdraw
   //
-  unicast1A.nexthops.emplace(path1_2_3);
+  unicast1A.nexthops = {path1_2_1, path1_2_2, path1_2_3};
   {
     DecisionRouteUpdate routeUpdate;
     routeUpdate.addRouteToUpdate(unicast1A);
@@ -1789,7 +2065,7 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
   // 3. withdraw B from ecmp group, ecmp areas = [A, C], best area = A
   //    => B receive update
   //
-  unicast1A.nexthops.erase(path1_2_2);
+  unicast1A.nexthops = {path1_2_1, path1_2_3};
   {
     DecisionRouteUpdate routeUpdate;
     routeUpdate.addRouteToUpdate(unicast1A);
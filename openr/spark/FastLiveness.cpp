@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/common/Constants.h>
+#include <openr/spark/FastLiveness.h>
+
+namespace fb303 = facebook::fb303;
+
+namespace {
+//
+// Magic and version identifying echo packet
+//
+const uint8_t kEchoMagic[2] = {0x4f, 0x46};
+const uint8_t kEchoVersion = 1;
+
+//
+// Size of echo packet header, before node name
+//
+const size_t kEchoHeaderSize = 11;
+
+//
+// The acceptable hop limit, assuming we send packets with this TTL
+//
+const int kHopLimit = 255;
+
+//
+// Max size of echo packet to receive
+//
+const int kMaxEchoPacketSize = kEchoHeaderSize + 255;
+} // namespace
+
+namespace openr {
+
+FastLiveness::FastLiveness(
+    std::string const& myNodeName,
+    uint16_t port,
+    std::chrono::milliseconds txInterval,
+    uint8_t detectMultiplier,
+    std::shared_ptr<IoProvider> ioProvider,
+    NeighborDownCallback neighborDownCb)
+    : myNodeName_(myNodeName),
+      port_(port),
+      txInterval_(txInterval),
+      detectMultiplier_(detectMultiplier),
+      ioProvider_(std::move(ioProvider)),
+      neighborDownCb_(std::move(neighborDownCb)) {
+  CHECK(txInterval_ > std::chrono::milliseconds(0))
+      << "Echo interval can't be 0";
+  CHECK(txInterval_ <= std::chrono::milliseconds(UINT16_MAX))
+      << "Echo interval can't exceed " << UINT16_MAX << "ms";
+  CHECK_GT(detectMultiplier_, 0) << "Detect multiplier can't be 0";
+  CHECK_LE(myNodeName_.size(), UINT8_MAX) << "Node name is too long";
+  CHECK(ioProvider_) << "Got null IoProvider";
+
+  prepareSocket();
+
+  txTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+    sendEchoPackets();
+    txTimer_->scheduleTimeout(txInterval_);
+  });
+  txTimer_->scheduleTimeout(txInterval_);
+
+  fb303::fbData->addStatExportType(
+      "spark.fast_liveness.echo_sent", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "spark.fast_liveness.echo_send_error", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "spark.fast_liveness.echo_recv", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "spark.fast_liveness.neighbor_down", fb303::SUM);
+}
+
+void
+FastLiveness::prepareSocket() {
+  mcastFd_ = ioProvider_->socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+  if (mcastFd_ < 0) {
+    XLOG(FATAL) << "Failed creating fast liveness UDP socket. Error: "
+                << folly::errnoStr(errno);
+  }
+
+  // make socket non-blocking
+  if (ioProvider_->fcntl(mcastFd_, F_SETFL, O_NONBLOCK) != 0) {
+    XLOG(FATAL) << "Failed making the socket non-blocking. Error: "
+                << folly::errnoStr(errno);
+  }
+
+  // make v6 only, and request input iface index and hop limit
+  const int enabled = 1;
+  for (auto const optname :
+       {IPV6_V6ONLY, IPV6_RECVPKTINFO, IPV6_RECVHOPLIMIT}) {
+    if (ioProvider_->setsockopt(
+            mcastFd_, IPPROTO_IPV6, optname, &enabled, sizeof(enabled)) != 0) {
+      XLOG(FATAL) << "Failed setting socket option " << optname
+                  << ". Error: " << folly::errnoStr(errno);
+    }
+  }
+
+  // bind the socket to receive any mcast packet
+  auto mcastSockAddr = folly::SocketAddress(folly::IPAddress("::"), port_);
+  sockaddr_storage addrStorage;
+  mcastSockAddr.getAddress(&addrStorage);
+  if (ioProvider_->bind(
+          mcastFd_,
+          reinterpret_cast<sockaddr*>(&addrStorage),
+          mcastSockAddr.getActualSize()) != 0) {
+    XLOG(FATAL) << "Failed binding the socket. Error: "
+                << folly::errnoStr(errno);
+  }
+
+  // set the TTL to maximum, so we can check for spoofed addresses
+  if (ioProvider_->setsockopt(
+          mcastFd_,
+          IPPROTO_IPV6,
+          IPV6_MULTICAST_HOPS,
+          &kHopLimit,
+          sizeof(kHopLimit)) != 0) {
+    XLOG(FATAL) << "Failed setting TTL on socket. Error: "
+                << folly::errnoStr(errno);
+  }
+
+  // disable looping packets to ourselves
+  const int loop = 0;
+  if (ioProvider_->setsockopt(
+          mcastFd_, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &loop, sizeof(loop)) !=
+      0) {
+    XLOG(FATAL) << "Failed disabling looping on socket. Error: "
+                << folly::errnoStr(errno);
+  }
+
+  addSocketFd(mcastFd_, ZMQ_POLLIN, [this](uint16_t) noexcept {
+    try {
+      processEchoPacket();
+    } catch (std::exception const& err) {
+      XLOG(ERR) << "FastLiveness: error processing echo packet "
+                << folly::exceptionStr(err);
+    }
+  });
+}
+
+void
+FastLiveness::toggleMcastGroup(int ifIndex, bool join) {
+  const folly::IPAddress mcastGroup(Constants::kSparkMcastAddr.toString());
+  struct ipv6_mreq mreq;
+  mreq.ipv6mr_interface = ifIndex;
+  ::memcpy(&mreq.ipv6mr_multiaddr, mcastGroup.bytes(), mcastGroup.byteCount());
+
+  if (ioProvider_->setsockopt(
+          mcastFd_,
+          IPPROTO_IPV6,
+          join ? IPV6_JOIN_GROUP : IPV6_LEAVE_GROUP,
+          &mreq,
+          sizeof(mreq)) != 0) {
+    XLOG(ERR) << "Failed " << (join ? "joining" : "leaving")
+              << " multicast group on ifIndex " << ifIndex << ". Error: "
+              << folly::errnoStr(errno);
+  }
+}
+
+void
+FastLiveness::addNeighbor(
+    std::string const& ifName,
+    int ifIndex,
+    folly::IPAddressV6 const& srcAddr,
+    std::string const& neighborName) {
+  runInEventBaseThread([this, ifName, ifIndex, srcAddr, neighborName]() {
+    auto [it, inserted] = interfaces_.try_emplace(ifName);
+    auto& interface = it->second;
+    if (not inserted and interface.ifIndex != ifIndex) {
+      toggleMcastGroup(interface.ifIndex, false /* leave */);
+    }
+    if (inserted or interface.ifIndex != ifIndex) {
+      toggleMcastGroup(ifIndex, true /* join */);
+    }
+    interface.ifIndex = ifIndex;
+    interface.srcAddr = srcAddr;
+
+    // (Re)start tracking neighbor. Session goes UP on first echo received.
+    interface.sessions[neighborName] = Session();
+    XLOG(DBG1) << "FastLiveness: tracking neighbor " << neighborName
+               << " on interface " << ifName;
+  });
+}
+
+void
+FastLiveness::removeNeighbor(
+    std::string const& ifName, std::string const& neighborName) {
+  runInEventBaseThread([this, ifName, neighborName]() {
+    removeNeighborImpl(ifName, neighborName);
+  });
+}
+
+void
+FastLiveness::removeNeighborImpl(
+    std::string const& ifName, std::string const& neighborName) {
+  auto it = interfaces_.find(ifName);
+  if (it == interfaces_.end() or
+      it->second.sessions.erase(neighborName) == 0) {
+    return;
+  }
+
+  XLOG(DBG1) << "FastLiveness: stopped tracking neighbor " << neighborName
+             << " on interface " << ifName;
+
+  if (it->second.sessions.empty()) {
+    toggleMcastGroup(it->second.ifIndex, false /* leave */);
+    interfaces_.erase(it);
+  }
+}
+
+folly::SemiFuture<size_t>
+FastLiveness::getNumUpSessions() {
+  folly::Promise<size_t> promise;
+  auto sf = promise.getSemiFuture();
+  runInEventBaseThread([this, p = std::move(promise)]() mutable {
+    size_t numUpSessions{0};
+    for (auto const& ifKv : interfaces_) {
+      for (auto const& sessionKv : ifKv.second.sessions) {
+        numUpSessions += sessionKv.second.isUp ? 1 : 0;
+      }
+    }
+    p.setValue(numUpSessions);
+  });
+  return sf;
+}
+
+void
+FastLiveness::sendEchoPackets() {
+  if (interfaces_.empty()) {
+    return;
+  }
+
+  EchoPacket echo;
+  echo.nodeName = myNodeName_;
+  echo.detectMultiplier = detectMultiplier_;
+  echo.txInterval = txInterval_;
+  echo.seqNum = mySeqNum_++;
+
+  // Same packet is sent out of all interfaces, in order of their names
+  auto packet = encodeEchoPacket(echo);
+  std::vector<IoProvider::SendMessageEntry> messages;
+  messages.reserve(interfaces_.size());
+  for (auto const& [_, interface] : interfaces_) {
+    messages.emplace_back(IoProvider::SendMessageEntry{
+        interface.ifIndex, interface.srcAddr, packet});
+  }
+
+  folly::SocketAddress dstAddr(
+      folly::IPAddress(Constants::kSparkMcastAddr.toString()), port_);
+  const auto errors = IoProvider::sendMessages(
+      mcastFd_, dstAddr, messages, ioProvider_.get());
+
+  // Failure on one interface doesn't hold back echo packets of the others
+  size_t numSent{0};
+  size_t i{0};
+  for (auto const& [ifName, _] : interfaces_) {
+    const auto error = errors.at(i++);
+    if (error == 0) {
+      ++numSent;
+      continue;
+    }
+    XLOG(DBG1) << "FastLiveness: failed sending echo packet on " << ifName
+               << ". Error: " << folly::errnoStr(error);
+    fb303::fbData->addStatValue(
+        "spark.fast_liveness.echo_send_error", 1, fb303::SUM);
+  }
+  if (numSent > 0) {
+    fb303::fbData->addStatValue(
+        "spark.fast_liveness.echo_sent", numSent, fb303::SUM);
+  }
+}
+
+void
+FastLiveness::processEchoPacket() {
+  uint8_t buf[kMaxEchoPacketSize];
+  auto const [bytesRead, ifIndex, clientAddr, hopLimit, _] =
+      IoProvider::recvMessage(
+          mcastFd_, buf, kMaxEchoPacketSize, ioProvider_.get());
+
+  if (hopLimit < kHopLimit) {
+    XLOG(DBG2) << "Rejecting echo packet from " << clientAddr.getAddressStr()
+               << " due to hop limit being " << hopLimit;
+    return;
+  }
+
+  auto echo = decodeEchoPacket(buf, bytesRead);
+  if (not echo.has_value()) {
+    XLOG(DBG2) << "Rejecting malformed echo packet from "
+               << clientAddr.getAddressStr();
+    return;
+  }
+
+  // Find tracked neighbor
+  auto ifIt = std::find_if(
+      interfaces_.begin(), interfaces_.end(), [ifIndex = ifIndex](auto& kv) {
+        return kv.second.ifIndex == ifIndex;
+      });
+  if (ifIt == interfaces_.end()) {
+    return;
+  }
+  auto sessionIt = ifIt->second.sessions.find(echo->nodeName);
+  if (sessionIt == ifIt->second.sessions.end()) {
+    return;
+  }
+
+  fb303::fbData->addStatValue("spark.fast_liveness.echo_recv", 1, fb303::SUM);
+
+  auto& session = sessionIt->second;
+  if (not session.isUp) {
+    XLOG(INFO) << "FastLiveness: session UP towards " << echo->nodeName
+               << " on interface " << ifIt->first;
+    session.isUp = true;
+    session.detectTimer = folly::AsyncTimeout::make(
+        *getEvb(),
+        [this, ifName = ifIt->first, neighborName = echo->nodeName]() noexcept {
+          XLOG(INFO) << "FastLiveness: detection time expired for "
+                     << neighborName << " on interface " << ifName;
+          fb303::fbData->addStatValue(
+              "spark.fast_liveness.neighbor_down", 1, fb303::SUM);
+          // NOTE: defer cleanup as it destroys the session and this timer
+          runInEventBaseThread([this, ifName, neighborName]() {
+            removeNeighborImpl(ifName, neighborName);
+            neighborDownCb_(ifName, neighborName);
+          });
+        });
+  }
+
+  // Restart detection timer with detection time advertised by neighbor
+  session.detectTimer->scheduleTimeout(
+      echo->txInterval * echo->detectMultiplier);
+}
+
+std::string
+FastLiveness::encodeEchoPacket(EchoPacket const& echo) {
+  CHECK_LE(echo.nodeName.size(), UINT8_MAX);
+  const uint16_t txIntervalMs = echo.txInterval.count();
+
+  std::string packet;
+  packet.reserve(kEchoHeaderSize + echo.nodeName.size());
+  packet.push_back(kEchoMagic[0]);
+  packet.push_back(kEchoMagic[1]);
+  packet.push_back(kEchoVersion);
+  packet.push_back(echo.detectMultiplier);
+  packet.push_back(static_cast<char>(txIntervalMs >> 8));
+  packet.push_back(static_cast<char>(txIntervalMs));
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    packet.push_back(static_cast<char>(echo.seqNum >> shift));
+  }
+  packet.push_back(static_cast<char>(echo.nodeName.size()));
+  packet.append(echo.nodeName);
+  return packet;
+}
+
+std::optional<FastLiveness::EchoPacket>
+FastLiveness::decodeEchoPacket(const uint8_t* buf, size_t len) {
+  if (len < kEchoHeaderSize or buf[0] != kEchoMagic[0] or
+      buf[1] != kEchoMagic[1] or buf[2] != kEchoVersion) {
+    return std::nullopt;
+  }
+
+  EchoPacket echo;
+  echo.detectMultiplier = buf[3];
+  echo.txInterval = std::chrono::milliseconds((buf[4] << 8) | buf[5]);
+  for (size_t i = 6; i < 10; ++i) {
+    echo.seqNum = (echo.seqNum << 8) | buf[i];
+  }
+  const size_t nameLen = buf[10];
+  if (len != kEchoHeaderSize + nameLen or nameLen == 0 or
+      echo.detectMultiplier == 0 or
+      echo.txInterval == std::chrono::milliseconds(0)) {
+    return std::nullopt;
+  }
+  echo.nodeName.assign(
+      reinterpret_cast<const char*>(buf + kEchoHeaderSize), nameLen);
+  return echo;
+}
+
+} // namespace openr
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <folly/IPAddressV6.h>
+#include <folly/futures/Future.h>
+#include <folly/io/async/AsyncTimeout.h>
+
+#include <openr/common/OpenrEventBase.h>
+#include <openr/spark/IoProvider.h>
+
+namespace openr {
+
+/*
+ * [Fast Liveness]
+ *
+ * BFD style liveness detection of Spark neighbors. It runs in its own thread,
+ * independent of Spark's hello/heartbeat processing, and exchanges compact
+ * binary echo packets with ESTABLISHED neighbors over a dedicated multicast
+ * socket:
+ *
+ *  - Echo packets are sent out on every interface with tracked neighbors
+ *    every `txInterval`;
+ *  - Each echo advertises sender's tx interval and detect multiplier. The
+ *    detection time of a neighbor is the product of them, same as BFD;
+ *  - Session towards a neighbor goes UP on receipt of first echo from it.
+ *    Neighbors not running fast liveness are never declared DOWN;
+ *  - If no echo is received from an UP neighbor within detection time, the
+ *    neighbor is removed from tracking and `neighborDownCb` is invoked from
+ *    this thread.
+ */
+class FastLiveness final : public OpenrEventBase {
+ public:
+  using NeighborDownCallback = std::function<void(
+      std::string const& ifName, std::string const& neighborName)>;
+
+  FastLiveness(
+      std::string const& myNodeName,
+      uint16_t port,
+      std::chrono::milliseconds txInterval,
+      uint8_t detectMultiplier,
+      std::shared_ptr<IoProvider> ioProvider,
+      NeighborDownCallback neighborDownCb);
+
+  ~FastLiveness() override = default;
+
+  /*
+   * [Public API]
+   *
+   * Start/stop tracking liveness of neighbor on interface. Thread-safe.
+   */
+  void addNeighbor(
+      std::string const& ifName,
+      int ifIndex,
+      folly::IPAddressV6 const& srcAddr,
+      std::string const& neighborName);
+
+  void removeNeighbor(
+      std::string const& ifName, std::string const& neighborName);
+
+  // Number of tracked neighbors with session UP
+  folly::SemiFuture<size_t> getNumUpSessions();
+
+  /*
+   * [Echo Packet]
+   *
+   *   0       2       3        4            6          10       11
+   *   +-------+-------+--------+------------+----------+--------+-----------+
+   *   | magic | ver   | detect | txInterval | seqNum   | name   | nodeName  |
+   *   |       |       | mult   | ms         |          | length |           |
+   *   +-------+-------+--------+------------+----------+--------+-----------+
+   *
+   * All multi-byte fields are in network byte order.
+   */
+  struct EchoPacket {
+    std::string nodeName;
+    uint8_t detectMultiplier{0};
+    std::chrono::milliseconds txInterval{0};
+    uint32_t seqNum{0};
+  };
+
+  static std::string encodeEchoPacket(EchoPacket const& echo);
+
+  // Returns std::nullopt if buffer doesn't contain a valid echo packet
+  static std::optional<EchoPacket> decodeEchoPacket(
+      const uint8_t* buf, size_t len);
+
+ private:
+  struct Session {
+    // Set on receipt of first echo from neighbor
+    bool isUp{false};
+
+    // Fires if no echo is received within detection time
+    std::unique_ptr<folly::AsyncTimeout> detectTimer{nullptr};
+  };
+
+  struct Interface {
+    int ifIndex{0};
+    folly::IPAddressV6 srcAddr;
+    std::unordered_map<std::string /* neighborName */, Session> sessions;
+  };
+
+  // Initializes UDP socket for echo packets
+  void prepareSocket();
+
+  // Join or leave multicast group on interface
+  void toggleMcastGroup(int ifIndex, bool join);
+
+  // Send echo packet on all interfaces with tracked neighbors
+  void sendEchoPackets();
+
+  // Receive and process echo packet
+  void processEchoPacket();
+
+  // Stop tracking neighbor, leaving multicast group if it is the last one
+  void removeNeighborImpl(
+      std::string const& ifName, std::string const& neighborName);
+
+  // This node's name
+  const std::string myNodeName_;
+
+  // UDP port for send/recv of echo packets
+  const uint16_t port_{0};
+
+  // Echo packet sendout interval
+  const std::chrono::milliseconds txInterval_{0};
+
+  // Number of missed echo packets to declare neighbor DOWN
+  const uint8_t detectMultiplier_{0};
+
+  // The IO primitives provider; this is used for mocking the IO during tests
+  std::shared_ptr<IoProvider> ioProvider_{nullptr};
+
+  // Invoked when a neighbor is detected DOWN
+  NeighborDownCallback neighborDownCb_;
+
+  // The multicast socket we use
+  int mcastFd_{-1};
+
+  // The next sequence number to be used for outgoing echo packets
+  uint32_t mySeqNum_{0};
+
+  // Tracked interfaces and neighbors keyed by ifName. Ordered, so echo
+  // packets go out in a stable order.
+  std::map<std::string /* ifName */, Interface> interfaces_;
+
+  // Timer to periodically send echo packets
+  std::unique_ptr<folly::AsyncTimeout> txTimer_{nullptr};
+};
+
+} // namespace openr
@@ -68,30 +68,48 @@ IoProvider::sendmsg(int sockfd, const struct msghdr* msg, int flags) {
   return ::sendmsg(sockfd, msg, flags);
 }
 
-std::tuple<
-    ssize_t /* size */,
-    int /* ifIndex */,
-    folly::SocketAddress /* srcAddr */,
-    int /* hopLimit */,
-    std::chrono::microseconds /* kernel timestamp */>
-IoProvider::recvMessage(
-    int fd, unsigned char* buf, int len, openr::IoProvider* ioProvider) {
-  // the control message buffer
-  // XXX: hardcoded, but this hardly should be a problem
-  union {
-    char ctrlBuf[CMSG_SPACE(1024)];
-    struct cmsghdr align;
-  } u;
+int
+IoProvider::recvmmsg(
+    int sockfd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags,
+    struct timespec* timeout) {
+  return ::recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+}
 
-  // the message header to receive into
-  struct msghdr msg;
+int
+IoProvider::sendmmsg(
+    int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  return ::sendmmsg(sockfd, msgvec, vlen, flags);
+}
 
-  // the IO vector for data to be received with recvmsg
-  struct iovec entry;
+namespace {
 
-  // for address of the sender
-  sockaddr_storage addrStorage;
+// the control message buffer
+// XXX: hardcoded, but this hardly should be a problem
+union RecvCtrlBuf {
+  char ctrlBuf[CMSG_SPACE(1024)];
+  struct cmsghdr align;
+};
 
+// pack control buffer, aligned by control message hdr
+union SendCtrlBuf {
+  char cbuf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+  struct cmsghdr align;
+};
+
+/*
+ * Prepare message header to receive a message into `buf`
+ */
+void
+prepareRecvMsgHdr(
+    struct msghdr& msg,
+    struct iovec& entry,
+    RecvCtrlBuf& u,
+    sockaddr_storage& addrStorage,
+    unsigned char* buf,
+    int len) {
   ::memset(&msg, 0, sizeof(msg));
 
   // we only expect to receive one block of data, single entry
@@ -116,14 +134,14 @@ IoProvider::recvMessage(
   // write the data here
   entry.iov_base = buf;
   entry.iov_len = len;
+}
 
-  ssize_t bytesRead = ioProvider->recvmsg(fd, &msg, MSG_DONTWAIT);
-
-  if (bytesRead < 0) {
-    throw std::runtime_error(fmt::format(
-        "Failed reading message on fd {}: {}", fd, folly::errnoStr(errno)));
-  }
-
+/*
+ * Extract interface index, hop limit, kernel timestamp and sender address of
+ * the message received with header prepared by `prepareRecvMsgHdr`
+ */
+IoProvider::RecvMessageResult
+parseRecvMsgHdr(struct msghdr& msg, ssize_t bytesRead) {
   if (msg.msg_flags & MSG_TRUNC) {
     throw std::runtime_error("Message truncated");
   }
@@ -178,7 +196,7 @@ IoProvider::recvMessage(
   // build the source socket address from recvmsg data
   folly::SocketAddress srcAddr{};
   // this will throw if sender address was not filled in
-  srcAddr.setFromSockaddr(reinterpret_cast<struct sockaddr*>(&addrStorage));
+  srcAddr.setFromSockaddr(reinterpret_cast<struct sockaddr*>(msg.msg_name));
 
   DCHECK(ifIndex != -1) << "ifIndex is not found";
   DCHECK(hopLimit) << "hopLimit is not found";
@@ -186,30 +204,25 @@ IoProvider::recvMessage(
   return std::make_tuple(bytesRead, ifIndex, srcAddr, hopLimit, recvTs);
 }
 
-ssize_t
-IoProvider::sendMessage(
-    int fd,
+/*
+ * Prepare message header to send `packet` via interface `ifIndex` with
+ * source address `srcAddr`
+ */
+void
+prepareSendMsgHdr(
+    struct msghdr& msg,
+    struct iovec& entry,
+    SendCtrlBuf& u,
+    sockaddr_storage& addrStorage,
+    socklen_t addrLen,
     int ifIndex,
-    folly::IPAddressV6 srcAddr,
-    folly::SocketAddress dstAddr,
-    std::string const& packet,
-    IoProvider* ioProvider) {
-  struct msghdr msg;
+    const folly::IPAddressV6& srcAddr,
+    std::string const& packet) {
   struct cmsghdr* cmsg{nullptr};
 
-  // pack control buffer, aligned by control message hdr
-  union {
-    char cbuf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
-    struct cmsghdr align;
-  } u;
-
-  // Set the destination address for the message
-  sockaddr_storage addrStorage;
-  dstAddr.getAddress(&addrStorage);
-
   ::memset(&msg, 0, sizeof(msg));
   msg.msg_name = reinterpret_cast<void*>(&addrStorage);
-  msg.msg_namelen = dstAddr.getActualSize();
+  msg.msg_namelen = addrLen;
 
   // set the source address and source if index for this message
   // this goes into ancilliary data fields
@@ -226,15 +239,165 @@ IoProvider::sendMessage(
   ::memcpy(&pktinfo->ipi6_addr, srcAddr.bytes(), srcAddr.byteCount());
 
   // the IO vector for data to be sent
-  struct iovec entry;
   msg.msg_iov = &entry;
   msg.msg_iovlen = 1;
 
   // write the data here (we need to remove the const qualifier)
   entry.iov_base = const_cast<char*>(packet.data());
   entry.iov_len = packet.size();
+}
+
+} // namespace
+
+IoProvider::RecvMessageResult
+IoProvider::recvMessage(
+    int fd, unsigned char* buf, int len, openr::IoProvider* ioProvider) {
+  RecvCtrlBuf u;
+
+  // the message header to receive into
+  struct msghdr msg;
+
+  // the IO vector for data to be received with recvmsg
+  struct iovec entry;
+
+  // for address of the sender
+  sockaddr_storage addrStorage;
+
+  prepareRecvMsgHdr(msg, entry, u, addrStorage, buf, len);
+
+  ssize_t bytesRead = ioProvider->recvmsg(fd, &msg, MSG_DONTWAIT);
+
+  if (bytesRead < 0) {
+    throw std::runtime_error(fmt::format(
+        "Failed reading message on fd {}: {}", fd, folly::errnoStr(errno)));
+  }
+
+  return parseRecvMsgHdr(msg, bytesRead);
+}
+
+std::vector<std::optional<IoProvider::RecvMessageResult>>
+IoProvider::recvMessages(
+    int fd,
+    unsigned char* buf,
+    int len,
+    size_t maxMessages,
+    openr::IoProvider* ioProvider) {
+  std::vector<RecvCtrlBuf> ctrlBufs(maxMessages);
+  std::vector<struct iovec> entries(maxMessages);
+  std::vector<sockaddr_storage> addrStorages(maxMessages);
+  std::vector<struct mmsghdr> msgs(maxMessages);
+
+  for (size_t i = 0; i < maxMessages; ++i) {
+    ::memset(&msgs[i], 0, sizeof(msgs[i]));
+    prepareRecvMsgHdr(
+        msgs[i].msg_hdr,
+        entries[i],
+        ctrlBufs[i],
+        addrStorages[i],
+        buf + i * len,
+        len);
+  }
+
+  std::vector<std::optional<RecvMessageResult>> results;
+  int numMsgs =
+      ioProvider->recvmmsg(fd, msgs.data(), maxMessages, MSG_DONTWAIT, nullptr);
+  if (numMsgs < 0) {
+    if (errno == EAGAIN or errno == EWOULDBLOCK) {
+      return results; // Nothing to read
+    }
+    throw std::runtime_error(fmt::format(
+        "Failed reading messages on fd {}: {}", fd, folly::errnoStr(errno)));
+  }
+
+  results.reserve(numMsgs);
+  for (int i = 0; i < numMsgs; ++i) {
+    // Drop only the bad message, rest of the batch is still good
+    try {
+      results.emplace_back(parseRecvMsgHdr(msgs[i].msg_hdr, msgs[i].msg_len));
+    } catch (std::exception const& err) {
+      XLOG(ERR) << "Dropping message received on fd " << fd << ": "
+                << folly::exceptionStr(err);
+      results.emplace_back(std::nullopt);
+    }
+  }
+  return results;
+}
+
+ssize_t
+IoProvider::sendMessage(
+    int fd,
+    int ifIndex,
+    folly::IPAddressV6 srcAddr,
+    folly::SocketAddress dstAddr,
+    std::string const& packet,
+    IoProvider* ioProvider) {
+  struct msghdr msg;
+  SendCtrlBuf u;
+
+  // Set the destination address for the message
+  sockaddr_storage addrStorage;
+  dstAddr.getAddress(&addrStorage);
+
+  // the IO vector for data to be sent
+  struct iovec entry;
+
+  prepareSendMsgHdr(
+      msg,
+      entry,
+      u,
+      addrStorage,
+      dstAddr.getActualSize(),
+      ifIndex,
+      srcAddr,
+      packet);
 
   return ioProvider->sendmsg(fd, &msg, MSG_DONTWAIT);
 }
 
+std::vector<int>
+IoProvider::sendMessages(
+    int fd,
+    folly::SocketAddress dstAddr,
+    std::vector<SendMessageEntry> const& messages,
+    IoProvider* ioProvider) {
+  // Set the destination address for all messages
+  sockaddr_storage addrStorage;
+  dstAddr.getAddress(&addrStorage);
+
+  const auto numMsgs = messages.size();
+  std::vector<SendCtrlBuf> ctrlBufs(numMsgs);
+  std::vector<struct iovec> entries(numMsgs);
+  std::vector<struct mmsghdr> msgs(numMsgs);
+
+  for (size_t i = 0; i < numMsgs; ++i) {
+    ::memset(&msgs[i], 0, sizeof(msgs[i]));
+    prepareSendMsgHdr(
+        msgs[i].msg_hdr,
+        entries[i],
+        ctrlBufs[i],
+        addrStorage,
+        dstAddr.getActualSize(),
+        messages[i].ifIndex,
+        messages[i].srcAddr,
+        messages[i].packet);
+  }
+
+  // Kernel may send fewer messages than requested per call, stopping at the
+  // first one failing. Skip the failed one and keep sending the rest.
+  std::vector<int> errors(numMsgs, 0);
+  size_t next{0};
+  while (next < numMsgs) {
+    int ret = ioProvider->sendmmsg(
+        fd, msgs.data() + next, numMsgs - next, MSG_DONTWAIT);
+    if (ret > 0) {
+      next += ret;
+      continue;
+    }
+    errors[next] = (ret < 0 and errno != 0) ? errno : EIO;
+    ++next;
+  }
+
+  return errors;
+}
+
 } // namespace openr
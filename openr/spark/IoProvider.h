@@ -13,6 +13,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <chrono>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include <folly/IPAddress.h>
 #include <folly/SocketAddress.h>
@@ -27,6 +31,22 @@ namespace openr {
 //
 class IoProvider {
  public:
+  // Size, interface index, source address, hop limit and kernel timestamp of
+  // a received message
+  using RecvMessageResult = std::tuple<
+      ssize_t /* size */,
+      int /* ifIndex */,
+      folly::SocketAddress /* srcAddr */,
+      int /* hopLimit */,
+      std::chrono::microseconds /* kernel timestamp */>;
+
+  // Message to be sent out of an interface
+  struct SendMessageEntry {
+    int ifIndex{0};
+    folly::IPAddressV6 srcAddr;
+    std::string packet;
+  };
+
   IoProvider() = default;
   virtual ~IoProvider(){};
 
@@ -60,6 +80,16 @@ class IoProvider {
 
   virtual ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags);
 
+  virtual int recvmmsg(
+      int sockfd,
+      struct mmsghdr* msgvec,
+      unsigned int vlen,
+      int flags,
+      struct timespec* timeout);
+
+  virtual int sendmmsg(
+      int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+
   virtual int setsockopt(
       int sockfd, int level, int optname, const void* optval, socklen_t optlen);
 
@@ -69,13 +99,22 @@ class IoProvider {
    * Receive a message on fd, and return its size, interface index,
    * and the source address
    */
-  static std::tuple<
-      ssize_t /* size */,
-      int /* ifIndex */,
-      folly::SocketAddress /* srcAddr */,
-      int /* hopLimit */,
-      std::chrono::microseconds /* kernel timestamp */>
-  recvMessage(int fd, unsigned char* buf, int len, IoProvider* ioProvider);
+  static RecvMessageResult recvMessage(
+      int fd, unsigned char* buf, int len, IoProvider* ioProvider);
+
+  /*
+   * Receive up to `maxMessages` messages on fd with a single `recvmmsg` call.
+   * `buf` must be of size `maxMessages * len`, and i-th message is received
+   * at offset `i * len`. Returns an empty vector if no message is pending.
+   * i-th result is std::nullopt if i-th message couldn't be parsed (e.g. it
+   * was truncated); such message is dropped without discarding the rest.
+   */
+  static std::vector<std::optional<RecvMessageResult>> recvMessages(
+      int fd,
+      unsigned char* buf,
+      int len,
+      size_t maxMessages,
+      IoProvider* ioProvider);
 
   /*
    * Send message on fd via given interface to the address provided
@@ -89,6 +128,18 @@ class IoProvider {
       std::string const& packet,
       IoProvider* ioProvider);
 
+  /*
+   * Send messages on fd, each via its own interface, to the address provided
+   * with as few `sendmmsg` calls as possible. A message failing to go out is
+   * skipped and the rest are still sent. Returns error code of every message,
+   * 0 if it was sent and errno otherwise.
+   */
+  static std::vector<int> sendMessages(
+      int fd,
+      folly::SocketAddress dstAddr,
+      std::vector<SendMessageEntry> const& messages,
+      IoProvider* ioProvider);
+
  private:
   IoProvider(IoProvider const&) = delete;
   IoProvider& operator=(IoProvider const&) = delete;
@@ -11,6 +11,7 @@
 #include <folly/futures/Future.h>
 #include <folly/futures/Promise.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/ThreadName.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/EventLogger.h>
@@ -39,6 +40,27 @@ const int kSparkHopLimit = 255;
 // number of restarting packets to send out per interface before I'm going down
 const int kNumRestartingPktSent = 3;
 
+// max number of packets to send/receive with single syscall in batched IO mode
+const size_t kMaxIoBatchSize = 64;
+
+// tick interval of timer wheel driving neighbor and interface timers. Timers
+// fire at most this late.
+const std::chrono::milliseconds kTimerWheelTick{10};
+
+//
+// Append compact protocol encoding of i64 value, i.e. varint of zigzag
+//
+void
+appendCompactI64(std::string& buf, int64_t value) {
+  uint64_t n =
+      (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  while (n >= 0x80) {
+    buf.push_back(static_cast<char>((n & 0x7f) | 0x80));
+    n >>= 7;
+  }
+  buf.push_back(static_cast<char>(n));
+}
+
 //
 // Function to get current timestamp in microseconds using steady clock
 // NOTE: we use non-monotonic clock since kernel time-stamps do not support
@@ -193,6 +215,45 @@ Spark::getNextState(
  * from neighbor discovery process. It manages neighbors and report the updates
  * to LinkMonitor.
  */
+std::optional<SparkPacketTemplate>
+SparkPacketTemplate::create(
+    std::string const& packet, size_t numVolatileFields, uint32_t key) {
+  std::string placeholder;
+  appendCompactI64(placeholder, kVolatileField);
+
+  SparkPacketTemplate packetTemplate;
+  packetTemplate.key_ = key;
+  size_t pos{0};
+  while (true) {
+    auto next = packet.find(placeholder, pos);
+    if (next == std::string::npos) {
+      break;
+    }
+    packetTemplate.chunks_.emplace_back(packet.substr(pos, next - pos));
+    pos = next + placeholder.size();
+  }
+  packetTemplate.chunks_.emplace_back(packet.substr(pos));
+
+  if (packetTemplate.chunks_.size() != numVolatileFields + 1) {
+    return std::nullopt;
+  }
+  return packetTemplate;
+}
+
+std::string
+SparkPacketTemplate::fill(std::vector<int64_t> const& values) const {
+  CHECK_EQ(chunks_.size(), values.size() + 1);
+
+  std::string packet;
+  auto chunkIt = chunks_.begin();
+  packet.append(*chunkIt++);
+  for (auto const value : values) {
+    appendCompactI64(packet, value);
+    packet.append(*chunkIt++);
+  }
+  return packet;
+}
+
 Spark::SparkNeighbor::SparkNeighbor(
     const thrift::StepDetectorConfig& stepDetectorConfig,
     std::string const& domainName,
@@ -326,6 +387,7 @@ Spark::Spark(
       v4OverV6Nexthop_(config->isV4OverV6NexthopEnabled()),
       enableFloodOptimization_(
           config->getKvStoreConfig().get_enable_flood_optimization()),
+      enableBatchedIo_(config->getSparkConfig().get_enable_batched_io()),
       neighborUpdatesQueue_(neighborUpdatesQueue),
       kOpenrCtrlThriftPort_(
           config->getThriftServerConfig().get_openr_ctrl_port()),
@@ -346,6 +408,9 @@ Spark::Spark(
       << "fastInit helloMsg interval must be smaller than normal interval";
   CHECK(ioProvider_) << "Got null IoProvider";
 
+  // Single timer wheel drives all neighbor and interface timers
+  timerWheel_ = std::make_unique<TimerWheel>(getEvb(), kTimerWheelTick);
+
   // Initialize list of BucketedTimeSeries
   const std::chrono::seconds sec{1};
   if (maybeMaxAllowedPps) {
@@ -422,6 +487,42 @@ Spark::Spark(
   // Initialize UDP socket for neighbor discovery
   prepareSocket();
 
+  // In batched IO mode, heartbeats for all interfaces are sent together with
+  // single timer instead of per interface timers
+  if (enableBatchedIo_) {
+    batchRecvBuf_.resize(kMaxIoBatchSize * kMinIpv6Mtu);
+    heartbeatTimer_ = timerWheel_->makeTimer([this]() noexcept {
+      sendHeartbeatMsgs();
+      heartbeatTimer_->scheduleTimeout(keepAliveTime_);
+    });
+    heartbeatTimer_->scheduleTimeout(keepAliveTime_);
+  }
+
+  // Start fast liveness engine in its own thread, so that detection of
+  // neighbor failures is independent of load on Spark thread
+  if (config_->getSparkConfig().get_enable_fast_liveness()) {
+    auto const& fastLivenessConfig =
+        config_->getSparkConfig().get_fast_liveness_config();
+    fastLiveness_ = std::make_unique<FastLiveness>(
+        myNodeName_,
+        static_cast<uint16_t>(fastLivenessConfig.get_port()),
+        std::chrono::milliseconds(fastLivenessConfig.get_tx_interval_ms()),
+        static_cast<uint8_t>(fastLivenessConfig.get_detect_multiplier()),
+        ioProvider_,
+        [this](std::string const& ifName, std::string const& neighborName) {
+          runInEventBaseThread([this, ifName, neighborName]() {
+            processFastLivenessTimeout(ifName, neighborName);
+          });
+        });
+    fastLivenessThread_ = std::make_unique<std::thread>([this]() {
+      XLOG(INFO) << "Starting fast liveness thread...";
+      folly::setThreadName("openr-fast-liveness");
+      fastLiveness_->run();
+      XLOG(INFO) << "Fast liveness thread got stopped.";
+    });
+    fastLiveness_->waitUntilRunning();
+  }
+
   // Initialize some stat keys
   fb303::fbData->addStatExportType(
       "spark.invalid_keepalive.different_domain", fb303::SUM);
@@ -436,6 +537,10 @@ Spark::Spark(
   fb303::fbData->addStatExportType(
       "slo.neighbor_discovery.time_ms", fb303::AVG);
   fb303::fbData->addStatExportType("slo.neighbor_restart.time_ms", fb303::AVG);
+  fb303::fbData->addStatExportType("spark.packet_recv_batch_size", fb303::AVG);
+  fb303::fbData->addStatExportType("spark.packet_send_batch_size", fb303::AVG);
+  fb303::fbData->addStatExportType(
+      "spark.fast_liveness.neighbor_down_ignored", fb303::SUM);
 }
 
 // static util function to transform state into str
@@ -461,6 +566,11 @@ void
 Spark::stop() {
   // NOTE: explicitly wait for msg to send out before going down
   floodRestartingMsg().get();
+  if (fastLiveness_) {
+    fastLiveness_->stop();
+    fastLiveness_->waitUntilStopped();
+    fastLivenessThread_->join();
+  }
   OpenrEventBase::stop();
   XLOG(DBG1) << "Spark Event Base stopped";
 }
@@ -580,7 +690,11 @@ Spark::prepareSocket() noexcept {
   // Listen for incoming messages on multicast FD
   addSocketFd(mcastFd_, ZMQ_POLLIN, [this](uint16_t) noexcept {
     try {
-      processPacket();
+      if (enableBatchedIo_) {
+        processPackets();
+      } else {
+        processPacket();
+      }
     } catch (std::exception const& err) {
       XLOG(ERR) << "Spark: error processing hello packet "
                 << folly::exceptionStr(err);
@@ -650,13 +764,20 @@ Spark::parsePacket(
   // the read buffer
   uint8_t buf[kMinIpv6Mtu];
 
-  ssize_t bytesRead;
-  int ifIndex;
-  folly::SocketAddress clientAddr;
-  int hopLimit;
-
-  std::tie(bytesRead, ifIndex, clientAddr, hopLimit, recvTime) =
+  auto const msg =
       IoProvider::recvMessage(mcastFd_, buf, kMinIpv6Mtu, ioProvider_.get());
+  recvTime = std::get<4>(msg);
+
+  return parseRecvdPacket(buf, msg, pkt, ifName);
+}
+
+bool
+Spark::parseRecvdPacket(
+    const uint8_t* buf,
+    IoProvider::RecvMessageResult const& msg,
+    thrift::SparkHelloPacket& pkt,
+    std::string& ifName) {
+  auto const& [bytesRead, ifIndex, clientAddr, hopLimit, _] = msg;
 
   if (hopLimit < kSparkHopLimit) {
     XLOG(ERR) << "Rejecting packet from " << clientAddr.getAddressStr()
@@ -970,21 +1091,7 @@ Spark::sendHeartbeatMsg(std::string const& ifName) {
   const auto ifIndex = interfaceEntry.ifIndex;
   const auto v6Addr = interfaceEntry.v6LinkLocalNetwork.first;
 
-  // build heartbeat msg
-  thrift::SparkHeartbeatMsg heartbeatMsg;
-  heartbeatMsg.nodeName_ref() = myNodeName_;
-  heartbeatMsg.seqNum_ref() = mySeqNum_;
-  heartbeatMsg.holdAdjacency_ref() = false;
-  if (enableOrderedAdjPublication_) {
-    // ATTN: notify peer to set special adjacency flag when node is still within
-    // initialization procedure
-    heartbeatMsg.holdAdjacency_ref() = (not initialized_);
-  }
-
-  thrift::SparkHelloPacket pkt;
-  pkt.heartbeatMsg_ref() = std::move(heartbeatMsg);
-
-  auto packet = writeThriftObjStr(pkt, serializer_);
+  auto packet = buildHeartbeatPacket();
 
   // send the pkt
   folly::SocketAddress dstAddr(
@@ -992,7 +1099,7 @@ Spark::sendHeartbeatMsg(std::string const& ifName) {
       neighborDiscoveryPort_);
 
   if (kMinIpv6Mtu < packet.size()) {
-    XLOG(ERR) << "Handshake packet is too big, can't send it out.";
+    XLOG(ERR) << "Heartbeat packet is too big, can't send it out.";
     return;
   }
 
@@ -1011,6 +1118,193 @@ Spark::sendHeartbeatMsg(std::string const& ifName) {
   fb303::fbData->addStatValue("spark.heartbeat.packet_sent", 1, fb303::SUM);
 }
 
+void
+Spark::sendHeartbeatMsgs() {
+  std::vector<IoProvider::SendMessageEntry> messages;
+  messages.reserve(ifNameToActiveNeighbors_.size());
+
+  for (const auto& [ifName, _] : ifNameToActiveNeighbors_) {
+    auto it = interfaceDb_.find(ifName);
+    if (it == interfaceDb_.end()) {
+      continue;
+    }
+
+    // increment seq# for every packet (even if it doesn't go out)
+    auto packet = buildHeartbeatPacket();
+    ++mySeqNum_;
+
+    if (kMinIpv6Mtu < packet.size()) {
+      XLOG(ERR) << "Heartbeat packet is too big, can't send it out.";
+      continue;
+    }
+
+    messages.emplace_back(IoProvider::SendMessageEntry{
+        it->second.ifIndex,
+        it->second.v6LinkLocalNetwork.first.asV6(),
+        std::move(packet)});
+  }
+
+  if (messages.empty()) {
+    return;
+  }
+
+  folly::SocketAddress dstAddr(
+      folly::IPAddress(Constants::kSparkMcastAddr.toString()),
+      neighborDiscoveryPort_);
+
+  const auto errors = IoProvider::sendMessages(
+      mcastFd_, dstAddr, messages, ioProvider_.get());
+
+  fb303::fbData->addStatValue(
+      "spark.packet_send_batch_size", messages.size(), fb303::AVG);
+
+  // update counters for number of pkts and total size of pkts sent. A failed
+  // message doesn't prevent rest of the batch from going out.
+  for (size_t i = 0; i < messages.size(); ++i) {
+    if (errors.at(i) != 0) {
+      XLOG(DBG1) << "Failed sending heartbeat packet via ifIndex "
+                 << messages.at(i).ifIndex << " to "
+                 << dstAddr.getAddressStr() << ". Failed due to error "
+                 << folly::errnoStr(errors.at(i));
+      fb303::fbData->addStatValue("spark.heartbeat.send_error", 1, fb303::SUM);
+      continue;
+    }
+    fb303::fbData->addStatValue(
+        "spark.heartbeat.bytes_sent", messages.at(i).packet.size(), fb303::SUM);
+    fb303::fbData->addStatValue("spark.heartbeat.packet_sent", 1, fb303::SUM);
+  }
+}
+
+std::string
+Spark::buildHeartbeatPacket() {
+  // ATTN: notify peer to set special adjacency flag when node is still within
+  // initialization procedure
+  const bool holdAdjacency = enableOrderedAdjPublication_ and not initialized_;
+
+  auto serialize = [&](int64_t seqNum) {
+    // build heartbeat msg
+    thrift::SparkHeartbeatMsg heartbeatMsg;
+    heartbeatMsg.nodeName_ref() = myNodeName_;
+    heartbeatMsg.seqNum_ref() = seqNum;
+    heartbeatMsg.holdAdjacency_ref() = holdAdjacency;
+
+    thrift::SparkHelloPacket pkt;
+    pkt.heartbeatMsg_ref() = std::move(heartbeatMsg);
+
+    return writeThriftObjStr(pkt, serializer_);
+  };
+
+  // seqNum is the only volatile field of heartbeat msg
+  if (not heartbeatPacketTemplate_.has_value() or
+      heartbeatPacketTemplate_->getKey() != holdAdjacency) {
+    fb303::fbData->addStatValue(
+        "spark.packet_template.cache_miss", 1, fb303::SUM);
+    heartbeatPacketTemplate_ = SparkPacketTemplate::create(
+        serialize(SparkPacketTemplate::kVolatileField), 1, holdAdjacency);
+    if (not heartbeatPacketTemplate_.has_value()) {
+      XLOG(WARNING) << "Failed building heartbeat packet template";
+      return serialize(mySeqNum_);
+    }
+  } else {
+    fb303::fbData->addStatValue(
+        "spark.packet_template.cache_hit", 1, fb303::SUM);
+  }
+
+  return heartbeatPacketTemplate_->fill({static_cast<int64_t>(mySeqNum_)});
+}
+
+std::string
+Spark::buildHelloPacket(
+    std::string const& ifName, bool inFastInitState, bool restarting) {
+  // Reflected neighbor infos are serialized in order of neighbor name
+  std::vector<std::pair<std::string const*, SparkNeighbor const*>> neighbors;
+  for (const auto& [neighborName, neighbor] : sparkNeighbors_.at(ifName)) {
+    neighbors.emplace_back(&neighborName, &neighbor);
+  }
+  std::sort(
+      neighbors.begin(), neighbors.end(), [](auto const& lhs, auto const& rhs) {
+        return *lhs.first < *rhs.first;
+      });
+
+  // Values of volatile fields in the order they are serialized, i.e. seqNum,
+  // then seqNum and timestamps of each reflected neighbor, then sentTsInUs
+  std::vector<int64_t> values;
+  values.reserve(3 * neighbors.size() + 2);
+  values.emplace_back(static_cast<int64_t>(mySeqNum_));
+  for (auto const& [neighborName, neighbor] : neighbors) {
+    values.emplace_back(static_cast<int64_t>(neighbor->seqNum));
+    values.emplace_back(neighbor->neighborTimestamp.count());
+    values.emplace_back(neighbor->localTimestamp.count());
+  }
+  values.emplace_back(getCurrentTimeInUs().count());
+
+  auto serialize = [&](bool asTemplate) {
+    auto value = [&](size_t idx) {
+      return asTemplate ? SparkPacketTemplate::kVolatileField : values.at(idx);
+    };
+
+    // build the helloMsg from scratch
+    thrift::SparkHelloMsg helloMsg;
+    helloMsg.domainName_ref() = myDomainName_;
+    helloMsg.nodeName_ref() = myNodeName_;
+    helloMsg.ifName_ref() = ifName;
+    helloMsg.seqNum_ref() = value(0);
+    helloMsg.neighborInfos_ref() =
+        std::map<std::string, thrift::ReflectedNeighborInfo>{};
+    helloMsg.version_ref() = *kVersion_.version_ref();
+    helloMsg.solicitResponse_ref() = inFastInitState;
+    helloMsg.restarting_ref() = restarting;
+    helloMsg.sentTsInUs_ref() = value(values.size() - 1);
+
+    // bake neighborInfo into helloMsg
+    size_t idx{1};
+    for (auto const& [neighborName, neighbor] : neighbors) {
+      auto& neighborInfo = helloMsg.neighborInfos_ref()[*neighborName];
+      neighborInfo.seqNum_ref() = value(idx++);
+      neighborInfo.lastNbrMsgSentTsInUs_ref() = value(idx++);
+      neighborInfo.lastMyMsgRcvdTsInUs_ref() = value(idx++);
+    }
+
+    // fill in helloMsg field
+    thrift::SparkHelloPacket helloPacket;
+    helloPacket.helloMsg_ref() = std::move(helloMsg);
+
+    return writeThriftObjStr(helloPacket, serializer_);
+  };
+
+  // seqNum, sentTsInUs and reflected neighbor infos are the volatile fields of
+  // hello msg. Set of reflected neighbors changes only when neighbor is added
+  // or removed, upon which template is invalidated.
+  const uint32_t key = (inFastInitState ? 1 : 0) | (restarting ? 2 : 0);
+  auto it = ifNameToHelloPacketTemplates_.find(ifName);
+  if (it == ifNameToHelloPacketTemplates_.end() or
+      it->second.getKey() != key or
+      it->second.getNumVolatileFields() != values.size()) {
+    fb303::fbData->addStatValue(
+        "spark.packet_template.cache_miss", 1, fb303::SUM);
+    auto packetTemplate =
+        SparkPacketTemplate::create(serialize(true), values.size(), key);
+    if (not packetTemplate.has_value()) {
+      XLOG(WARNING) << "Failed building hello packet template for " << ifName;
+      ifNameToHelloPacketTemplates_.erase(ifName);
+      return serialize(false);
+    }
+    it = ifNameToHelloPacketTemplates_
+             .insert_or_assign(ifName, std::move(packetTemplate).value())
+             .first;
+  } else {
+    fb303::fbData->addStatValue(
+        "spark.packet_template.cache_hit", 1, fb303::SUM);
+  }
+
+  return it->second.fill(values);
+}
+
+void
+Spark::invalidateHelloPacketTemplate(std::string const& ifName) {
+  ifNameToHelloPacketTemplates_.erase(ifName);
+}
+
 void
 Spark::logStateTransition(
     std::string const& neighborName,
@@ -1152,8 +1446,8 @@ Spark::neighborUpWrapper(
   neighbor.negotiateHoldTimer.reset();
 
   // create heartbeat hold timer when promote to "ESTABLISHED"
-  neighbor.heartbeatHoldTimer = folly::AsyncTimeout::make(
-      *getEvb(), [this, ifName, neighborName]() noexcept {
+  neighbor.heartbeatHoldTimer = timerWheel_->makeTimer(
+      [this, ifName, neighborName]() noexcept {
         processHeartbeatTimeout(ifName, neighborName);
       });
   neighbor.heartbeatHoldTimer->scheduleTimeout(neighbor.heartbeatHoldTime);
@@ -1161,6 +1455,9 @@ Spark::neighborUpWrapper(
   // add neighborName to collection
   ifNameToActiveNeighbors_[ifName].emplace(neighborName);
 
+  // start fast liveness detection towards neighbor
+  addFastLivenessNeighbor(ifName, neighborName);
+
   // notify LinkMonitor about neighbor UP state
   if (enableOrderedAdjPublication_) {
     // ATTN: expect adjacency attribute to be removed later with heartbeatMsg
@@ -1183,6 +1480,9 @@ Spark::neighborDownWrapper(
   notifySparkNeighborEvent(
       NeighborEventType::NEIGHBOR_DOWN, neighbor.toThrift());
 
+  // stop fast liveness detection towards neighbor
+  removeFastLivenessNeighbor(ifName, neighborName);
+
   // remove neighborship on this interface
   if (ifNameToActiveNeighbors_.find(ifName) == ifNameToActiveNeighbors_.end()) {
     XLOG(WARNING) << "Ignore " << ifName << " as there is NO active neighbors.";
@@ -1218,6 +1518,7 @@ Spark::processHeartbeatTimeout(
   SCOPE_EXIT {
     allocatedLabels_.erase(neighbor.label);
     ifNeighbors.erase(neighborName);
+    invalidateHelloPacketTemplate(ifName);
   };
 
   XLOG(INFO) << "Heartbeat timer expired for: " << neighborName
@@ -1236,6 +1537,51 @@ Spark::processHeartbeatTimeout(
   neighborDownWrapper(neighbor, ifName, neighborName);
 }
 
+void
+Spark::processFastLivenessTimeout(
+    std::string const& ifName, std::string const& neighborName) {
+  // neighbor might have gone DOWN or RESTART while event was in flight
+  auto ifIt = sparkNeighbors_.find(ifName);
+  if (ifIt == sparkNeighbors_.end() or
+      ifIt->second.count(neighborName) == 0 or
+      ifIt->second.at(neighborName).state != SparkNeighState::ESTABLISHED) {
+    XLOG(INFO) << "Ignoring fast liveness timeout for " << neighborName
+               << " on interface " << ifName << " as it is not ESTABLISHED";
+    fb303::fbData->addStatValue(
+        "spark.fast_liveness.neighbor_down_ignored", 1, fb303::SUM);
+    return;
+  }
+
+  XLOG(INFO) << "Fast liveness detected failure of: " << neighborName
+             << " on interface " << ifName;
+
+  // same as if heartbeat hold timer expired
+  processHeartbeatTimeout(ifName, neighborName);
+}
+
+void
+Spark::addFastLivenessNeighbor(
+    std::string const& ifName, std::string const& neighborName) {
+  if (not fastLiveness_) {
+    return;
+  }
+  auto const& interface = interfaceDb_.at(ifName);
+  fastLiveness_->addNeighbor(
+      ifName,
+      interface.ifIndex,
+      interface.v6LinkLocalNetwork.first.asV6(),
+      neighborName);
+}
+
+void
+Spark::removeFastLivenessNeighbor(
+    std::string const& ifName, std::string const& neighborName) {
+  if (not fastLiveness_) {
+    return;
+  }
+  fastLiveness_->removeNeighbor(ifName, neighborName);
+}
+
 void
 Spark::processNegotiateTimeout(
     std::string const& ifName, std::string const& neighborName) {
@@ -1270,6 +1616,7 @@ Spark::processGRTimeout(
   SCOPE_EXIT {
     allocatedLabels_.erase(neighbor.label);
     ifNeighbors.erase(neighborName);
+    invalidateHelloPacketTemplate(ifName);
   };
 
   XLOG(INFO) << "Graceful restart timer expired for: " << neighborName
@@ -1297,8 +1644,8 @@ Spark::processGRMsg(
       NeighborEventType::NEIGHBOR_RESTARTING, neighbor.toThrift());
 
   // start graceful-restart timer
-  neighbor.gracefulRestartHoldTimer = folly::AsyncTimeout::make(
-      *getEvb(), [this, ifName, neighborName]() noexcept {
+  neighbor.gracefulRestartHoldTimer = timerWheel_->makeTimer(
+      [this, ifName, neighborName]() noexcept {
         // change the state back to IDLE
         processGRTimeout(ifName, neighborName);
       });
@@ -1312,6 +1659,9 @@ Spark::processGRMsg(
 
   // neihbor is restarting, shutdown heartbeat hold timer
   neighbor.heartbeatHoldTimer.reset();
+
+  // neighbor stops sending echo packets while restarting
+  removeFastLivenessNeighbor(ifName, neighborName);
 }
 
 void
@@ -1384,6 +1734,7 @@ Spark::processHelloMsg(
 
     auto& neighbor = ifNeighbors.at(neighborName);
     checkNeighborState(neighbor, SparkNeighState::IDLE);
+    invalidateHelloPacketTemplate(ifName);
   }
 
   // Up till now, node knows about this neighbor and perform SM check
@@ -1454,8 +1805,8 @@ Spark::processHelloMsg(
 
     // Starts timer to periodically send hankshake msg
     const std::string neighborAreaId = neighbor.area;
-    neighbor.negotiateTimer = folly::AsyncTimeout::make(
-        *getEvb(), [this, ifName, neighborName, neighborAreaId]() noexcept {
+    neighbor.negotiateTimer = timerWheel_->makeTimer(
+        [this, ifName, neighborName, neighborAreaId]() noexcept {
           sendHandshakeMsg(ifName, neighborName, neighborAreaId, false);
           // send out handshake msg periodically to this neighbor
           CHECK(sparkNeighbors_.count(ifName) > 0)
@@ -1470,8 +1821,8 @@ Spark::processHelloMsg(
     neighbor.negotiateTimer->scheduleTimeout(handshakeTime_);
 
     // Starts negotiate hold-timer
-    neighbor.negotiateHoldTimer = folly::AsyncTimeout::make(
-        *getEvb(), [this, ifName, neighborName]() noexcept {
+    neighbor.negotiateHoldTimer = timerWheel_->makeTimer(
+        [this, ifName, neighborName]() noexcept {
           // prevent to stucking in NEGOTIATE forever
           processNegotiateTimeout(ifName, neighborName);
         });
@@ -1510,6 +1861,7 @@ Spark::processHelloMsg(
       // remove from tracked neighbor at the end
       allocatedLabels_.erase(neighbor.label);
       ifNeighbors.erase(neighborName);
+      invalidateHelloPacketTemplate(ifName);
     }
   } else if (neighbor.state == SparkNeighState::RESTART) {
     // Neighbor is undergoing restart. Will reply immediately for hello msg for
@@ -1540,8 +1892,8 @@ Spark::processHelloMsg(
         NeighborEventType::NEIGHBOR_RESTARTED, neighbor.toThrift());
 
     // start heartbeat timer again to make sure neighbor is alive
-    neighbor.heartbeatHoldTimer = folly::AsyncTimeout::make(
-        *getEvb(), [this, ifName, neighborName]() noexcept {
+    neighbor.heartbeatHoldTimer = timerWheel_->makeTimer(
+        [this, ifName, neighborName]() noexcept {
           processHeartbeatTimeout(ifName, neighborName);
         });
     neighbor.heartbeatHoldTimer->scheduleTimeout(neighbor.heartbeatHoldTime);
@@ -1549,6 +1901,9 @@ Spark::processHelloMsg(
     // stop the graceful-restart hold-timer
     neighbor.gracefulRestartHoldTimer.reset();
 
+    // resume fast liveness detection towards neighbor
+    addFastLivenessNeighbor(ifName, neighborName);
+
     SparkNeighState oldState = neighbor.state;
     neighbor.state = getNextState(oldState, SparkNeighEvent::HELLO_RCVD_INFO);
     logStateTransition(neighborName, ifName, oldState, neighbor.state);
@@ -1786,6 +2141,59 @@ Spark::processPacket() {
     return;
   }
 
+  processHelloPacket(helloPacket, ifName, myRecvTime);
+}
+
+void
+Spark::processPackets() {
+  // drain the socket, upto `kMaxIoBatchSize` packets at once
+  auto msgs = IoProvider::recvMessages(
+      mcastFd_,
+      batchRecvBuf_.data(),
+      kMinIpv6Mtu,
+      kMaxIoBatchSize,
+      ioProvider_.get());
+  if (msgs.empty()) {
+    return;
+  }
+
+  fb303::fbData->addStatValue(
+      "spark.packet_recv_batch_size", msgs.size(), fb303::AVG);
+
+  for (size_t i = 0; i < msgs.size(); ++i) {
+    // skip message dropped by IoProvider, its buffer slot is left unused
+    if (not msgs[i].has_value()) {
+      continue;
+    }
+
+    // receive and parse pkt. Errors are handled per packet to not discard
+    // rest of the batch
+    try {
+      thrift::SparkHelloPacket helloPacket;
+      std::string ifName;
+      if (!parseRecvdPacket(
+              &batchRecvBuf_[i * kMinIpv6Mtu],
+              *msgs[i],
+              helloPacket,
+              ifName)) {
+        continue;
+      }
+      processHelloPacket(helloPacket, ifName, std::get<4>(*msgs[i]));
+    } catch (std::exception const& err) {
+      XLOG(ERR) << "Spark: error processing hello packet "
+                << folly::exceptionStr(err);
+      if (isThrowParserErrorsOn_) {
+        throw;
+      }
+    }
+  }
+}
+
+void
+Spark::processHelloPacket(
+    thrift::SparkHelloPacket const& helloPacket,
+    std::string const& ifName,
+    std::chrono::microseconds const& myRecvTime) {
   // Spark specific msg processing
   if (helloPacket.helloMsg_ref().has_value()) {
     processHelloMsg(helloPacket.helloMsg_ref().value(), ifName, myRecvTime);
@@ -1820,41 +2228,10 @@ Spark::sendHelloMsg(
   // down event has not arrived yet
   const auto& interfaceEntry = interfaceDb_.at(ifName);
   const auto ifIndex = interfaceEntry.ifIndex;
-  const auto v4Addr = interfaceEntry.v4Network.first;
   const auto v6Addr = interfaceEntry.v6LinkLocalNetwork.first;
-  thrift::OpenrVersion openrVer(*kVersion_.version_ref());
-
-  // build the helloMsg from scratch
-  thrift::SparkHelloMsg helloMsg;
-  helloMsg.domainName_ref() = myDomainName_;
-  helloMsg.nodeName_ref() = myNodeName_;
-  helloMsg.ifName_ref() = ifName;
-  helloMsg.seqNum_ref() = mySeqNum_;
-  helloMsg.neighborInfos_ref() =
-      std::map<std::string, thrift::ReflectedNeighborInfo>{};
-  helloMsg.version_ref() = openrVer;
-  helloMsg.solicitResponse_ref() = inFastInitState;
-  helloMsg.restarting_ref() = restarting;
-  helloMsg.sentTsInUs_ref() = getCurrentTimeInUs().count();
-
-  // bake neighborInfo into helloMsg
-  for (const auto& kv : sparkNeighbors_.at(ifName)) {
-    auto const& neighborName = kv.first;
-    auto const& neighbor = kv.second;
-
-    auto& neighborInfo = helloMsg.neighborInfos_ref()[neighborName];
-    neighborInfo.seqNum_ref() = neighbor.seqNum;
-    neighborInfo.lastNbrMsgSentTsInUs_ref() =
-        neighbor.neighborTimestamp.count();
-    neighborInfo.lastMyMsgRcvdTsInUs_ref() = neighbor.localTimestamp.count();
-  }
-
-  // fill in helloMsg field
-  thrift::SparkHelloPacket helloPacket;
-  helloPacket.helloMsg_ref() = std::move(helloMsg);
 
   // send the payload
-  auto packet = writeThriftObjStr(helloPacket, serializer_);
+  auto packet = buildHelloPacket(ifName, inFastInitState, restarting);
   folly::SocketAddress dstAddr(
       folly::IPAddress(Constants::kSparkMcastAddr.toString()),
       neighborDiscoveryPort_);
@@ -1902,8 +2279,12 @@ Spark::processInitializationEvent(thrift::InitializationEvent&& event) {
   // force to send SparkHeartbeatMsg immediately to notify peers.
   // NOTE: it is ok for this pkt to be lost as we will continuously send it as
   // the name suggests.
-  for (const auto& [ifName, _] : interfaceDb_) {
-    sendHeartbeatMsg(ifName);
+  if (enableBatchedIo_) {
+    sendHeartbeatMsgs();
+  } else {
+    for (const auto& [ifName, _] : interfaceDb_) {
+      sendHeartbeatMsg(ifName);
+    }
   }
 
   // logging for initialization stage duration computation
@@ -2026,6 +2407,7 @@ Spark::deleteInterface(const std::vector<std::string>& toDel) {
     }
     // cleanup for this interface
     ifNameToHelloTimers_.erase(ifName);
+    invalidateHelloPacketTemplate(ifName);
     interfaceDb_.erase(ifName);
   }
 }
@@ -2063,15 +2445,16 @@ Spark::addInterface(
       auto result = sparkNeighbors_.emplace(
           ifName, std::unordered_map<std::string, SparkNeighbor>{});
       CHECK(result.second);
+    }
 
-      // heartbeatTimers will start as soon as intf is in UP state
-      auto heartbeatTimer =
-          folly::AsyncTimeout::make(*getEvb(), [this, ifName]() noexcept {
-            sendHeartbeatMsg(ifName);
-            // schedule heartbeatTimers periodically as soon as intf is UP
-            ifNameToHeartbeatTimers_.at(ifName)->scheduleTimeout(
-                keepAliveTime_);
-          });
+    // heartbeatTimers will start as soon as intf is in UP state. In batched
+    // IO mode, heartbeats are sent for all interfaces by single timer instead.
+    if (not enableBatchedIo_) {
+      auto heartbeatTimer = timerWheel_->makeTimer([this, ifName]() noexcept {
+        sendHeartbeatMsg(ifName);
+        // schedule heartbeatTimers periodically as soon as intf is UP
+        ifNameToHeartbeatTimers_.at(ifName)->scheduleTimeout(keepAliveTime_);
+      });
 
       ifNameToHeartbeatTimers_.emplace(ifName, std::move(heartbeatTimer));
       ifNameToHeartbeatTimers_.at(ifName)->scheduleTimeout(keepAliveTime_);
@@ -2095,8 +2478,7 @@ Spark::addInterface(
     // this is due to the fact that it may not have yet configured a link-local
     // address. The hello packet will be sent later and will have good chances
     // of making it out if small delay is introduced.
-    auto helloTimer = folly::AsyncTimeout::make(
-        *getEvb(),
+    auto helloTimer = timerWheel_->makeTimer(
         [this, ifName, timePoint, roll, rollFast]() mutable noexcept {
           XLOG(DBG3) << "Sending hello multicast packet on interface "
                      << ifName;
@@ -2259,7 +2641,9 @@ Spark::updateGlobalCounters() {
       "spark.tracked_adjacent_neighbors_diff",
       trackedNeighborCount - adjacentNeighborCount);
   fb303::fbData->setCounter("spark.my_seq_num", mySeqNum_);
-  fb303::fbData->setCounter("spark.pending_timers", getEvb()->timer().count());
+  fb303::fbData->setCounter(
+      "spark.pending_timers",
+      getEvb()->timer().count() + timerWheel_->getNumScheduled());
 }
 
 // This is a static function
@@ -16,11 +16,13 @@
 #include <openr/common/Constants.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/common/StepDetector.h>
+#include <openr/common/TimerWheel.h>
 #include <openr/common/Types.h>
 #include <openr/config/Config.h>
 #include <openr/if/gen-cpp2/OpenrConfig_types.h>
 #include <openr/if/gen-cpp2/Types_types.h>
 #include <openr/messaging/ReplicateQueue.h>
+#include <openr/spark/FastLiveness.h>
 #include <openr/spark/IoProvider.h>
 
 namespace openr {
@@ -66,6 +68,49 @@ enum class SparkNeighEvent {
   NEGOTIATION_FAILURE = 8,
 };
 
+/*
+ * [Packet Template]
+ *
+ * Serialized SparkHelloPacket split around its volatile i64 fields, e.g.
+ * seqNum and timestamps. Packet is built by interleaving the static chunks
+ * with compact protocol (zigzag varint) encoding of volatile field values,
+ * instead of re-building and re-serializing the whole thrift object.
+ *
+ * Template is created from a packet serialized with `kVolatileField` as value
+ * of all volatile fields. Values must be provided in the order fields are
+ * serialized, i.e. field id order.
+ */
+class SparkPacketTemplate {
+ public:
+  // Placeholder value for volatile fields. Its encoding can't appear in
+  // string fields as it is not valid UTF-8.
+  static constexpr int64_t kVolatileField =
+      std::numeric_limits<int64_t>::min();
+
+  // Returns std::nullopt if number of placeholders in `packet` doesn't match
+  // `numVolatileFields`
+  static std::optional<SparkPacketTemplate> create(
+      std::string const& packet, size_t numVolatileFields, uint32_t key = 0);
+
+  // Build packet with given values of volatile fields
+  std::string fill(std::vector<int64_t> const& values) const;
+
+  size_t
+  getNumVolatileFields() const {
+    return chunks_.size() - 1;
+  }
+
+  // Key identifying non-volatile content (e.g. flags) template is built with
+  uint32_t
+  getKey() const {
+    return key_;
+  }
+
+ private:
+  std::vector<std::string> chunks_;
+  uint32_t key_{0};
+};
+
 /*
  * Spark is responsible of telling our peer of our existence and also tracking
  * the neighbor liveness.  It receives commands in form of "interface", on which
@@ -165,6 +210,16 @@ class Spark final : public OpenrEventBase {
   // the neighbor could be added as adjacent peer.
   void processPacket();
 
+  // batched IO variant of `processPacket()`. Drains multiple packets from
+  // socket with single syscall and processes them one by one.
+  void processPackets();
+
+  // dispatch received packet to hello/heartbeat/handshake msg processing
+  void processHelloPacket(
+      thrift::SparkHelloPacket const& helloPacket,
+      std::string const& ifName,
+      std::chrono::microseconds const& myRecvTime);
+
   // process helloMsg in Spark context
   void processHelloMsg(
       thrift::SparkHelloMsg const& helloMsg,
@@ -195,6 +250,21 @@ class Spark final : public OpenrEventBase {
   // util call to send heartbeat msg
   void sendHeartbeatMsg(std::string const& ifName);
 
+  // util call to send heartbeat msg on all interfaces with active neighbors
+  // with as few syscalls as possible. Used in batched IO mode.
+  void sendHeartbeatMsgs();
+
+  // util call to build serialized heartbeat packet with current seq#
+  std::string buildHeartbeatPacket();
+
+  // util call to build serialized hello packet with current seq# and time
+  std::string buildHelloPacket(
+      std::string const& ifName, bool inFastInitState, bool restarting);
+
+  // util call to drop cached hello packet of interface. Must be called when
+  // a neighbor reflected in hello packet is added or removed.
+  void invalidateHelloPacketTemplate(std::string const& ifName);
+
   /*
    * [Interface Update/Initialization Event Management]
    *
@@ -266,6 +336,13 @@ class Spark final : public OpenrEventBase {
       std::string& ifName /* interface */,
       std::chrono::microseconds& recvTime /* kernel timestamp when recved */);
 
+  // function to validate and parse pkt already received in `buf`
+  bool parseRecvdPacket(
+      const uint8_t* buf,
+      IoProvider::RecvMessageResult const& msg,
+      thrift::SparkHelloPacket& pkt,
+      std::string& ifName);
+
   // function to validate v4Address with its subnet
   PacketValidationResult validateV4AddressSubnet(
       std::string const& ifName, thrift::BinaryAddress neighV4Addr);
@@ -326,16 +403,16 @@ class Spark final : public OpenrEventBase {
     SparkNeighState state{SparkNeighState::IDLE};
 
     // timer to periodically send out handshake pkt
-    std::unique_ptr<folly::AsyncTimeout> negotiateTimer{nullptr};
+    std::unique_ptr<TimerWheel::Timer> negotiateTimer{nullptr};
 
     // negotiate stage hold-timer
-    std::unique_ptr<folly::AsyncTimeout> negotiateHoldTimer{nullptr};
+    std::unique_ptr<TimerWheel::Timer> negotiateHoldTimer{nullptr};
 
     // heartbeat hold-timer
-    std::unique_ptr<folly::AsyncTimeout> heartbeatHoldTimer{nullptr};
+    std::unique_ptr<TimerWheel::Timer> heartbeatHoldTimer{nullptr};
 
     // graceful restart hold-timer
-    std::unique_ptr<folly::AsyncTimeout> gracefulRestartHoldTimer{nullptr};
+    std::unique_ptr<TimerWheel::Timer> gracefulRestartHoldTimer{nullptr};
 
     // KvStore related port. Info passed to LinkMonitor for neighborEvent
     int32_t kvStoreCmdPort{0};
@@ -427,6 +504,18 @@ class Spark final : public OpenrEventBase {
   void processHeartbeatTimeout(
       std::string const& ifName, std::string const& neighborName);
 
+  // process neighbor DOWN detected by fast liveness engine
+  void processFastLivenessTimeout(
+      std::string const& ifName, std::string const& neighborName);
+
+  // start tracking ESTABLISHED neighbor with fast liveness engine, if enabled
+  void addFastLivenessNeighbor(
+      std::string const& ifName, std::string const& neighborName);
+
+  // stop tracking neighbor with fast liveness engine, if enabled
+  void removeFastLivenessNeighbor(
+      std::string const& ifName, std::string const& neighborName);
+
   // process timeout for negotiate stage
   void processNegotiateTimeout(
       std::string const& ifName, std::string const& neighborName);
@@ -490,6 +579,10 @@ class Spark final : public OpenrEventBase {
   // This flag indicates that if DUAL flood-optimization is supported or NOT
   const bool enableFloodOptimization_{false};
 
+  // This flag indicates that packets are sent/received in batches with
+  // sendmmsg/recvmmsg instead of one syscall per packet
+  const bool enableBatchedIo_{false};
+
   // the next sequence number to be used on any interface for outgoing hellos
   // NOTE: we increment this on hello sent out of any interfaces
   uint64_t mySeqNum_{1};
@@ -510,6 +603,10 @@ class Spark final : public OpenrEventBase {
   // current version and supported version
   const thrift::OpenrVersions kVersion_;
 
+  // Drives all neighbor and interface timers with O(1) arm and cancel.
+  // NOTE: must be declared before the timers it drives
+  std::unique_ptr<TimerWheel> timerWheel_{nullptr};
+
   // Map of interface entries keyed by ifName
   std::unordered_map<std::string, Interface> interfaceDb_{};
 
@@ -521,15 +618,33 @@ class Spark final : public OpenrEventBase {
   // Hello packet send timers for each interface
   std::unordered_map<
       std::string /* ifName */,
-      std::unique_ptr<folly::AsyncTimeout>>
+      std::unique_ptr<TimerWheel::Timer>>
       ifNameToHelloTimers_{};
 
   // heartbeat packet send timers for each interface
   std::unordered_map<
       std::string /* ifName */,
-      std::unique_ptr<folly::AsyncTimeout>>
+      std::unique_ptr<TimerWheel::Timer>>
       ifNameToHeartbeatTimers_{};
 
+  // BFD style liveness detection of ESTABLISHED neighbors running in its own
+  // thread. Only set if fast liveness is enabled.
+  std::unique_ptr<FastLiveness> fastLiveness_{nullptr};
+  std::unique_ptr<std::thread> fastLivenessThread_{nullptr};
+
+  // heartbeat packet send timer for all interfaces in batched IO mode
+  std::unique_ptr<TimerWheel::Timer> heartbeatTimer_{nullptr};
+
+  // read buffer for batch of packets in batched IO mode
+  std::vector<uint8_t> batchRecvBuf_{};
+
+  // cached serialized hello packet for each interface
+  std::unordered_map<std::string /* ifName */, SparkPacketTemplate>
+      ifNameToHelloPacketTemplates_{};
+
+  // cached serialized heartbeat packet. Same for all interfaces.
+  std::optional<SparkPacketTemplate> heartbeatPacketTemplate_{std::nullopt};
+
   // number of active neighbors for each interface
   std::unordered_map<
       std::string /* ifName */,
@@ -147,4 +147,13 @@ SparkWrapper::processPacket() {
   spark_->processPacket();
 }
 
+void
+SparkWrapper::processPacketsInEvb(size_t numPackets) {
+  spark_->getEvb()->runInEventBaseThreadAndWait([this, numPackets]() {
+    for (size_t i = 0; i < numPackets; ++i) {
+      spark_->processPacket();
+    }
+  });
+}
+
 } // namespace openr
@@ -82,6 +82,15 @@ class SparkWrapper {
    */
   void processPacket();
 
+  /*
+   * Receive and process `numPackets` packets inline in Spark's event-base
+   * thread and wait for completion. Unlike processPacket(), it doesn't race
+   * with Spark's timers. When MockIoProvider's mailbox thread is not running,
+   * this is the only way packets get received, which makes it possible to
+   * measure receive path deterministically, e.g. in benchmarks.
+   */
+  void processPacketsInEvb(size_t numPackets);
+
  private:
   std::string myNodeName_{""};
   std::shared_ptr<const Config> config_{nullptr};
@@ -0,0 +1,751 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <fb303/ServiceData.h>
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <openr/common/Constants.h>
+#include <openr/common/NetworkUtil.h>
+#include <openr/common/Util.h>
+#include <openr/config/Config.h>
+#include <openr/spark/IoProvider.h>
+#include <openr/spark/SparkWrapper.h>
+#include <openr/tests/mocks/MockIoProvider.h>
+#include <openr/tests/utils/Utils.h>
+
+DEFINE_uint32(
+    spark_bench_pps,
+    0,
+    "If set, instead of running micro-benchmarks, offer heartbeat packets at "
+    "given packets/sec to Spark and report its CPU time per packet and "
+    "neighbor bring-up latency under load");
+DEFINE_uint32(
+    spark_bench_num_ifaces,
+    16,
+    "Number of interfaces, each with one synthetic neighbor, used with "
+    "--spark_bench_pps");
+DEFINE_uint32(
+    spark_bench_duration_s,
+    10,
+    "Duration of packet offering with --spark_bench_pps");
+DEFINE_bool(
+    spark_bench_rate_limit,
+    true,
+    "Enable Spark receive rate-limit with --spark_bench_pps");
+
+namespace fb303 = facebook::fb303;
+
+namespace {
+// The min size of IPv6 packet, same as read buffer used by Spark
+const int kMinIpv6Mtu = 1280;
+
+// Approximate size of serialized SparkHeartbeatMsg
+const size_t kPacketSize = 64;
+
+// Max number of packets per batch, same as used by Spark
+const size_t kMaxIoBatchSize = 64;
+
+const int kMockedUdpPort{6666};
+
+// Number of packets queued up front, before Spark is asked to process them
+const size_t kChunkSize = 4096;
+
+const std::string kNodeName{"spark-node"};
+const std::string kDomainName{"domain"};
+} // namespace
+
+namespace openr {
+
+/**
+ * Wires `numIfaces` local interfaces joined by a sender socket to the same
+ * number of peer interfaces joined by a receiver socket, the same way as
+ * Spark joins multicast group on all of its interfaces with single socket.
+ */
+class SparkIoWrapper {
+ public:
+  explicit SparkIoWrapper(size_t numIfaces) {
+    ioProvider = std::make_shared<MockIoProvider>();
+
+    IfNameAndifIndex ifNameAndIndex;
+    ConnectedIfPairs connectedPairs;
+    for (size_t i = 1; i <= numIfaces; ++i) {
+      const auto localIfName = fmt::format("local{}", i);
+      const auto peerIfName = fmt::format("peer{}", i);
+      ifNameAndIndex.emplace_back(localIfName, i);
+      ifNameAndIndex.emplace_back(peerIfName, numIfaces + i);
+      connectedPairs[localIfName] = {{peerIfName, 0}};
+    }
+    ioProvider->addIfNameIfIndex(ifNameAndIndex);
+    ioProvider->setConnectedPairs(connectedPairs);
+
+    sendFd = ioProvider->socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    recvFd = ioProvider->socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    for (size_t i = 1; i <= numIfaces; ++i) {
+      joinGroup(sendFd, i);
+      joinGroup(recvFd, numIfaces + i);
+
+      messages.emplace_back(IoProvider::SendMessageEntry{
+          static_cast<int>(i),
+          folly::IPAddressV6("fe80::1"),
+          std::string(kPacketSize, 'x')});
+    }
+
+    recvBuf.resize(kMaxIoBatchSize * kMinIpv6Mtu);
+  }
+
+  void
+  joinGroup(int fd, int ifIndex) {
+    const folly::IPAddress mcastGroup(Constants::kSparkMcastAddr.toString());
+    struct ipv6_mreq mreq;
+    mreq.ipv6mr_interface = ifIndex;
+    ::memcpy(
+        &mreq.ipv6mr_multiaddr, mcastGroup.bytes(), mcastGroup.byteCount());
+    CHECK_EQ(
+        0,
+        ioProvider->setsockopt(
+            fd, IPPROTO_IPV6, IPV6_JOIN_GROUP, &mreq, sizeof(mreq)));
+  }
+
+  std::shared_ptr<MockIoProvider> ioProvider;
+  int sendFd{-1};
+  int recvFd{-1};
+  const folly::SocketAddress dstAddr{
+      folly::IPAddress(Constants::kSparkMcastAddr.toString()),
+      kMockedUdpPort};
+  std::vector<IoProvider::SendMessageEntry> messages;
+  std::vector<uint8_t> recvBuf;
+};
+
+/**
+ * Benchmark to measure packets/sec of Spark heartbeat IO path, i.e. send a
+ * packet on every interface and receive all of them on peer side.
+ * 1. One sendmsg/recvmsg syscall per packet
+ * 2. Batched sendmmsg/recvmmsg syscalls
+ *
+ * Reported iterations are number of packets.
+ */
+static unsigned
+BM_SparkIoSingle(uint32_t iters, size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkIoWrapper wrapper(numIfaces);
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    for (auto const& message : wrapper.messages) {
+      IoProvider::sendMessage(
+          wrapper.sendFd,
+          message.ifIndex,
+          message.srcAddr,
+          wrapper.dstAddr,
+          message.packet,
+          wrapper.ioProvider.get());
+    }
+    for (size_t j = 0; j < numIfaces; ++j) {
+      IoProvider::recvMessage(
+          wrapper.recvFd,
+          wrapper.recvBuf.data(),
+          kMinIpv6Mtu,
+          wrapper.ioProvider.get());
+    }
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  CHECK_EQ(
+      wrapper.ioProvider->getNumPacketsSent(),
+      wrapper.ioProvider->getNumPacketsRecvd());
+  return iters * numIfaces;
+}
+
+static unsigned
+BM_SparkIoBatched(uint32_t iters, size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkIoWrapper wrapper(numIfaces);
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    IoProvider::sendMessages(
+        wrapper.sendFd,
+        wrapper.dstAddr,
+        wrapper.messages,
+        wrapper.ioProvider.get());
+    size_t numRecvd{0};
+    while (numRecvd < numIfaces) {
+      numRecvd += IoProvider::recvMessages(
+                      wrapper.recvFd,
+                      wrapper.recvBuf.data(),
+                      kMinIpv6Mtu,
+                      kMaxIoBatchSize,
+                      wrapper.ioProvider.get())
+                      .size();
+    }
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  CHECK_EQ(
+      wrapper.ioProvider->getNumPacketsSent(),
+      wrapper.ioProvider->getNumPacketsRecvd());
+  return iters * numIfaces;
+}
+
+// The parameter is the number of interfaces
+BENCHMARK_PARAM_MULTI(BM_SparkIoSingle, 1);
+BENCHMARK_RELATIVE_PARAM_MULTI(BM_SparkIoBatched, 1);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM_MULTI(BM_SparkIoSingle, 16);
+BENCHMARK_RELATIVE_PARAM_MULTI(BM_SparkIoBatched, 16);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM_MULTI(BM_SparkIoSingle, 64);
+BENCHMARK_RELATIVE_PARAM_MULTI(BM_SparkIoBatched, 64);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM_MULTI(BM_SparkIoSingle, 256);
+BENCHMARK_RELATIVE_PARAM_MULTI(BM_SparkIoBatched, 256);
+
+/**
+ * Runs Spark on `numIfaces` local interfaces, each connected to a peer
+ * interface on which a synthetic neighbor is emulated. Synthetic neighbors
+ * don't run Spark, they only send crafted packets to it.
+ *
+ * Unless MockIoProvider's mailbox thread is started, Spark doesn't poll its
+ * socket on its own. Instead, queued packets are processed inline in Spark's
+ * thread with `processQueuedPackets()`, hence time spent in benchmark loop is
+ * the time Spark spends on receive path: parsing, sanity check and neighbor
+ * state machine.
+ */
+class SparkPacketWrapper {
+ public:
+  SparkPacketWrapper(size_t numIfaces, bool isRateLimitEnabled)
+      : numIfaces_(numIfaces) {
+    ioProvider = std::make_shared<MockIoProvider>();
+
+    IfNameAndifIndex ifNameAndIndex;
+    ConnectedIfPairs connectedPairs;
+    InterfaceDatabase ifDb;
+    for (size_t i = 1; i <= numIfaces; ++i) {
+      const auto localIfName = getLocalIfName(i);
+      const auto peerIfName = fmt::format("peer{}", i);
+      ifNameAndIndex.emplace_back(localIfName, i);
+      ifNameAndIndex.emplace_back(peerIfName, numIfaces + i);
+      connectedPairs[localIfName] = {{peerIfName, 0}};
+      connectedPairs[peerIfName] = {{localIfName, 0}};
+      ifDb.emplace_back(
+          localIfName,
+          true /* isUp */,
+          i /* ifIndex */,
+          std::unordered_set<folly::CIDRNetwork>{
+              folly::IPAddress::createNetwork("fe80::1/128")});
+    }
+    ioProvider->addIfNameIfIndex(ifNameAndIndex);
+    ioProvider->setConnectedPairs(connectedPairs);
+
+    // socket shared by all synthetic neighbors
+    peerFd_ = ioProvider->socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    for (size_t i = 1; i <= numIfaces; ++i) {
+      const folly::IPAddress mcastGroup(Constants::kSparkMcastAddr.toString());
+      struct ipv6_mreq mreq;
+      mreq.ipv6mr_interface = numIfaces + i;
+      ::memcpy(
+          &mreq.ipv6mr_multiaddr, mcastGroup.bytes(), mcastGroup.byteCount());
+      CHECK_EQ(
+          0,
+          ioProvider->setsockopt(
+              peerFd_, IPPROTO_IPV6, IPV6_JOIN_GROUP, &mreq, sizeof(mreq)));
+    }
+
+    auto tConfig = getBasicOpenrConfig(
+        kNodeName, kDomainName, {} /* areaCfg */, false /* enableV4 */);
+    config_ = std::make_shared<Config>(tConfig);
+    dstAddr_ = folly::SocketAddress(
+        folly::IPAddress(Constants::kSparkMcastAddr.toString()),
+        *config_->getSparkConfig().neighbor_discovery_port_ref());
+
+    // ATTN: SparkWrapper runs Spark with default receive rate-limit only if
+    // its `isRateLimitEnabled` is NOT set
+    spark = std::make_unique<SparkWrapper>(
+        kNodeName,
+        std::make_pair(
+            Constants::kOpenrVersion, Constants::kOpenrSupportedVersion),
+        ioProvider,
+        config_,
+        not isRateLimitEnabled);
+    spark->updateInterfaceDb(ifDb);
+
+    // All interfaces are added at once. Spark greets on them right after.
+    while (ioProvider->getNumPacketsSent() == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  ~SparkPacketWrapper() {
+    if (mailboxThread_) {
+      ioProvider->stop();
+      mailboxThread_->join();
+    }
+    spark.reset();
+  }
+
+  /**
+   * Let MockIoProvider deliver packets to Spark's socket, the same way as in
+   * production, instead of processing them with `processQueuedPackets()`.
+   */
+  void
+  startMailboxThread() {
+    mailboxThread_ = std::make_unique<std::thread>([this]() {
+      ioProvider->start();
+    });
+    ioProvider->waitUntilRunning();
+  }
+
+  static std::string
+  getLocalIfName(size_t i) {
+    return fmt::format("local{}", i);
+  }
+
+  static std::string
+  getNeighborName(size_t i) {
+    return fmt::format("neighbor{}", i);
+  }
+
+  // Source address of synthetic neighbor. It keys Spark's rate-limit.
+  static folly::IPAddressV6
+  getNeighborAddr(size_t i) {
+    return folly::IPAddressV6(fmt::format("fe80::2:{:x}", i));
+  }
+
+  std::string
+  makeHelloPacket(std::string const& neighborName, bool isAwareOfMe) {
+    // same clock as kernel timestamps of received packets
+    const int64_t nowInUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    thrift::SparkHelloMsg helloMsg;
+    helloMsg.domainName_ref() = kDomainName;
+    helloMsg.nodeName_ref() = neighborName;
+    helloMsg.ifName_ref() = "remote";
+    helloMsg.seqNum_ref() = 1;
+    helloMsg.version_ref() = Constants::kOpenrVersion;
+    helloMsg.solicitResponse_ref() = false;
+    helloMsg.sentTsInUs_ref() = nowInUs;
+    if (isAwareOfMe) {
+      // Reflect plausible timestamps, so that RTT can be deduced. Seq# must
+      // be lower than Spark's own, which starts from 1.
+      auto& neighborInfo = helloMsg.neighborInfos_ref()[kNodeName];
+      neighborInfo.seqNum_ref() = 0;
+      neighborInfo.lastNbrMsgSentTsInUs_ref() = nowInUs - 100;
+      neighborInfo.lastMyMsgRcvdTsInUs_ref() = nowInUs - 50;
+    }
+
+    thrift::SparkHelloPacket pkt;
+    pkt.helloMsg_ref() = std::move(helloMsg);
+    return writeThriftObjStr(pkt, serializer_);
+  }
+
+  std::string
+  makeHandshakePacket(std::string const& neighborName, size_t i) {
+    thrift::SparkHandshakeMsg handshakeMsg;
+    handshakeMsg.nodeName_ref() = neighborName;
+    handshakeMsg.isAdjEstablished_ref() = true;
+    handshakeMsg.holdTime_ref() = 10000;
+    handshakeMsg.gracefulRestartTime_ref() = 30000;
+    handshakeMsg.transportAddressV6_ref() =
+        toBinaryAddress(folly::IPAddress(getNeighborAddr(i)));
+    handshakeMsg.transportAddressV4_ref() =
+        toBinaryAddress(folly::IPAddress("0.0.0.0"));
+    handshakeMsg.openrCtrlThriftPort_ref() = 2018;
+    handshakeMsg.kvStoreCmdPort_ref() = 60002;
+    handshakeMsg.area_ref() = Constants::kDefaultArea.toString();
+    handshakeMsg.neighborNodeName_ref() = kNodeName;
+
+    thrift::SparkHelloPacket pkt;
+    pkt.handshakeMsg_ref() = std::move(handshakeMsg);
+    return writeThriftObjStr(pkt, serializer_);
+  }
+
+  std::string
+  makeHeartbeatPacket(std::string const& neighborName) {
+    thrift::SparkHeartbeatMsg heartbeatMsg;
+    heartbeatMsg.nodeName_ref() = neighborName;
+    heartbeatMsg.seqNum_ref() = 1;
+
+    thrift::SparkHelloPacket pkt;
+    pkt.heartbeatMsg_ref() = std::move(heartbeatMsg);
+    return writeThriftObjStr(pkt, serializer_);
+  }
+
+  // Send packet from synthetic neighbor on i-th interface
+  void
+  send(size_t i, std::string const& packet) {
+    send(i, getNeighborAddr(i), packet);
+  }
+
+  void
+  send(size_t i, folly::IPAddressV6 const& srcAddr, std::string const& packet) {
+    CHECK_EQ(
+        static_cast<ssize_t>(packet.size()),
+        IoProvider::sendMessage(
+            peerFd_,
+            numIfaces_ + i,
+            srcAddr,
+            dstAddr_,
+            packet,
+            ioProvider.get()));
+  }
+
+  // Packets a synthetic neighbor sends to go from IDLE to ESTABLISHED
+  void
+  sendNeighborUpPackets(
+      size_t i,
+      std::string const& neighborName,
+      folly::IPAddressV6 const& srcAddr) {
+    // IDLE => WARM
+    send(i, srcAddr, makeHelloPacket(neighborName, false));
+    // WARM => NEGOTIATE
+    send(i, srcAddr, makeHelloPacket(neighborName, true));
+    // NEGOTIATE => ESTABLISHED
+    send(i, srcAddr, makeHandshakePacket(neighborName, i));
+  }
+
+  void
+  processQueuedPackets(size_t numPackets) {
+    spark->processPacketsInEvb(numPackets);
+  }
+
+  // Wait for NEIGHBOR_UP of given number of neighbors
+  void
+  waitForNeighborsUp(size_t numNeighbors) {
+    size_t numUp{0};
+    while (numUp < numNeighbors) {
+      auto events = spark->waitForEvents(
+          NeighborEventType::NEIGHBOR_UP, std::chrono::seconds(10));
+      CHECK(events.has_value()) << "Timed out waiting for NEIGHBOR_UP";
+      numUp += events->size();
+    }
+  }
+
+  // Bring up synthetic neighbor on every interface
+  void
+  establishNeighbors() {
+    for (size_t i = 1; i <= numIfaces_; ++i) {
+      sendNeighborUpPackets(i, getNeighborName(i), getNeighborAddr(i));
+    }
+    if (not mailboxThread_) {
+      processQueuedPackets(3 * numIfaces_);
+    }
+    waitForNeighborsUp(numIfaces_);
+  }
+
+  // Discard neighbor events and packets sent by Spark
+  void
+  drain() {
+    while (spark->recvNeighborEvent(std::chrono::milliseconds(0))) {
+    }
+    while (not IoProvider::recvMessages(
+                   peerFd_,
+                   recvBuf_.data(),
+                   kMinIpv6Mtu,
+                   kMaxIoBatchSize,
+                   ioProvider.get())
+                   .empty()) {
+    }
+  }
+
+  // CPU time consumed by Spark's thread so far
+  std::chrono::nanoseconds
+  getSparkCpuTime() {
+    std::chrono::nanoseconds cpuTime{0};
+    spark->get()->getEvb()->runInEventBaseThreadAndWait([&cpuTime]() {
+      struct timespec ts;
+      CHECK_EQ(0, ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts));
+      cpuTime = std::chrono::seconds(ts.tv_sec) +
+          std::chrono::nanoseconds(ts.tv_nsec);
+    });
+    return cpuTime;
+  }
+
+  std::shared_ptr<MockIoProvider> ioProvider;
+  std::unique_ptr<SparkWrapper> spark;
+
+ private:
+  const size_t numIfaces_{0};
+  int peerFd_{-1};
+  folly::SocketAddress dstAddr_;
+  std::shared_ptr<const Config> config_;
+  apache::thrift::CompactSerializer serializer_;
+  std::vector<uint8_t> recvBuf_ =
+      std::vector<uint8_t>(kMaxIoBatchSize * kMinIpv6Mtu);
+  std::unique_ptr<std::thread> mailboxThread_;
+};
+
+/**
+ * Send `iters` packets round-robin across interfaces and process them. Packets
+ * are generated and queued with benchmark suspended, so that measured time is
+ * Spark receive path only.
+ */
+template <typename MakePacket>
+static void
+runPackets(
+    SparkPacketWrapper& wrapper,
+    folly::BenchmarkSuspender& suspender,
+    uint32_t iters,
+    size_t numIfaces,
+    MakePacket&& makePacket) {
+  std::vector<std::string> packets;
+  for (size_t i = 1; i <= numIfaces; ++i) {
+    packets.emplace_back(makePacket(i));
+  }
+
+  for (uint32_t sent = 0; sent < iters;) {
+    const auto chunkSize = std::min<size_t>(kChunkSize, iters - sent);
+    for (size_t j = 0; j < chunkSize; ++j) {
+      const auto i = (sent + j) % numIfaces + 1;
+      wrapper.send(i, packets.at(i - 1));
+    }
+    sent += chunkSize;
+
+    suspender.dismiss(); // Start measuring benchmark time
+    wrapper.processQueuedPackets(chunkSize);
+    suspender.rehire(); // Stop measuring time again
+
+    wrapper.drain();
+  }
+}
+
+/**
+ * Benchmarks to measure CPU time per packet of Spark receive path with
+ * synthetic neighbors established on every interface.
+ * 1. Heartbeat: keep-alive of established adjacency
+ * 2. Hello: steady state hello, incl. RTT measurement
+ * 3. Malformed: packet which fails to parse
+ * 4. RateLimited: hello storm from single neighbor, dropped by rate-limit
+ *
+ * Reported iterations are number of packets.
+ */
+static void
+BM_SparkRecvHeartbeat(uint32_t iters, size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkPacketWrapper wrapper(numIfaces, false /* isRateLimitEnabled */);
+  wrapper.establishNeighbors();
+
+  runPackets(wrapper, suspender, iters, numIfaces, [&](size_t i) {
+    return wrapper.makeHeartbeatPacket(SparkPacketWrapper::getNeighborName(i));
+  });
+}
+
+static void
+BM_SparkRecvHello(uint32_t iters, size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkPacketWrapper wrapper(numIfaces, false /* isRateLimitEnabled */);
+  wrapper.establishNeighbors();
+
+  runPackets(wrapper, suspender, iters, numIfaces, [&](size_t i) {
+    return wrapper.makeHelloPacket(
+        SparkPacketWrapper::getNeighborName(i), true /* isAwareOfMe */);
+  });
+}
+
+static void
+BM_SparkRecvMalformed(uint32_t iters, size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkPacketWrapper wrapper(numIfaces, false /* isRateLimitEnabled */);
+  wrapper.establishNeighbors();
+
+  runPackets(wrapper, suspender, iters, numIfaces, [&](size_t i) {
+    // truncated packet
+    auto packet = wrapper.makeHelloPacket(
+        SparkPacketWrapper::getNeighborName(i), true /* isAwareOfMe */);
+    packet.resize(packet.size() / 2);
+    return packet;
+  });
+}
+
+static void
+BM_SparkRecvRateLimited(uint32_t iters, size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkPacketWrapper wrapper(numIfaces, true /* isRateLimitEnabled */);
+  wrapper.establishNeighbors();
+
+  runPackets(wrapper, suspender, iters, numIfaces, [&](size_t i) {
+    return wrapper.makeHelloPacket(
+        SparkPacketWrapper::getNeighborName(i), true /* isAwareOfMe */);
+  });
+}
+
+/**
+ * Benchmark to measure neighbor state machine latency. Synthetic neighbor on
+ * every interface goes through IDLE => WARM => NEGOTIATE => ESTABLISHED and
+ * is then brought down with hello which doesn't reflect Spark.
+ *
+ * Reported iterations are number of neighbor up/down cycles.
+ */
+static void
+BM_SparkNeighborUpDown(uint32_t iters, size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkPacketWrapper wrapper(numIfaces, false /* isRateLimitEnabled */);
+
+  std::vector<std::string> downPackets;
+  for (size_t i = 1; i <= numIfaces; ++i) {
+    downPackets.emplace_back(wrapper.makeHelloPacket(
+        SparkPacketWrapper::getNeighborName(i), false /* isAwareOfMe */));
+  }
+
+  for (uint32_t cycles = 0; cycles < iters;) {
+    const auto numNeighbors = std::min<size_t>(numIfaces, iters - cycles);
+    for (size_t i = 1; i <= numNeighbors; ++i) {
+      wrapper.sendNeighborUpPackets(
+          i,
+          SparkPacketWrapper::getNeighborName(i),
+          SparkPacketWrapper::getNeighborAddr(i));
+      wrapper.send(i, downPackets.at(i - 1));
+    }
+    cycles += numNeighbors;
+
+    suspender.dismiss(); // Start measuring benchmark time
+    wrapper.processQueuedPackets(4 * numNeighbors);
+    suspender.rehire(); // Stop measuring time again
+
+    wrapper.drain();
+  }
+}
+
+// The parameter is the number of interfaces
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(BM_SparkRecvHeartbeat, 1);
+BENCHMARK_PARAM(BM_SparkRecvHeartbeat, 64);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(BM_SparkRecvHello, 1);
+BENCHMARK_PARAM(BM_SparkRecvHello, 64);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(BM_SparkRecvMalformed, 1);
+BENCHMARK_PARAM(BM_SparkRecvMalformed, 64);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(BM_SparkRecvRateLimited, 1);
+BENCHMARK_PARAM(BM_SparkRecvRateLimited, 64);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(BM_SparkNeighborUpDown, 1);
+BENCHMARK_PARAM(BM_SparkNeighborUpDown, 64);
+
+/**
+ * Offer heartbeats at `--spark_bench_pps` packets/sec, spread evenly across
+ * synthetic neighbors, for `--spark_bench_duration_s`. Packets are delivered
+ * to Spark by MockIoProvider's mailbox thread and processed by Spark's own
+ * event loop. Half way through, a new neighbor is brought up to measure
+ * state machine latency under load.
+ */
+static void
+runPacedBenchmark() {
+  const size_t numIfaces = FLAGS_spark_bench_num_ifaces;
+  const auto duration = std::chrono::seconds(FLAGS_spark_bench_duration_s);
+  CHECK_GT(numIfaces, 0);
+
+  SparkPacketWrapper wrapper(numIfaces, FLAGS_spark_bench_rate_limit);
+  wrapper.startMailboxThread();
+  wrapper.establishNeighbors();
+
+  std::vector<std::string> packets;
+  for (size_t i = 1; i <= numIfaces; ++i) {
+    packets.emplace_back(
+        wrapper.makeHeartbeatPacket(SparkPacketWrapper::getNeighborName(i)));
+  }
+
+  auto counters = fb303::fbData->getCounters();
+  const auto startDropped = counters["spark.hello.packet_dropped.sum"];
+  const auto startRecvd = wrapper.ioProvider->getNumPacketsRecvd();
+  const auto startCpuTime = wrapper.getSparkCpuTime();
+
+  std::optional<std::chrono::steady_clock::time_point> probeSentTime;
+  std::optional<std::chrono::microseconds> probeLatency;
+  std::thread probeThread;
+
+  const auto startTime = std::chrono::steady_clock::now();
+  uint64_t numSent{0};
+  while (true) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - startTime >= duration) {
+      break;
+    }
+
+    // bring up probe neighbor on first interface half way through
+    if (not probeSentTime.has_value() and now - startTime >= duration / 2) {
+      probeSentTime = now;
+      wrapper.sendNeighborUpPackets(
+          1, "probe", folly::IPAddressV6("fe80::3:1"));
+      probeThread = std::thread([&]() {
+        wrapper.waitForNeighborsUp(1);
+        probeLatency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - *probeSentTime);
+      });
+    }
+
+    // catch up with packets due till now
+    const auto elapsedUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - startTime)
+            .count();
+    const uint64_t numDue = elapsedUs * FLAGS_spark_bench_pps / 1000000;
+    for (; numSent < numDue; ++numSent) {
+      const auto i = numSent % numIfaces + 1;
+      wrapper.send(i, packets.at(i - 1));
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  if (probeThread.joinable()) {
+    probeThread.join();
+  }
+
+  const auto cpuTime = wrapper.getSparkCpuTime() - startCpuTime;
+  const auto numRecvd = wrapper.ioProvider->getNumPacketsRecvd() - startRecvd;
+  counters = fb303::fbData->getCounters();
+  const auto numDropped =
+      counters["spark.hello.packet_dropped.sum"] - startDropped;
+
+  LOG(INFO) << fmt::format(
+      "Offered {} packets at {} pps across {} interfaces in {}s",
+      numSent,
+      FLAGS_spark_bench_pps,
+      numIfaces,
+      duration.count());
+  LOG(INFO) << fmt::format(
+      "Spark received {} packets, dropped {} by rate-limit, consumed {}ms "
+      "of CPU, {:.2f}us per packet",
+      numRecvd,
+      numDropped,
+      cpuTime.count() / 1000000,
+      numRecvd ? cpuTime.count() / 1000.0 / numRecvd : 0.0);
+  if (probeLatency.has_value()) {
+    LOG(INFO) << fmt::format(
+        "Neighbor bring-up latency under load: {}us", probeLatency->count());
+  }
+}
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  if (FLAGS_spark_bench_pps > 0) {
+    openr::runPacedBenchmark();
+  } else {
+    folly::runBenchmarks();
+  }
+  return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <openr/common/Constants.h>
+#include <openr/config/Config.h>
+#include <openr/spark/IoProvider.h>
+#include <openr/spark/SparkWrapper.h>
+#include <openr/tests/mocks/MockIoProvider.h>
+#include <openr/tests/utils/Utils.h>
+
+namespace {
+// The min size of IPv6 packet, same as read buffer used by Spark
+const int kMinIpv6Mtu = 1280;
+
+// Max number of packets per batch, same as used by Spark
+const size_t kMaxIoBatchSize = 64;
+
+const std::string kNodeName{"fuzz-node"};
+const std::string kLocalIfName{"local1"};
+const std::string kPeerIfName{"peer1"};
+const int kLocalIfIndex{1};
+const int kPeerIfIndex{2};
+} // namespace
+
+namespace openr {
+
+/**
+ * Spark tracking single interface, to which fuzzer input is delivered as is
+ * from a peer interface. Spark is kept across inputs, hence sequence of inputs
+ * can drive neighbor state machine as well.
+ *
+ * Spark is run by SparkWrapper, which re-throws unexpected parser errors.
+ * Packets are processed inline in Spark's thread, so any such error, failed
+ * CHECK or sanitizer report is caught by fuzzer as a crash.
+ */
+class SparkFuzzer {
+ public:
+  SparkFuzzer() {
+    ioProvider_ = std::make_shared<MockIoProvider>();
+    ioProvider_->addIfNameIfIndex(
+        {{kLocalIfName, kLocalIfIndex}, {kPeerIfName, kPeerIfIndex}});
+    ioProvider_->setConnectedPairs({
+        {kLocalIfName, {{kPeerIfName, 0}}},
+        {kPeerIfName, {{kLocalIfName, 0}}},
+    });
+
+    peerFd_ = ioProvider_->socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    const folly::IPAddress mcastGroup(Constants::kSparkMcastAddr.toString());
+    struct ipv6_mreq mreq;
+    mreq.ipv6mr_interface = kPeerIfIndex;
+    ::memcpy(
+        &mreq.ipv6mr_multiaddr, mcastGroup.bytes(), mcastGroup.byteCount());
+    CHECK_EQ(
+        0,
+        ioProvider_->setsockopt(
+            peerFd_, IPPROTO_IPV6, IPV6_JOIN_GROUP, &mreq, sizeof(mreq)));
+
+    auto config =
+        std::make_shared<Config>(getBasicOpenrConfig(kNodeName, "domain"));
+    dstAddr_ = folly::SocketAddress(
+        folly::IPAddress(Constants::kSparkMcastAddr.toString()),
+        *config->getSparkConfig().neighbor_discovery_port_ref());
+
+    spark_ = std::make_unique<SparkWrapper>(
+        kNodeName,
+        std::make_pair(
+            Constants::kOpenrVersion, Constants::kOpenrSupportedVersion),
+        ioProvider_,
+        config);
+    spark_->updateInterfaceDb({InterfaceInfo(
+        kLocalIfName,
+        true /* isUp */,
+        kLocalIfIndex,
+        {folly::IPAddress::createNetwork("192.168.0.1/24", -1, false),
+         folly::IPAddress::createNetwork("fe80::1/128")})});
+
+    // wait for interface to be tracked. Spark greets on it right after.
+    while (ioProvider_->getNumPacketsSent() == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  void
+  processInput(const uint8_t* data, size_t size) {
+    // larger packets can't be sent over the link
+    if (size > kMinIpv6Mtu) {
+      return;
+    }
+
+    std::string packet(reinterpret_cast<const char*>(data), size);
+    if (IoProvider::sendMessage(
+            peerFd_,
+            kPeerIfIndex,
+            folly::IPAddressV6("fe80::2"),
+            dstAddr_,
+            packet,
+            ioProvider_.get()) < 0) {
+      return;
+    }
+    spark_->processPacketsInEvb(1);
+
+    // discard neighbor events and packets sent by Spark
+    while (spark_->recvNeighborEvent(std::chrono::milliseconds(0))) {
+    }
+    while (not IoProvider::recvMessages(
+                   peerFd_,
+                   recvBuf_.data(),
+                   kMinIpv6Mtu,
+                   kMaxIoBatchSize,
+                   ioProvider_.get())
+                   .empty()) {
+    }
+  }
+
+ private:
+  std::shared_ptr<MockIoProvider> ioProvider_;
+  std::unique_ptr<SparkWrapper> spark_;
+  int peerFd_{-1};
+  folly::SocketAddress dstAddr_;
+  std::vector<uint8_t> recvBuf_ =
+      std::vector<uint8_t>(kMaxIoBatchSize * kMinIpv6Mtu);
+};
+
+} // namespace openr
+
+extern "C" int
+LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  // Spark is expensive to set up, hence it is created once and leaked on
+  // purpose to avoid tearing it down while fuzzer exits
+  static auto* fuzzer = new openr::SparkFuzzer();
+  fuzzer->processInput(data, size);
+  return 0;
+}
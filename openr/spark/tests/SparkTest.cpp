@@ -15,6 +15,7 @@
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Util.h>
 #include <openr/config/Config.h>
+#include <openr/spark/FastLiveness.h>
 #include <openr/spark/SparkWrapper.h>
 #include <openr/tests/mocks/MockIoProvider.h>
 #include <openr/tests/utils/Utils.h>
@@ -663,6 +664,220 @@ TEST_F(SimpleSparkFixture, HeartbeatTimerExpireTest) {
   }
 }
 
+//
+// Start 2 Spark instances and wait them forming adj. Verify hello and
+// heartbeat packets are built from cached templates while the neighbor stays
+// stable, i.e. reflected neighbor timestamps don't invalidate templates.
+//
+TEST_F(SimpleSparkFixture, PacketTemplateCacheTest) {
+  // create Spark instances and establish connections
+  createAndConnect();
+
+  // wait for both nodes to leave fast initial state
+  auto fastInitTime = std::chrono::milliseconds(
+      config1_->getSparkConfig().get_fastinit_hello_time_ms());
+  /* sleep override */
+  std::this_thread::sleep_for(6 * fastInitTime + std::chrono::seconds(1));
+
+  fb303::fbData->resetAllData();
+
+  // let both nodes exchange multiple hello packets
+  auto helloTime =
+      std::chrono::seconds(config1_->getSparkConfig().get_hello_time_s());
+  /* sleep override */
+  std::this_thread::sleep_for(helloTime * 3);
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_LE(6, counters.at("spark.packet_template.cache_hit.sum"));
+  EXPECT_EQ(0, counters["spark.packet_template.cache_miss.sum"]);
+}
+
+/*
+ * This is the test fixture to create two Spark instances sending and
+ * receiving packets in batches with sendmmsg/recvmmsg.
+ */
+class BatchedIoSparkFixture : public SimpleSparkFixture {
+ protected:
+  void
+  createConfig() override {
+    auto tConfig1 = getBasicOpenrConfig(nodeName1_, kDomainName);
+    auto tConfig2 = getBasicOpenrConfig(nodeName2_, kDomainName);
+    tConfig1.spark_config_ref()->enable_batched_io_ref() = true;
+    tConfig2.spark_config_ref()->enable_batched_io_ref() = true;
+
+    config1_ = std::make_shared<Config>(tConfig1);
+    config2_ = std::make_shared<Config>(tConfig2);
+  }
+};
+
+//
+// Start 2 Spark instances in batched IO mode and wait them forming adj.
+// Verify heartbeats keep adj alive beyond hold time and adj goes down once
+// heartbeats stop flowing.
+//
+TEST_F(BatchedIoSparkFixture, HeartbeatTest) {
+  fb303::fbData->resetAllData();
+
+  // create Spark instances and establish connections
+  createAndConnect();
+
+  // adj must stay up beyond hold time with batched heartbeats
+  {
+    auto holdTime =
+        std::chrono::seconds(config1_->getSparkConfig().get_hold_time_s());
+    EXPECT_FALSE(
+        node1_->waitForEvents(NB_DOWN, holdTime * 2, holdTime * 3).has_value());
+    EXPECT_FALSE(
+        node2_->waitForEvents(NB_DOWN, holdTime * 2, holdTime * 3).has_value());
+  }
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_LT(0, counters.at("spark.heartbeat.packet_sent.sum"));
+  EXPECT_LT(0, counters.at("spark.packet_send_batch_size.avg"));
+  EXPECT_LT(0, counters.at("spark.packet_recv_batch_size.avg"));
+
+  // remove underneath connections between to nodes
+  ConnectedIfPairs connectedPairs = {};
+  mockIoProvider_->setConnectedPairs(connectedPairs);
+
+  // wait for sparks to lose each other
+  EXPECT_TRUE(node1_->waitForEvents(NB_DOWN).has_value());
+  EXPECT_TRUE(node2_->waitForEvents(NB_DOWN).has_value());
+}
+
+/*
+ * This is the test fixture to create two Spark instances with fast liveness
+ * detection enabled.
+ */
+class FastLivenessSparkFixture : public SimpleSparkFixture {
+ protected:
+  void
+  createConfig() override {
+    auto tConfig1 = getBasicOpenrConfig(nodeName1_, kDomainName);
+    auto tConfig2 = getBasicOpenrConfig(nodeName2_, kDomainName);
+    for (auto* tConfig : {&tConfig1, &tConfig2}) {
+      auto& sparkConfig = *tConfig->spark_config_ref();
+      sparkConfig.enable_fast_liveness_ref() = true;
+      sparkConfig.fast_liveness_config_ref()->tx_interval_ms_ref() = 20;
+      sparkConfig.fast_liveness_config_ref()->detect_multiplier_ref() = 3;
+    }
+
+    config1_ = std::make_shared<Config>(tConfig1);
+    config2_ = std::make_shared<Config>(tConfig2);
+  }
+};
+
+//
+// Start 2 Spark instances with fast liveness enabled and wait them forming
+// adj. Verify adj goes down well within hold time once connection is lost.
+//
+TEST_F(FastLivenessSparkFixture, FastDetectionTest) {
+  fb303::fbData->resetAllData();
+
+  // create Spark instances and establish connections
+  createAndConnect();
+
+  // wait for echo packets to bring up sessions on both sides
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_LT(0, counters.at("spark.fast_liveness.echo_sent.sum"));
+  EXPECT_LT(0, counters.at("spark.fast_liveness.echo_recv.sum"));
+
+  // adj must stay up as long as echo packets flow
+  EXPECT_EQ(0, counters.at("spark.fast_liveness.neighbor_down.sum"));
+
+  // remove underneath connections between to nodes
+  auto startTime = std::chrono::steady_clock::now();
+  ConnectedIfPairs connectedPairs = {};
+  mockIoProvider_->setConnectedPairs(connectedPairs);
+
+  // wait for sparks to lose each other
+  EXPECT_TRUE(node1_->waitForEvents(NB_DOWN).has_value());
+  EXPECT_TRUE(node2_->waitForEvents(NB_DOWN).has_value());
+
+  // failure must be detected by fast liveness, way before hold time
+  auto holdTime =
+      std::chrono::seconds(config1_->getSparkConfig().get_hold_time_s());
+  EXPECT_GT(holdTime / 2, std::chrono::steady_clock::now() - startTime);
+
+  counters = fb303::fbData->getCounters();
+  EXPECT_EQ(2, counters.at("spark.fast_liveness.neighbor_down.sum"));
+}
+
+//
+// Start 2 fast liveness instances, where node1 sends echo packets out of 3
+// interfaces. Sending on the one in the middle of the batch always fails, as
+// it is not connected anywhere. Verify echo packets on the other interfaces
+// still go out and bring up sessions on node2.
+//
+TEST_F(SparkFixture, FastLivenessSendErrorTest) {
+  fb303::fbData->resetAllData();
+
+  const std::string peerIface1{"peerIface1"};
+  const std::string peerIface3{"peerIface3"};
+  const int peerIfIndex1{11};
+  const int peerIfIndex3{13};
+
+  mockIoProvider_->addIfNameIfIndex(
+      {{iface1, ifIndex1},
+       {iface2, ifIndex2},
+       {iface3, ifIndex3},
+       {peerIface1, peerIfIndex1},
+       {peerIface3, peerIfIndex3}});
+
+  // iface2 is not connected to any interface
+  ConnectedIfPairs connectedPairs = {
+      {iface1, {{peerIface1, 1}}},
+      {iface3, {{peerIface3, 1}}},
+      {peerIface1, {{iface1, 1}}},
+      {peerIface3, {{iface3, 1}}},
+  };
+  mockIoProvider_->setConnectedPairs(connectedPairs);
+
+  const uint16_t port{6667};
+  const std::chrono::milliseconds txInterval{20};
+  auto noopCb = [](std::string const&, std::string const&) {};
+  FastLiveness liveness1(
+      "node-1", port, txInterval, 3, mockIoProvider_, noopCb);
+  FastLiveness liveness2(
+      "node-2", port, txInterval, 3, mockIoProvider_, noopCb);
+  std::thread thread1([&]() { liveness1.run(); });
+  std::thread thread2([&]() { liveness2.run(); });
+  liveness1.waitUntilRunning();
+  liveness2.waitUntilRunning();
+
+  // echo packets of node1 go out in order of iface1, iface2, iface3
+  const auto srcAddr = ip1V6.first.asV6();
+  liveness1.addNeighbor(iface1, ifIndex1, srcAddr, "node-2");
+  liveness1.addNeighbor(iface2, ifIndex2, srcAddr, "node-3");
+  liveness1.addNeighbor(iface3, ifIndex3, srcAddr, "node-2");
+  liveness2.addNeighbor(peerIface1, peerIfIndex1, srcAddr, "node-1");
+  liveness2.addNeighbor(peerIface3, peerIfIndex3, srcAddr, "node-1");
+
+  // wait for echo packets of node1 to bring up both sessions on node2
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (std::move(liveness2.getNumUpSessions()).get() < 2 and
+         std::chrono::steady_clock::now() < deadline) {
+    /* sleep override */
+    std::this_thread::sleep_for(txInterval);
+  }
+  EXPECT_EQ(2, std::move(liveness2.getNumUpSessions()).get());
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_LT(0, counters.at("spark.fast_liveness.echo_send_error.sum"));
+  EXPECT_LT(0, counters.at("spark.fast_liveness.echo_sent.sum"));
+
+  liveness1.stop();
+  liveness2.stop();
+  liveness1.waitUntilStopped();
+  liveness2.waitUntilStopped();
+  thread1.join();
+  thread2.join();
+}
+
 //
 // Start 2 Spark instances and wait them forming adj. Then
 // update interface from one instance's perspective. Due to same
@@ -2040,6 +2255,97 @@ TEST_F(SparkFixture, MultiplePeersWithDiffAreaOverSameLink) {
   }
 }
 
+//
+// Verify packets built from template are byte-identical to packets serialized
+// from scratch for varying values of volatile fields.
+//
+TEST(SparkPacketTemplateTest, FillMatchesSerialization) {
+  apache::thrift::CompactSerializer serializer;
+  auto serialize = [&](int64_t seqNum, int64_t sentTsInUs) {
+    thrift::SparkHelloMsg helloMsg;
+    helloMsg.domainName_ref() = kDomainName;
+    helloMsg.nodeName_ref() = "node-1";
+    helloMsg.ifName_ref() = iface1;
+    helloMsg.seqNum_ref() = seqNum;
+    auto& neighborInfo = helloMsg.neighborInfos_ref()["node-2"];
+    neighborInfo.seqNum_ref() = 10;
+    neighborInfo.lastNbrMsgSentTsInUs_ref() = 1000;
+    neighborInfo.lastMyMsgRcvdTsInUs_ref() = 2000;
+    helloMsg.version_ref() = Constants::kOpenrVersion;
+    helloMsg.solicitResponse_ref() = true;
+    helloMsg.sentTsInUs_ref() = sentTsInUs;
+
+    thrift::SparkHelloPacket pkt;
+    pkt.helloMsg_ref() = std::move(helloMsg);
+    return writeThriftObjStr(pkt, serializer);
+  };
+
+  const auto kVolatile = SparkPacketTemplate::kVolatileField;
+
+  // number of volatile fields must match
+  EXPECT_FALSE(
+      SparkPacketTemplate::create(serialize(kVolatile, kVolatile), 1, 0)
+          .has_value());
+  EXPECT_FALSE(
+      SparkPacketTemplate::create(serialize(kVolatile, 1), 2, 0).has_value());
+
+  auto packetTemplate =
+      SparkPacketTemplate::create(serialize(kVolatile, kVolatile), 2, 5);
+  ASSERT_TRUE(packetTemplate.has_value());
+  EXPECT_EQ(5, packetTemplate->getKey());
+
+  for (int64_t seqNum : {0L, 1L, 127L, 128L, 1L << 40}) {
+    for (int64_t sentTsInUs : {-1L, 0L, 1630000000000000L}) {
+      auto packet = packetTemplate->fill({seqNum, sentTsInUs});
+      EXPECT_EQ(serialize(seqNum, sentTsInUs), packet);
+
+      auto helloPacket =
+          readThriftObjStr<thrift::SparkHelloPacket>(packet, serializer);
+      EXPECT_EQ(seqNum, *helloPacket.helloMsg_ref()->seqNum_ref());
+      EXPECT_EQ(sentTsInUs, *helloPacket.helloMsg_ref()->sentTsInUs_ref());
+    }
+  }
+}
+
+//
+// Verify encoding and decoding of fast liveness echo packets.
+//
+TEST(FastLivenessTest, EchoPacketEncodeDecode) {
+  FastLiveness::EchoPacket echo;
+  echo.nodeName = "node-1";
+  echo.detectMultiplier = 3;
+  echo.txInterval = std::chrono::milliseconds(300);
+  echo.seqNum = 0xdeadbeef;
+
+  auto packet = FastLiveness::encodeEchoPacket(echo);
+  auto buf = reinterpret_cast<const uint8_t*>(packet.data());
+
+  auto decoded = FastLiveness::decodeEchoPacket(buf, packet.size());
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(echo.nodeName, decoded->nodeName);
+  EXPECT_EQ(echo.detectMultiplier, decoded->detectMultiplier);
+  EXPECT_EQ(echo.txInterval, decoded->txInterval);
+  EXPECT_EQ(echo.seqNum, decoded->seqNum);
+
+  // truncated or padded packets are rejected
+  EXPECT_FALSE(
+      FastLiveness::decodeEchoPacket(buf, packet.size() - 1).has_value());
+  EXPECT_FALSE(FastLiveness::decodeEchoPacket(buf, 4).has_value());
+  auto padded = packet + "x";
+  EXPECT_FALSE(FastLiveness::decodeEchoPacket(
+                   reinterpret_cast<const uint8_t*>(padded.data()),
+                   padded.size())
+                   .has_value());
+
+  // packets with bad magic are rejected
+  auto corrupted = packet;
+  corrupted[0] = 0;
+  EXPECT_FALSE(FastLiveness::decodeEchoPacket(
+                   reinterpret_cast<const uint8_t*>(corrupted.data()),
+                   corrupted.size())
+                   .has_value());
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
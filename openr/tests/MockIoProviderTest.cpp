@@ -1770,6 +1770,93 @@ TEST(MockIoProviderTestSetup, PartialMeshOfNodesTest) {
   mockIoProviderThread.join();
 }
 
+//
+// Batched send of 3 messages where the one in the middle fails, as it goes out
+// of an interface with no connectivity. Verify the failure is reported for
+// that message only, and the rest of the batch is still delivered.
+//
+// 3-node topology: 1 --> 2
+//                  3 (1-node island)
+//
+TEST(MockIoProviderTestSetup, BatchedSendWithFailedMessageTest) {
+  folly::IPAddressV6 ipAddr1V6("fe80::1");
+  folly::IPAddressV6 ipAddr3V6("fe80::3");
+
+  std::string ifName1("iface1");
+  std::string ifName2("iface2");
+  std::string ifName3("iface3");
+
+  int ifIndex1 = 1;
+  int ifIndex2 = 2;
+  int ifIndex3 = 3;
+
+  auto mockIoProvider = std::make_shared<MockIoProvider>();
+
+  // Start mock IoProvider thread
+  std::thread mockIoProviderThread([&]() {
+    LOG(INFO) << "Starting mockIoProvider thread.";
+    mockIoProvider->start();
+    LOG(INFO) << "mockIoProvider thread got stopped.";
+  });
+  mockIoProvider->waitUntilRunning();
+
+  mockIoProvider->addIfNameIfIndex(
+      {{ifName1, ifIndex1}, {ifName2, ifIndex2}, {ifName3, ifIndex3}});
+
+  ConnectedIfPairs connectedPairs = {
+      {ifName1, {{ifName2, 10}}},
+  };
+  mockIoProvider->setConnectedPairs(connectedPairs);
+
+  int fd1 = createSocketAndJoinGroup(
+      mockIoProvider, ifIndex1, folly::IPAddress(kDiscardMulticastAddr));
+
+  int fd2 = createSocketAndJoinGroup(
+      mockIoProvider, ifIndex2, folly::IPAddress(kDiscardMulticastAddr));
+
+  createSocketAndJoinGroup(
+      mockIoProvider, ifIndex3, folly::IPAddress(kDiscardMulticastAddr));
+
+  std::vector<IoProvider::SendMessageEntry> messages = {
+      {ifIndex1, ipAddr1V6, "batched message #1 from node1"},
+      {ifIndex3, ipAddr3V6, "batched message #2 from node3"},
+      {ifIndex1, ipAddr1V6, "batched message #3 from node1"},
+  };
+  auto errors = IoProvider::sendMessages(
+      fd1,
+      folly::SocketAddress(kDiscardMulticastAddr, kMockedUdpPort),
+      messages,
+      mockIoProvider.get());
+  ASSERT_EQ(3, errors.size());
+  EXPECT_EQ(0, errors.at(0));
+  EXPECT_NE(0, errors.at(1));
+  EXPECT_EQ(0, errors.at(2));
+
+  // messages #1 and #3 are received in order
+  std::vector<unsigned char> recvBuf(3 * kMinIpv6PktSize);
+  std::vector<std::string> recvdPackets;
+  while (recvdPackets.size() < 2) {
+    waitForDataToRead(fd2);
+    auto msgs = IoProvider::recvMessages(
+        fd2, recvBuf.data(), kMinIpv6PktSize, 3, mockIoProvider.get());
+    for (size_t i = 0; i < msgs.size(); ++i) {
+      ASSERT_TRUE(msgs.at(i).has_value());
+      EXPECT_EQ(ifIndex2, std::get<1>(*msgs.at(i)));
+      recvdPackets.emplace_back(
+          reinterpret_cast<const char*>(&recvBuf[i * kMinIpv6PktSize]),
+          std::get<0>(*msgs.at(i)));
+    }
+  }
+  EXPECT_EQ(
+      std::vector<std::string>(
+          {messages.at(0).packet, messages.at(2).packet}),
+      recvdPackets);
+
+  // Cleanup
+  mockIoProvider->stop();
+  mockIoProviderThread.join();
+}
+
 int
 main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
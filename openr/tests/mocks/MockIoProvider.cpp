@@ -58,16 +58,65 @@ MockIoProvider::fcntl(int sockFd, int /* cmd */, int /* arg */) {
 
 int
 MockIoProvider::bind(
-    int sockFd, const struct sockaddr* /* my_addr */, socklen_t /* addrlen */) {
+    int sockFd, const struct sockaddr* my_addr, socklen_t addrlen) {
   VLOG(4) << "MockIoProvider::bind called";
 
+  folly::SocketAddress sockAddr;
+  sockAddr.setFromSockaddr(my_addr, addrlen);
+
   std::lock_guard<std::mutex> lock(mutex_);
   CHECK(pipeFds_.count(sockFd));
+  fdToPort_[sockFd] = sockAddr.getPort();
   return 0;
 }
 
 ssize_t
 MockIoProvider::recvmsg(int sockFd, struct msghdr* msg, int /* flags */) {
+  numRecvCalls_.fetch_add(1, std::memory_order_relaxed);
+  return recvmsgImpl(sockFd, msg);
+}
+
+int
+MockIoProvider::recvmmsg(
+    int sockFd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int /* flags */,
+    struct timespec* /* timeout */) {
+  numRecvCalls_.fetch_add(1, std::memory_order_relaxed);
+
+  // NOTE: First message is delivered irrespective of its delivery time, the
+  // same way as `recvmsg`. Rest are delivered only if they're active.
+  unsigned int numRecvd{0};
+  for (; numRecvd < vlen; ++numRecvd) {
+    if (numRecvd > 0 and not hasActiveMessage(sockFd)) {
+      break;
+    }
+    auto bytesRead = recvmsgImpl(sockFd, &msgvec[numRecvd].msg_hdr);
+    if (bytesRead < 0) {
+      break;
+    }
+    msgvec[numRecvd].msg_len = bytesRead;
+  }
+
+  if (numRecvd == 0) {
+    errno = EAGAIN;
+    return -1;
+  }
+  return numRecvd;
+}
+
+bool
+MockIoProvider::hasActiveMessage(int sockFd) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = mailboxes_.find(sockFd);
+  return it != mailboxes_.end() and it->second.size() and
+      it->second.front().isActive();
+}
+
+ssize_t
+MockIoProvider::recvmsgImpl(int sockFd, struct msghdr* msg) {
   std::lock_guard<std::mutex> lock(mutex_);
 
   SCOPE_FAIL {
@@ -170,11 +219,34 @@ MockIoProvider::recvmsg(int sockFd, struct msghdr* msg, int /* flags */) {
       reinterpret_cast<const void*>(&curTime),
       sizeof(curTime));
 
+  numPacketsRecvd_.fetch_add(1, std::memory_order_relaxed);
   return packet.size();
 }
 
 ssize_t
 MockIoProvider::sendmsg(int sockFd, const struct msghdr* msg, int /* flags */) {
+  numSendCalls_.fetch_add(1, std::memory_order_relaxed);
+  return sendmsgImpl(sockFd, msg);
+}
+
+int
+MockIoProvider::sendmmsg(
+    int sockFd, struct mmsghdr* msgvec, unsigned int vlen, int /* flags */) {
+  numSendCalls_.fetch_add(1, std::memory_order_relaxed);
+
+  unsigned int numSent{0};
+  for (; numSent < vlen; ++numSent) {
+    auto bytesSent = sendmsgImpl(sockFd, &msgvec[numSent].msg_hdr);
+    if (bytesSent < 0) {
+      break;
+    }
+    msgvec[numSent].msg_len = bytesSent;
+  }
+  return numSent ? numSent : -1;
+}
+
+ssize_t
+MockIoProvider::sendmsgImpl(int sockFd, const struct msghdr* msg) {
   VLOG(4) << "MockIoProvider::sendmsg called";
 
   SCOPE_FAIL {
@@ -202,6 +274,15 @@ MockIoProvider::sendmsg(int sockFd, const struct msghdr* msg, int /* flags */) {
 
   CHECK(srcIfIndex != -1);
 
+  // deliver to sockets bound to destination port, if specified
+  uint16_t dstPort{0};
+  if (msg->msg_name and msg->msg_namelen) {
+    folly::SocketAddress dstAddr;
+    dstAddr.setFromSockaddr(
+        static_cast<const struct sockaddr*>(msg->msg_name), msg->msg_namelen);
+    dstPort = dstAddr.getPort();
+  }
+
   auto srcIfName = ifIndexToIfName_.at(srcIfIndex);
 
   VLOG(4) << "MockIoProvider::sendmsg sending message from iface " << srcIfName;
@@ -222,12 +303,15 @@ MockIoProvider::sendmsg(int sockFd, const struct msghdr* msg, int /* flags */) {
       continue;
     }
 
-    try {
-      otherFd = ifIndexToFd_.at(dstIfIndex);
-    } catch (std::out_of_range const& err) {
+    auto fdIt = ifIndexToFd_.find({dstIfIndex, dstPort});
+    if (fdIt == ifIndexToFd_.end()) {
+      fdIt = ifIndexToFd_.find({dstIfIndex, 0});
+    }
+    if (fdIt == ifIndexToFd_.end()) {
       LOG(ERROR) << "No sockets bound to " << dstIfName;
       continue;
     }
+    otherFd = fdIt->second;
 
     // ATTN: In UT env, we explicitly allow pkt to send to itself to
     //       mimick case that pkt looped back to its own intf.
@@ -253,6 +337,7 @@ MockIoProvider::sendmsg(int sockFd, const struct msghdr* msg, int /* flags */) {
 
   // return the length of single vector sent
   if (sent) {
+    numPacketsSent_.fetch_add(1, std::memory_order_relaxed);
     return msg->msg_iov->iov_len;
   }
   return -1;
@@ -284,7 +369,9 @@ MockIoProvider::setsockopt(
       errno = ERANGE;
       return -1;
     }
-    ifIndexToFd_[ifIndex] = sockFd;
+    auto portIt = fdToPort_.find(sockFd);
+    const uint16_t port = portIt != fdToPort_.end() ? portIt->second : 0;
+    ifIndexToFd_[{static_cast<int>(ifIndex), port}] = sockFd;
     fdToIfName_[sockFd] = ifName;
   }
 
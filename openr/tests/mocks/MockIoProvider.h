@@ -97,6 +97,21 @@ class MockIoProvider final : public IoProvider {
 
   ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags) override;
 
+  // Batched variants receive/send messages one by one, but count as single
+  // call. Messages other than the first one are received only if active.
+  int recvmmsg(
+      int sockfd,
+      struct mmsghdr* msgvec,
+      unsigned int vlen,
+      int flags,
+      struct timespec* timeout) override;
+
+  int sendmmsg(
+      int sockfd,
+      struct mmsghdr* msgvec,
+      unsigned int vlen,
+      int flags) override;
+
   int setsockopt(
       int sockfd,
       int level,
@@ -109,10 +124,47 @@ class MockIoProvider final : public IoProvider {
   //
   void addIfNameIfIndex(const IfNameAndifIndex& entries);
 
+  //
+  // Number of send/recv calls (batched or not) and packets sent/received
+  // across all sockets. Used to measure IO efficiency in tests/benchmarks.
+  //
+  uint64_t
+  getNumSendCalls() const {
+    return numSendCalls_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t
+  getNumRecvCalls() const {
+    return numRecvCalls_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t
+  getNumPacketsSent() const {
+    return numPacketsSent_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t
+  getNumPacketsRecvd() const {
+    return numPacketsRecvd_.load(std::memory_order_relaxed);
+  }
+
  private:
+  // Check if there is an active message pending in the mailbox of fd
+  bool hasActiveMessage(int sockFd);
+
+  ssize_t recvmsgImpl(int sockFd, struct msghdr* msg);
+
+  ssize_t sendmsgImpl(int sockFd, const struct msghdr* msg);
+
   // Boolean to keep track of running-state of MockIoProvider
   std::atomic<bool> isRunning_{false};
 
+  // IO call and packet counters
+  std::atomic<uint64_t> numSendCalls_{0};
+  std::atomic<uint64_t> numRecvCalls_{0};
+  std::atomic<uint64_t> numPacketsSent_{0};
+  std::atomic<uint64_t> numPacketsRecvd_{0};
+
   // used to make this class a monitor
   std::mutex mutex_{};
 
@@ -130,9 +182,14 @@ class MockIoProvider final : public IoProvider {
 
   std::map<std::string /* ifName */, int /* ifIndex */> ifNameToIfIndex_{};
 
+  // the UDP port fd is bound to. Unbound fds receive packets to any port
+  std::map<int /* fd */, uint16_t /* port */> fdToPort_{};
+
   // maps the fds that have joined the interface: we can have same fd
-  // joining on multiple interfaces
-  std::map<int /* ifIndex */, int /* fd */> ifIndexToFd_{};
+  // joining on multiple interfaces, and fds bound to different ports joining
+  // the same interface
+  std::map<std::pair<int /* ifIndex */, uint16_t /* port */>, int /* fd */>
+      ifIndexToFd_{};
 
   struct IoMessage {
     IoMessage(
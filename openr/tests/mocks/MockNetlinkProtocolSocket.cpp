@@ -146,7 +146,7 @@ MockNetlinkProtocolSocket::addIfAddress(const fbnl::IfAddress& addr) {
   it->second.emplace_back(addr); // Add
 
   // Publish update via queue
-  netlinkEventsQueue_.push(addr);
+  publishEvent(addr);
   return folly::SemiFuture<int>(0);
 }
 
@@ -164,7 +164,7 @@ MockNetlinkProtocolSocket::deleteIfAddress(const fbnl::IfAddress& addr) {
       it->second.erase(addrIt);
 
       // Publish update via queue
-      netlinkEventsQueue_.push(addr);
+      publishEvent(addr);
       return folly::SemiFuture<int>(0);
     }
   }
@@ -182,6 +182,21 @@ MockNetlinkProtocolSocket::getAllIfAddresses() {
   return addrs;
 }
 
+void
+MockNetlinkProtocolSocket::setEventsDropped(bool dropped) {
+  if (eventsDropped_ and not dropped) {
+    netlinkEventsQueue_.push(EventsDropped{++numEventsDropped_});
+  }
+  eventsDropped_ = dropped;
+}
+
+void
+MockNetlinkProtocolSocket::publishEvent(NetlinkEvent&& event) {
+  if (not eventsDropped_) {
+    netlinkEventsQueue_.push(std::move(event));
+  }
+}
+
 folly::SemiFuture<int>
 MockNetlinkProtocolSocket::addLink(const fbnl::Link& link) {
   // Add or update link
@@ -191,7 +206,7 @@ MockNetlinkProtocolSocket::addLink(const fbnl::Link& link) {
   ifAddrs_.emplace(link.getIfIndex(), std::list<fbnl::IfAddress>());
 
   // Publish update via queue
-  netlinkEventsQueue_.push(link);
+  publishEvent(link);
 
   return folly::SemiFuture<int>(0);
 }
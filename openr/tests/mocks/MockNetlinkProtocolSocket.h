@@ -84,6 +84,13 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
     netlinkEventsQueue_.close();
   }
 
+  /*
+   * API to emulate loss of netlink events. While set, state updates are not
+   * published. On unset, `EventsDropped` is published the same way as kernel
+   * reports ENOBUFS on socket receive buffer overflow.
+   */
+  void setEventsDropped(bool dropped);
+
  protected:
   void
   init() override {
@@ -105,8 +112,15 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
       unicastRoutes_;
   std::unordered_map<uint8_t, std::map<uint32_t, fbnl::Route>> mplsRoutes_;
 
+  // Publish update via queue unless events are being dropped
+  void publishEvent(NetlinkEvent&& event);
+
   // queue to publish LINK/ADDR updates
   messaging::ReplicateQueue<NetlinkEvent> netlinkEventsQueue_;
+
+  // Emulate loss of events
+  bool eventsDropped_{false};
+  uint64_t numEventsDropped_{0};
 };
 
 } // namespace openr::fbnl